@@ -68,7 +68,9 @@ date         init     comment
 #include "ncx_str.h"
 #include "ncxconst.h"
 #include "ncxmod.h"
+#include "ses_msg.h"
 #include "status.h"
+#include "val.h"
 
 
 /********************************************************************
@@ -166,6 +168,14 @@ static void
     agt_profile.agt_accesscontrol_enum = AGT_ACMOD_ENFORCING;
     agt_profile.agt_system_sorted = AGT_DEF_SYSTEM_SORTED;
     agt_profile.agt_max_sessions = 1024;
+    agt_profile.agt_lazy_groupings = FALSE;
+    agt_profile.agt_getcb_deadline = 2000;
+    agt_profile.agt_commit_deadline = 30000;
+    agt_profile.agt_pipeline_edits = FALSE;
+    agt_profile.agt_buffsize = SES_MSG_BUFFSIZE;
+    agt_profile.agt_max_buffsize = SES_MSG_MAX_BUFFSIZE;
+    agt_profile.agt_max_buffsend = SES_MAX_BUFFSEND;
+    agt_profile.agt_max_bytesend = SES_MAX_BYTESEND;
 
 } /* init_server_profile */
 
@@ -663,6 +673,15 @@ status_t
     /* set the 'top-level mandatory objects allowed' flag */
     ncx_set_top_mandatory_allowed(!agt_profile.agt_running_error);
 
+    /* set the 'expand groupings on first use' flag */
+    ncx_set_lazy_groupings(agt_profile.agt_lazy_groupings);
+
+    /* set the session buffer sizes and send limits */
+    ses_msg_set_buff_limits(agt_profile.agt_buffsize,
+                            agt_profile.agt_max_buffsize,
+                            agt_profile.agt_max_buffsend,
+                            agt_profile.agt_max_bytesend);
+
     /*** All Server profile parameters should be set by now ***/
 
     /* must set the server capabilities after the profile is set */
@@ -845,6 +864,7 @@ status_t
     }
 
     /*** ALL INITIAL YANG MODULES SHOULD BE LOADED AT THIS POINT ***/
+
     if (res != NO_ERR) {
         log_error("\nError: one or more modules could not be loaded");
         return ERR_NCX_OPERATION_FAILED;
@@ -1139,10 +1159,17 @@ void
     agt_cleanup (void)
 {
     agt_dynlib_cb_t *dynlib;
+    uint32           vhits, vmisses;
 
     if (agt_init_done) {
         log_debug3("\nServer Cleanup Starting...\n");
 
+        if (LOGDEBUG) {
+            val_get_virtual_cache_stats(&vhits, &vmisses);
+            log_debug("\nagt: virtual value cache %u hits, %u misses",
+                      vhits, vmisses);
+        }
+
         /* cleanup all the dynamically loaded modules */
         while (!dlq_empty(&agt_dynlibQ)) {
             dynlib = (agt_dynlib_cb_t *)dlq_deque(&agt_dynlibQ);
@@ -243,7 +243,7 @@ typedef struct agt_profile_t_ {
     boolean             agt_logappend;
     boolean             agt_xmlorder;
     boolean             agt_deleteall_ok;   /* TBD: not implemented */
-    boolean             agt_stream_output;   /* d:true; no CLI support yet */
+    boolean             agt_stream_output;   /* --stream-output */
     boolean             agt_delete_empty_npcontainers;     /* d: false */
     boolean             agt_notif_sequence_id;    /* d: false */
     const xmlChar      *agt_accesscontrol;
@@ -270,6 +270,14 @@ typedef struct agt_profile_t_ {
     const xmlChar      *agt_tcp_direct_address;
     int32               agt_tcp_direct_port;
     const xmlChar      *agt_ncxserver_sockname;
+    boolean             agt_lazy_groupings;        /* --lazy-groupings */
+    uint32              agt_getcb_deadline;                  /* msec */
+    uint32              agt_commit_deadline;                 /* msec */
+    boolean             agt_pipeline_edits;        /* --pipeline-edits */
+    uint32              agt_buffsize;          /* --session-buffer-size */
+    uint32              agt_max_buffsize;  /* --max-session-buffer-size */
+    uint32              agt_max_buffsend;         /* --max-send-buffers */
+    uint32              agt_max_bytesend;           /* --max-send-bytes */
 
     /****** state variables; TBD: move out of profile ******/
 
@@ -42,6 +42,7 @@ date         init     comment
 #include "agt_ses.h"
 #include "agt_util.h"
 #include "agt_val.h"
+#include "bobhash.h"
 #include "def_reg.h"
 #include "dlq.h"
 #include "ncx.h"
@@ -109,6 +110,10 @@ date         init     comment
 #define nacm_E_allowedRights_delete  (const xmlChar *)"delete"
 #define nacm_E_allowedRights_exec  (const xmlChar *)"exec"
 
+/* rows in the user-to-groups hash table */
+#define ACM_USER_HASH_SIZE   (hashsize(8))
+#define ACM_USER_HASH_MASK   (hashmask(8))
+
 
 /********************************************************************
 *                                                                    *
@@ -141,6 +146,15 @@ static boolean log_reads;
 
 static boolean log_writes;
 
+/* user-to-groups map built from /nacm/groups, shared by all
+ * sessions; cleared when the /nacm subtree changes
+ */
+static dlq_hdr_t      usergroupsQ[ACM_USER_HASH_SIZE];
+
+static val_value_t   *usergroups_nacmroot;
+
+static boolean        usergroups_valid;
+
 /********************************************************************
 * FUNCTION is_superuser
 *
@@ -328,6 +342,200 @@ static void
 }  /* free_datarule */
 
 
+/********************************************************************
+* FUNCTION get_decision_row
+*
+* get the read decision hash table row for an object template
+*
+* INPUTS:
+*   cache == agt_acm cache to use
+*   obj == object template to hash
+*
+* RETURNS:
+*   pointer to the Q of agt_acm_decision_t for this object
+*********************************************************************/
+static dlq_hdr_t *
+    get_decision_row (agt_acm_cache_t *cache,
+                      const obj_template_t *obj)
+{
+    uint32  hash;
+
+    hash = (uint32)bobhash((const ub1 *)&obj, (ub4)sizeof(obj), 0);
+    return &cache->decisionQ[hash & ACM_DECISION_HASH_MASK];
+
+}  /* get_decision_row */
+
+
+/********************************************************************
+* FUNCTION find_decision
+*
+* find the cached read decision for an object template
+*
+* INPUTS:
+*   cache == agt_acm cache to use
+*   obj == object template to find
+*
+* RETURNS:
+*   pointer to found record or NULL if not found
+*********************************************************************/
+static agt_acm_decision_t *
+    find_decision (agt_acm_cache_t *cache,
+                   const obj_template_t *obj)
+{
+    agt_acm_decision_t  *decision;
+    dlq_hdr_t           *row;
+
+    if (cache->decisioncnt == 0) {
+        return NULL;
+    }
+
+    row = get_decision_row(cache, obj);
+    for (decision = (agt_acm_decision_t *)dlq_firstEntry(row);
+         decision != NULL;
+         decision = (agt_acm_decision_t *)dlq_nextEntry(decision)) {
+        if (decision->obj == obj) {
+            return decision;
+        }
+    }
+    return NULL;
+
+}  /* find_decision */
+
+
+/********************************************************************
+* FUNCTION add_decision
+*
+* cache the read decision for an object template
+* a malloc failure is ignored; the decision is just not cached
+*
+* INPUTS:
+*   cache == agt_acm cache to use
+*   obj == object template that was checked
+*   granted == TRUE if read access was granted
+*   subtree == TRUE if read access was granted for all descendants
+*   reason == const string for logging the decision
+*********************************************************************/
+static void
+    add_decision (agt_acm_cache_t *cache,
+                  const obj_template_t *obj,
+                  boolean granted,
+                  boolean subtree,
+                  const xmlChar *reason)
+{
+    agt_acm_decision_t  *decision;
+
+    decision = m__getObj(agt_acm_decision_t);
+    if (!decision) {
+        return;
+    }
+    memset(decision, 0x0, sizeof(agt_acm_decision_t));
+    decision->obj = obj;
+    decision->granted = granted;
+    decision->subtree = subtree;
+    decision->reason = reason;
+
+    dlq_enque(decision, get_decision_row(cache, obj));
+    cache->decisioncnt++;
+
+}  /* add_decision */
+
+
+/********************************************************************
+* FUNCTION clean_decisions
+*
+* free all the cached read decisions
+*
+* INPUTS:
+*   cache == agt_acm cache to clean
+*********************************************************************/
+static void
+    clean_decisions (agt_acm_cache_t *cache)
+{
+    agt_acm_decision_t  *decision;
+    uint32               i;
+
+    for (i = 0; i < ACM_DECISION_HASH_SIZE && cache->decisioncnt; i++) {
+        while (!dlq_empty(&cache->decisionQ[i])) {
+            decision = (agt_acm_decision_t *)
+                dlq_deque(&cache->decisionQ[i]);
+            m__free(decision);
+            cache->decisioncnt--;
+        }
+    }
+
+}  /* clean_decisions */
+
+
+/********************************************************************
+* FUNCTION decision_cacheable
+*
+* Check if the read decision for a value node can be cached
+* for its object template.  The data rule checks only compare
+* node names, so the decision is the same for every instance
+* of a schema node.  Nodes with generic templates, such as
+* anyxml content, must be checked each time
+*
+* INPUTS:
+*   val == value node to check
+*
+* RETURNS:
+*   TRUE if the decision can be cached by val->obj
+*********************************************************************/
+static boolean
+    decision_cacheable (const val_value_t *val)
+{
+    if (val->obj == NULL) {
+        return FALSE;
+    }
+    if (val_get_nsid(val) != obj_get_nsid(val->obj)) {
+        return FALSE;
+    }
+    return (xml_strcmp(val->name, obj_get_name(val->obj))) ? FALSE : TRUE;
+
+}  /* decision_cacheable */
+
+
+/********************************************************************
+* FUNCTION subtree_very_secure
+*
+* Check if any descendant of an object template is tagged
+* as ncx:very-secure.  Such nodes can be denied by the default
+* response even if their ancestors are readable
+*
+* INPUTS:
+*   obj == object template to check
+*
+* RETURNS:
+*   TRUE if any descendant is ncx:very-secure
+*********************************************************************/
+static boolean
+    subtree_very_secure (const obj_template_t *obj)
+{
+    const dlq_hdr_t       *datadefQ;
+    const obj_template_t  *chobj;
+
+    datadefQ = obj_get_cdatadefQ(obj);
+    if (datadefQ == NULL) {
+        return FALSE;
+    }
+
+    for (chobj = (const obj_template_t *)dlq_firstEntry(datadefQ);
+         chobj != NULL;
+         chobj = (const obj_template_t *)dlq_nextEntry(chobj)) {
+        if (chobj->objtype == OBJ_TYP_USES ||
+            chobj->objtype == OBJ_TYP_AUGMENT ||
+            chobj->objtype == OBJ_TYP_REFINE) {
+            continue;
+        }
+        if (obj_is_very_secure(chobj) || subtree_very_secure(chobj)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+
+}  /* subtree_very_secure */
+
+
 /********************************************************************
 * FUNCTION new_group_ptr
 *
@@ -501,85 +709,224 @@ static void
 
 
 /********************************************************************
-* FUNCTION get_usergroups_entry
+* FUNCTION get_user_row
 *
-* create (TBD: cache) a user-to-groups entry
-* for the specified username, based on the /nacm/groups
-* contents at this time
+* get the user-to-groups hash table row for a user name
 *
 * INPUTS:
-*   nacmroot == root of the nacm tree, already fetched
-*   username == user name to create mapping for
-*   groupcount == address of return group count field
+*   username == user name to hash
 *
-* OUTPUTS:
-*   *groupcount == number of groups that the specified
-*                  user is part of (i.e., number of 
-*                  agt_acm_group_t structs in the groups Q
+* RETURNS:
+*   pointer to the Q of agt_acm_usergroups_t for this user
+*********************************************************************/
+static dlq_hdr_t *
+    get_user_row (const xmlChar *username)
+{
+    uint32  hash;
+
+    hash = (uint32)bobhash((const ub1 *)username,
+                           (ub4)xml_strlen(username), 0);
+    return &usergroupsQ[hash & ACM_USER_HASH_MASK];
+
+}  /* get_user_row */
+
+
+/********************************************************************
+* FUNCTION find_user_map_entry
+*
+* find the user-to-groups map entry for a user name
+*
+* INPUTS:
+*   username == user name to find
 *
 * RETURNS:
-*  malloced usergroups entry for the specified user
+*   pointer to found record or NULL if the user is not
+*   a member of any group
 *********************************************************************/
 static agt_acm_usergroups_t *
-    get_usergroups_entry (val_value_t *nacmroot,
-                          const xmlChar *username,
-                          uint32 *groupcount)
+    find_user_map_entry (const xmlChar *username)
 {
     agt_acm_usergroups_t  *usergroups;
-    val_value_t           *groupsval, *groupval, *group_name_val, *userval;
-    boolean                done;
-    status_t               res;
+    dlq_hdr_t             *row;
+
+    row = get_user_row(username);
+    for (usergroups = (agt_acm_usergroups_t *)dlq_firstEntry(row);
+         usergroups != NULL;
+         usergroups = (agt_acm_usergroups_t *)dlq_nextEntry(usergroups)) {
+        if (!xml_strcmp(usergroups->username, username)) {
+            return usergroups;
+        }
+    }
+    return NULL;
 
-    *groupcount = 0;
-    res = NO_ERR;
+}  /* find_user_map_entry */
 
-    /*** no cache yet -- just create entry each time for now ***/
 
-    usergroups = new_usergroups(username);
-    if (!usergroups) {
-        return NULL;
+/********************************************************************
+* FUNCTION clean_user_map
+*
+* free all the entries in the user-to-groups map
+*
+*********************************************************************/
+static void
+    clean_user_map (void)
+{
+    agt_acm_usergroups_t  *usergroups;
+    uint32                 i;
+
+    for (i = 0; i < ACM_USER_HASH_SIZE; i++) {
+        while (!dlq_empty(&usergroupsQ[i])) {
+            usergroups = (agt_acm_usergroups_t *)
+                dlq_deque(&usergroupsQ[i]);
+            free_usergroups(usergroups);
+        }
     }
+    usergroups_nacmroot = NULL;
+    usergroups_valid = FALSE;
+
+}  /* clean_user_map */
+
+
+/********************************************************************
+* FUNCTION build_user_map
+*
+* build the user-to-groups map from the /nacm/groups contents
+* with one pass through the groups list
+*
+* INPUTS:
+*   nacmroot == root of the nacm tree, already fetched
+*
+* RETURNS:
+*   status; the map is left empty and invalid on error
+*********************************************************************/
+static status_t
+    build_user_map (val_value_t *nacmroot)
+{
+    agt_acm_usergroups_t  *usergroups;
+    val_value_t           *groupsval, *groupval, *group_name_val, *userval;
+    uint32                 usercnt;
+    status_t               res;
+
+    clean_user_map();
+    res = NO_ERR;
+    usercnt = 0;
 
     /* get /nacm/groups node */
     groupsval = val_find_child(nacmroot,
                                AGT_ACM_MODULE,
                                nacm_N_groups);
-    if (!groupsval) {
-        return usergroups;
-    }
 
     /* check each /nacm/groups/group node */
-    for (groupval = val_get_first_child(groupsval);
+    for (groupval = (groupsval) ? val_get_first_child(groupsval) : NULL;
          groupval != NULL && res == NO_ERR;
          groupval = val_get_next_child(groupval)) {
 
-        done = FALSE;
         group_name_val = val_find_child(groupval,
-                                     AGT_ACM_MODULE,
-                                     nacm_N_name);
+                                        AGT_ACM_MODULE,
+                                        nacm_N_name);
         assert(group_name_val!=NULL);
-        /* check each /nacm/groups/group/user-name node */
+
+        /* add this group to each /nacm/groups/group/user-name entry */
         for (userval = val_find_child(groupval,
                                       AGT_ACM_MODULE,
                                       nacm_N_userName);
-             userval != NULL && !done;
+             userval != NULL && res == NO_ERR;
              userval = val_find_next_child(groupval,
                                            AGT_ACM_MODULE,
                                            nacm_N_userName,
                                            userval)) {
 
-            if (!xml_strcmp(username, VAL_STR(userval))) {
-                /* user is a member of this group
-                 * get the groupIdentity key leaf
-                 */
-                done = TRUE;
-                res = add_group_ptr(usergroups,
-                                    VAL_STRING(group_name_val));
-                (*groupcount)++;
+            usergroups = find_user_map_entry(VAL_STR(userval));
+            if (!usergroups) {
+                usergroups = new_usergroups(VAL_STR(userval));
+                if (!usergroups) {
+                    res = ERR_INTERNAL_MEM;
+                    continue;
+                }
+                dlq_enque(usergroups, get_user_row(VAL_STR(userval)));
+                usercnt++;
             }
+            res = add_group_ptr(usergroups, VAL_STRING(group_name_val));
+        }
+    }
+
+    if (res != NO_ERR) {
+        clean_user_map();
+        return res;
+    }
+
+    usergroups_nacmroot = nacmroot;
+    usergroups_valid = TRUE;
+
+    if (LOGDEBUG2) {
+        log_debug2("\nagt_acm: built user-to-groups map for %u users",
+                   usercnt);
+    }
+    return NO_ERR;
+
+}  /* build_user_map */
+
+
+/********************************************************************
+* FUNCTION get_usergroups_entry
+*
+* create a user-to-groups entry for the specified username,
+* based on the /nacm/groups contents at this time
+*
+* The group membership is copied from the user-to-groups map,
+* which is built the first time it is needed after the /nacm
+* subtree changes
+*
+* INPUTS:
+*   nacmroot == root of the nacm tree, already fetched
+*   username == user name to create mapping for
+*   groupcount == address of return group count field
+*
+* OUTPUTS:
+*   *groupcount == number of groups that the specified
+*                  user is part of (i.e., number of 
+*                  agt_acm_group_t structs in the groups Q
+*
+* RETURNS:
+*  malloced usergroups entry for the specified user
+*********************************************************************/
+static agt_acm_usergroups_t *
+    get_usergroups_entry (val_value_t *nacmroot,
+                          const xmlChar *username,
+                          uint32 *groupcount)
+{
+    agt_acm_usergroups_t  *usergroups, *mapentry;
+    agt_acm_group_t       *grptr;
+    status_t               res;
+
+    *groupcount = 0;
+    res = NO_ERR;
+
+    if (!usergroups_valid || usergroups_nacmroot != nacmroot) {
+        res = build_user_map(nacmroot);
+        if (res != NO_ERR) {
+            log_error("\nError: agt_acm build user2group map failed");
+            return NULL;
         }
     }
 
+    usergroups = new_usergroups(username);
+    if (!usergroups) {
+        return NULL;
+    }
+
+    mapentry = find_user_map_entry(username);
+    if (!mapentry) {
+        return usergroups;
+    }
+
+    for (grptr = (agt_acm_group_t *)dlq_firstEntry(&mapentry->groupQ);
+         grptr != NULL && res == NO_ERR;
+         grptr = (agt_acm_group_t *)dlq_nextEntry(grptr)) {
+        res = add_group_ptr(usergroups, grptr->groupname);
+        (*groupcount)++;
+    }
+
     if (res != NO_ERR) {
         log_error("\nError: agt_acm add user2group entry failed");
     }
@@ -611,6 +958,9 @@ static agt_acm_cache_t  *
     for(i=0;i<DATA_RULE_QUEUE_NUM;i++) {
         dlq_createSQue(&acm_cache->dataruleQ[i]);
     }
+    for (i = 0; i < ACM_DECISION_HASH_SIZE; i++) {
+        dlq_createSQue(&acm_cache->decisionQ[i]);
+    }
     acm_cache->mode = acmode;
     acm_cache->flags = FL_ACM_CACHE_VALID;
     return acm_cache;
@@ -647,6 +997,8 @@ static void
         }
     }
 
+    clean_decisions(acm_cache);
+
     if (acm_cache->usergroups) {
         free_usergroups(acm_cache->usergroups);
     }
@@ -1416,11 +1768,14 @@ for ( rule_list = val_find_child( nacmroot, AGT_ACM_MODULE,
 *              (read, write)
 *    usergroups == user-to-group mapping for access processing
 *    done == address of return done processing flag
+*    subtree == address of return subtree match flag
 *
 * OUTPUTS:
 *    *done == TRUE if a rule was found, so return value is
 *             the final answer
 *          == FALSE if no dataRule was found to match
+*    *subtree == TRUE if the rule matched the node or one of
+*                its ancestors, so it matches all descendants too
 *
 * RETURNS:
 *    only valid if *done == TRUE:
@@ -1433,7 +1788,8 @@ static boolean
                       const val_value_t *val,
                       const xmlChar *access,
                       agt_acm_usergroups_t *usergroups,
-                      boolean *done)
+                      boolean *done,
+                      boolean *subtree)
 {
     dlq_hdr_t           *resnodeQ;
     agt_acm_datarule_t  *datarule_cache;
@@ -1441,6 +1797,7 @@ static boolean
     status_t             res = NO_ERR;
     int                  access_id;
     *done = FALSE;
+    *subtree = FALSE;
 
     /* fill the dataruleQ in the cache if needed */
 #if 0
@@ -1475,10 +1832,15 @@ static boolean
             resnodeQ = xpath_get_resnodeQ(datarule_cache->result);
             assert(resnodeQ);
 
-            if ( ((access_id==DATA_RULE_QUEUE_READ) && xpath1_check_node_child_exists_slow( datarule_cache->pcb,resnodeQ, val )) ||
-                 ((access_id==DATA_RULE_QUEUE_UPDATE) && !obj_is_leaf(val->obj)) ||
-                 xpath1_check_node_exists_slow( datarule_cache->pcb,
+            if ( xpath1_check_node_exists_slow( datarule_cache->pcb,
                                                 resnodeQ, val ))
+            {
+                /* the node or an ancestor is selected */
+                *done = TRUE;
+                granted = TRUE;
+                *subtree = TRUE;
+            } else if ( ((access_id==DATA_RULE_QUEUE_READ) && xpath1_check_node_child_exists_slow( datarule_cache->pcb,resnodeQ, val )) ||
+                        ((access_id==DATA_RULE_QUEUE_UPDATE) && !obj_is_leaf(val->obj)) )
             {
                 *done = TRUE;
                 granted = TRUE;
@@ -1510,6 +1872,12 @@ cess and the user's configured max-access
 *   newval  == newval val_value_t in progress to check (write only)
 *   curval  == curval val_value_t in progress to check (write only)
 *   editop == edit operation if this is a write; ignored otherwise
+*   subtree == address of return subtree flag (may be NULL)
+*
+* OUTPUTS:
+*   if non-NULL:
+*     *subtree == TRUE if read access is granted for the value node
+*                 and every descendant, so they need no checks
 * RETURNS:
 *   TRUE if user allowed this level of access to the value node
 *********************************************************************/
@@ -1519,13 +1887,19 @@ static boolean
                             const val_value_t *val,
                             const val_value_t *newval,
                             const val_value_t *curval,
-                            op_editop_t editop)
+                            op_editop_t editop,
+                            boolean *subtree)
 {
     char* access;
     val_value_t *nacmroot = NULL;
     boolean      iswrite;
+    boolean      allsubtree = FALSE;
     logfn_t      logfn;
 
+    if (subtree) {
+        *subtree = FALSE;
+    }
+
     /* check if this is a read or a write */
     if ((newval!=NULL) || (curval!=NULL)) {
         iswrite = TRUE;
@@ -1544,6 +1918,9 @@ static boolean
     /* super user is allowed to access anything except user-write blocked */
     if (is_superuser(user)) {
         (*logfn)("\nagt_acm: PERMIT (superuser)");
+        if (subtree) {
+            *subtree = TRUE;
+        }
         return TRUE;
     }
 
@@ -1585,15 +1962,38 @@ static boolean
 
     if (cache->mode == AGT_ACMOD_DISABLED) {
         (*logfn)("\nagt_acm: PERMIT (NACM disabled)");
+        if (subtree) {
+            *subtree = TRUE;
+        }
         return TRUE;
     }
 
     /* check if access granted without any rules */
     if (check_mode(access, val->obj)) {
         (*logfn)("\nagt_acm: PERMIT (permissive mode)");
+        if (subtree && !iswrite) {
+            *subtree = !subtree_very_secure(val->obj);
+        }
         return TRUE;
     }
 
+    /* a read decision already made for this object template
+     * during this message applies to every instance of it
+     */
+    boolean cacheable = (!iswrite && decision_cacheable(val)) ? TRUE : FALSE;
+    if (cacheable) {
+        agt_acm_decision_t *decision = find_decision(cache, val->obj);
+        if (decision) {
+            (*logfn)("\nagt_acm: %s read (%s, cached)",
+                     decision->granted ? "PERMIT" : "DENY",
+                     decision->reason);
+            if (subtree) {
+                *subtree = decision->subtree;
+            }
+            return decision->granted;
+        }
+    }
+
 
     /* get the NACM root to decide any more */
     if (cache->nacmroot) {
@@ -1640,7 +2040,7 @@ static boolean
         /* there is a rules node so check the dataRule list */
         if (!done) {
             retval = check_data_rules(cache, nacmroot, val, access,
-                                      usergroups, &done);
+                                      usergroups, &done, &allsubtree);
             if (done) {
                 substr = (const xmlChar *)"data-rule";
             } else {
@@ -1659,6 +2059,17 @@ static boolean
         }
     }
 
+    /* a descendant not matched by a data rule gets the default
+     * response, which is the same unless it is ncx:very-secure
+     */
+    if (retval && !iswrite && !allsubtree &&
+        (groupcnt == 0 || !done)) {
+        allsubtree = !subtree_very_secure(val->obj);
+    }
+    if (subtree) {
+        *subtree = (retval && !iswrite) ? allsubtree : FALSE;
+    }
+
     if (iswrite) {
         (*logfn)("\nagt_acm: %s write (%s)", retval ? "PERMIT" : "DENY",
                  substr ? substr : NCX_EL_NONE);
@@ -1667,6 +2078,11 @@ static boolean
                  substr ? substr : NCX_EL_NONE);
     }
 
+    if (cacheable) {
+        add_decision(cache, val->obj, retval,
+                     (retval) ? allsubtree : FALSE, substr);
+    }
+
     return retval;
 
 }   /* valnode_access_allowed */
@@ -2085,6 +2501,7 @@ status_t
 {
     status_t  res;
     agt_profile_t  *agt_profile;
+    uint32    i;
 
     if (agt_acm_init_done) {
         return SET_ERROR(ERR_INTERNAL_INIT_SEQ);
@@ -2096,6 +2513,11 @@ status_t
 
     nacmmod = NULL;
     notif_cache = NULL;
+    for (i = 0; i < ACM_USER_HASH_SIZE; i++) {
+        dlq_createSQue(&usergroupsQ[i]);
+    }
+    usergroups_nacmroot = NULL;
+    usergroups_valid = FALSE;
 
     /* load in the access control parameters */
     res = ncxmod_load_module(AGT_ACM_MODULE, NULL, &agt_profile->agt_savedevQ,
@@ -2234,6 +2656,7 @@ void
     if (notif_cache != NULL) {
         free_acm_cache(notif_cache);
     }
+    clean_user_map();
     agt_acm_init_done = FALSE;
 
 }   /* agt_acm_cleanup */
@@ -2562,7 +2985,8 @@ boolean
         return TRUE;
     }
 
-    retval = valnode_access_allowed(msg->acm_cache, user, val, newval, curval, editop);
+    retval = valnode_access_allowed(msg->acm_cache, user, val, newval, curval, editop,
+                                    NULL);
 
     if (!retval) {
         denied_data_writes_count++;
@@ -2583,6 +3007,10 @@ boolean
 *   user == user name string
 *   val  == val_value_t in progress to check
 *
+* OUTPUTS:
+*   msg->acm_subtree == TRUE if all descendants of val are
+*                       readable as well and need not be checked
+*
 * RETURNS:
 *   TRUE if user allowed read access to the value node
 *********************************************************************/
@@ -2601,7 +3029,8 @@ boolean
                    val->name, user);
     }
 
-    return valnode_access_allowed(msg->acm_cache, user, val, NULL, NULL,  OP_EDITOP_NONE);
+    return valnode_access_allowed(msg->acm_cache, user, val, NULL, NULL,
+                                  OP_EDITOP_NONE, &msg->acm_subtree);
 
 }   /* agt_acm_val_read_allowed */
 
@@ -2649,10 +3078,14 @@ status_t
 
     if (msg->acm_cache == NULL) {
         return ERR_INTERNAL_MEM;
-    } else {
-        return NO_ERR;
     }
 
+    /* the data rules are evaluated against the current data,
+     * so read decisions are not kept from the last message
+     */
+    clean_decisions(msg->acm_cache);
+    return NO_ERR;
+
 } /* agt_acm_init_msg_cache */
 
 
@@ -2721,6 +3154,22 @@ void agt_acm_invalidate_session_cache (ses_cb_t *scb)
 } /* agt_acm_invalidate_session_cache */
 
 
+/********************************************************************
+* FUNCTION agt_acm_invalidate_usergroups_cache
+*
+* Clear the global user-to-groups map so it will be rebuilt
+* from /nacm/groups the next time a session needs it
+*
+*********************************************************************/
+void agt_acm_invalidate_usergroups_cache (void)
+{
+    if (agt_acm_init_done) {
+        clean_user_map();
+    }
+
+} /* agt_acm_invalidate_usergroups_cache */
+
+
 /********************************************************************
 * FUNCTION agt_acm_session_cache_valid
 *
@@ -126,6 +126,17 @@ typedef struct agt_acm_datarule_t_ {
     val_value_t        *datarule;   /* back-ptr */
 } agt_acm_datarule_t;
 
+/* cached read decision for 1 object template;
+ * only valid for the message that created it
+ */
+typedef struct agt_acm_decision_t_ {
+    dlq_hdr_t              qhdr;
+    const obj_template_t  *obj;       /* back-ptr */
+    boolean                granted;
+    boolean                subtree;   /* granted for all descendants */
+    const xmlChar         *reason;    /* const string for logging */
+} agt_acm_decision_t;
+
 /* NACM cache control block */
 #define DATA_RULE_QUEUE_READ 0
 #define DATA_RULE_QUEUE_UPDATE 1
@@ -133,6 +144,10 @@ typedef struct agt_acm_datarule_t_ {
 #define DATA_RULE_QUEUE_DELETE 3
 #define DATA_RULE_QUEUE_NUM 4
 
+/* rows in the read decision hash table; must be a power of 2 */
+#define ACM_DECISION_HASH_SIZE 64
+#define ACM_DECISION_HASH_MASK (ACM_DECISION_HASH_SIZE - 1)
+
 typedef struct agt_acm_cache_t_ {
     agt_acm_usergroups_t *usergroups;
     val_value_t          *nacmroot;     /* back-ptr */
@@ -142,6 +157,9 @@ typedef struct agt_acm_cache_t_ {
     agt_acmode_t          mode;
     dlq_hdr_t             modruleQ;     /* Q of agt_acm_modrule_t */
     dlq_hdr_t             dataruleQ[4];    /* Q of agt_acm_datarule_t */
+    uint32                decisioncnt;
+    dlq_hdr_t             decisionQ[ACM_DECISION_HASH_SIZE];
+                                    /* Q of agt_acm_decision_t */
 } agt_acm_cache_t;
 
     
@@ -265,6 +283,10 @@ extern boolean
 *   user == user name string
 *   val  == val_value_t in progress to check
 *
+* OUTPUTS:
+*   msg->acm_subtree == TRUE if all descendants of val are
+*                       readable as well and need not be checked
+*
 * RETURNS:
 *   TRUE if user allowed read access to the value node
 *********************************************************************/
@@ -341,6 +363,16 @@ extern void agt_acm_clear_session_cache (ses_cb_t *scb);
 extern void agt_acm_invalidate_session_cache (ses_cb_t *scb);
 
 
+/********************************************************************
+* FUNCTION agt_acm_invalidate_usergroups_cache
+*
+* Clear the global user-to-groups map so it will be rebuilt
+* from /nacm/groups the next time a session needs it
+*
+*********************************************************************/
+extern void agt_acm_invalidate_usergroups_cache (void);
+
+
 /********************************************************************
 * FUNCTION agt_acm_session_cache_valid
 *
@@ -75,6 +75,9 @@ typedef struct agt_cb_set_t_ {
     const xmlChar     *defpath;
     const xmlChar     *version;
     agt_cb_fnset_t     cbset;
+    agt_cb_batch_fn_t  batchfn;
+    agt_cb_start_fn_t  startfn;
+    agt_cb_fnset_node_t *cbset_node;  /* entry in obj->cbsetQ if loaded */
     agt_cb_status_t    loadstatus;
     status_t           status;
 } agt_cb_set_t;
@@ -187,6 +190,9 @@ static void
 *   modhdr == agt_cb_modhdr_t struct to check
 *   defpath == definition path string to find
 *   cbfn == callback function pointer
+*   batchfn == batch callback function pointer
+*              if both are NULL the first callback record
+*              for defpath is returned
 *
 * RETURNS:
 *   pointer to found callback record or NULL if not found
@@ -194,7 +200,8 @@ static void
 static agt_cb_set_t *
     find_callback (agt_cb_modhdr_t *modhdr,
                    const xmlChar *defpath,
-                   const agt_cb_fn_t cbfn)
+                   const agt_cb_fn_t cbfn,
+                   const agt_cb_batch_fn_t batchfn)
 {
     agt_cb_set_t *callback;
     int           ret;
@@ -206,7 +213,11 @@ static agt_cb_set_t *
 
          ret = xml_strcmp(defpath, callback->defpath);
          if (ret == 0) {
-             if(cbfn==NULL || callback->cbset.cbfn[AGT_CB_VALIDATE]==cbfn) {
+             if (batchfn != NULL) {
+                 if (callback->batchfn == batchfn) {
+                     return callback;
+                 }
+             } else if(cbfn==NULL || callback->cbset.cbfn[AGT_CB_VALIDATE]==cbfn) {
                  return callback;
              }
          } else if (ret < 0) {
@@ -412,8 +423,13 @@ static status_t
             return ERR_INTERNAL_MEM;
         }
         cbset_node->fnset_ptr = &callback->cbset;
+        cbset_node->batchfn = callback->batchfn;
+        cbset_node->startfn = callback->startfn;
         dlq_enque(cbset_node, &obj->cbsetQ);
 
+        /* keep the entry so the path is not resolved again */
+        callback->cbset_node = cbset_node;
+
         callback->loadstatus = AGTCB_STAT_LOADED;
         callback->status = NO_ERR;
 
@@ -472,6 +488,65 @@ static void
 }   /* check_module_pending */
 
 
+/********************************************************************
+* FUNCTION unregister_callback
+*
+* Unregister the callback record for a specific object with
+* matching callback function pointers
+*
+* INPUTS:
+*   modname == module containing the object for this callback
+*   defpath == definition XPath location
+*   cbfn == callback function pointer to match
+*   batchfn == batch callback function pointer to match
+*
+*********************************************************************/
+static void
+    unregister_callback (const xmlChar *modname,
+                         const xmlChar *defpath,
+                         const agt_cb_fn_t cbfn,
+                         const agt_cb_batch_fn_t batchfn)
+{
+    agt_cb_modhdr_t  *modhdr;
+    agt_cb_set_t     *callback;
+
+#ifdef DEBUG
+    if (!modname || !defpath) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    modhdr = find_modhdr(modname);
+    if (!modhdr) {
+        /* entry not found; assume it is an early exit cleanup */
+        return;
+    }
+
+    callback = find_callback(modhdr, defpath, cbfn, batchfn);
+    if (!callback) {
+        SET_ERROR(ERR_INTERNAL_VAL);
+        return;
+    }
+
+    /* the callbacks are only in the object if they were loaded */
+    if (callback->cbset_node != NULL) {
+        dlq_remove(callback->cbset_node);
+        free(callback->cbset_node);
+        callback->cbset_node = NULL;
+    }
+
+    dlq_remove(callback);
+    free_callback(callback);
+
+    if (dlq_empty(&modhdr->callbackQ)) {
+        dlq_remove(modhdr);
+        free_modhdr(modhdr);
+    }
+
+}  /* unregister_callback */
+
+
 /**************    E X T E R N A L   F U N C T I O N S **********/
 
 
@@ -686,72 +761,237 @@ status_t
 
 
 /********************************************************************
-* FUNCTION agt_cb_unregister_callback
-*
-* Unregister all callback functions for a specific object with mathching
-* callback function pointers.
+* FUNCTION agt_cb_register_parallel_callback
+* 
+* Register an object specific callback function
+* with a commit start function.  Same as
+* agt_cb_register_callback, but the COMMIT callbacks
+* for the object can run at the same time as the ones
+* for other top-level subtrees
 *
 * INPUTS:
-*   modname == module containing the object for this callback
-*   defpath == definition XPath location
+*   modname == module that defines the target object for
+*              these callback functions 
+*   defpath == Xpath with default (or no) prefixes
+*              defining the object that will get the callbacks
+*   version == exact module revision date expected
+*              if condition not met then an error will
+*              be logged  (TBD: force unload of module!)
+*           == NULL means use any version of the module
+*   cbfn    == address of callback function to use for
+*              all callback phases
+*   startfn == address of commit start function
 *
 * RETURNS:
-*   none
+*   status
 *********************************************************************/
-void
-    agt_cb_unregister_callback(const xmlChar *modname,
-                               const xmlChar *defpath,
-                               const agt_cb_fn_t cbfn)
+status_t 
+    agt_cb_register_parallel_callback (const xmlChar *modname,
+                                       const xmlChar *defpath,
+                                       const xmlChar *version,
+                                       const agt_cb_fn_t cbfn,
+                                       const agt_cb_start_fn_t startfn)
 {
-    agt_cb_modhdr_t  *modhdr;
-    agt_cb_set_t     *callback;
-    obj_template_t   *obj;
-    status_t          res;
+    agt_cb_modhdr_t    *modhdr;
+    agt_cb_set_t       *callback;
+    ncx_module_t       *mod;
+    status_t            res;
+    agt_cbtyp_t         cbtyp;
+    agt_cb_fnset_t      cbset;
 
 #ifdef DEBUG
-    if (!modname || !defpath) {
-        SET_ERROR(ERR_INTERNAL_PTR);
-        return;
+    if (!modname || !defpath || !cbfn || !startfn) {
+        return SET_ERROR(ERR_INTERNAL_PTR);
     }
 #endif
 
     modhdr = find_modhdr(modname);
     if (!modhdr) {
-        /* entry not found; assume it is an early exit cleanup */
-        return;
+        modhdr = new_modhdr(modname);
+        if (!modhdr) {
+            return ERR_INTERNAL_MEM;
+        }
+        res = add_modhdr(modhdr);
+        if (res != NO_ERR) {
+            free_modhdr(modhdr);
+            return res;
+        }
     }
 
-    callback = find_callback(modhdr, defpath, cbfn);
+    memset(&cbset, 0x0, sizeof(agt_cb_fnset_t));
+    for (cbtyp = AGT_CB_VALIDATE;
+         cbtyp <= AGT_CB_ROLLBACK;
+         cbtyp++) {
+        cbset.cbfn[cbtyp] = cbfn;
+    }
+
+    callback = new_callback(modhdr,
+                            defpath,
+                            version,
+                            &cbset);
     if (!callback) {
-        SET_ERROR(ERR_INTERNAL_VAL);
-        return;
+        return ERR_INTERNAL_MEM;
     }
+    callback->startfn = startfn;
 
-    res = xpath_find_schema_target_int(defpath, &obj);
-    if (res == NO_ERR) {
-        agt_cb_fnset_node_t* cbset_node;
-        for (cbset_node = (agt_cb_fnset_node_t*)dlq_firstEntry(&obj->cbsetQ);
-             cbset_node!=NULL;
-             cbset_node = (agt_cb_fnset_node_t*)dlq_nextEntry(cbset_node)) {
-
-            if(cbset_node->fnset_ptr == &callback->cbset) {
-                dlq_remove(cbset_node);
-                free(cbset_node);
-                break;
-            }
+    res = add_callback(modhdr, callback);
+    if (res != NO_ERR) {
+        return res;
+    }
+
+    /* data structures in place, now check if the module
+     * is loaded yet
+     */
+    mod = ncx_find_module(modname, version);
+    if (!mod) {
+        /* module not present yet */
+        return NO_ERR;
+    }
+
+    res = load_callbacks(mod, modhdr, callback);
+        
+    return res;
+
+}  /* agt_cb_register_parallel_callback */
+
+
+/********************************************************************
+* FUNCTION agt_cb_register_batch_callback
+* 
+* Register an object specific batch callback function
+* The function is used for all callback phases and gets
+* all the changed instances of the object in one call
+*
+* INPUTS:
+*   modname == module that defines the target object for
+*              this callback function 
+*   defpath == Xpath with default (or no) prefixes
+*              defining the object that will get the callbacks
+*   version == exact module revision date expected
+*              if condition not met then an error will
+*              be logged  (TBD: force unload of module!)
+*           == NULL means use any version of the module
+*   batchfn == address of batch callback function to use for
+*              all callback phases
+*
+* RETURNS:
+*   status
+*********************************************************************/
+status_t 
+    agt_cb_register_batch_callback (const xmlChar *modname,
+                                    const xmlChar *defpath,
+                                    const xmlChar *version,
+                                    const agt_cb_batch_fn_t batchfn)
+{
+    agt_cb_modhdr_t    *modhdr;
+    agt_cb_set_t       *callback;
+    ncx_module_t       *mod;
+    status_t            res;
+    agt_cb_fnset_t      cbset;
+
+#ifdef DEBUG
+    if (!modname || !defpath || !batchfn) {
+        return SET_ERROR(ERR_INTERNAL_PTR);
+    }
+#endif
+
+    modhdr = find_modhdr(modname);
+    if (!modhdr) {
+        modhdr = new_modhdr(modname);
+        if (!modhdr) {
+            return ERR_INTERNAL_MEM;
+        }
+        res = add_modhdr(modhdr);
+        if (res != NO_ERR) {
+            free_modhdr(modhdr);
+            return res;
         }
     }
 
-    dlq_remove(callback);
-    free_callback(callback);
+    /* the per-node callbacks are left empty */
+    memset(&cbset, 0x0, sizeof(agt_cb_fnset_t));
+    callback = new_callback(modhdr,
+                            defpath,
+                            version,
+                            &cbset);
+    if (!callback) {
+        return ERR_INTERNAL_MEM;
+    }
+    callback->batchfn = batchfn;
 
-    if (dlq_empty(&modhdr->callbackQ)) {
-        dlq_remove(modhdr);
-        free_modhdr(modhdr);
+    res = add_callback(modhdr, callback);
+    if (res != NO_ERR) {
+        return res;
     }
 
+    /* data structures in place, now check if the module
+     * is loaded yet
+     */
+    mod = ncx_find_module(modname, version);
+    if (!mod) {
+        /* module not present yet */
+        return NO_ERR;
+    }
+
+    res = load_callbacks(mod, modhdr, callback);
+        
+    return res;
+
+}  /* agt_cb_register_batch_callback */
+
+
+/********************************************************************
+* FUNCTION agt_cb_unregister_callback
+*
+* Unregister all callback functions for a specific object with mathching
+* callback function pointers.
+*
+* INPUTS:
+*   modname == module containing the object for this callback
+*   defpath == definition XPath location
+*
+* RETURNS:
+*   none
+*********************************************************************/
+void
+    agt_cb_unregister_callback(const xmlChar *modname,
+                               const xmlChar *defpath,
+                               const agt_cb_fn_t cbfn)
+{
+    unregister_callback(modname, defpath, cbfn, NULL);
+
 }  /* agt_cb_unregister_callback */
 
+
+/********************************************************************
+* FUNCTION agt_cb_unregister_batch_callback
+*
+* Unregister a batch callback function for a specific object
+*
+* INPUTS:
+*   modname == module containing the object for this callback
+*   defpath == definition XPath location
+*   batchfn == pointer to registered batch callback function
+*
+* RETURNS:
+*   none
+*********************************************************************/
+void
+    agt_cb_unregister_batch_callback (const xmlChar *modname,
+                                      const xmlChar *defpath,
+                                      const agt_cb_batch_fn_t batchfn)
+{
+#ifdef DEBUG
+    if (!batchfn) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    unregister_callback(modname, defpath, NULL, batchfn);
+
+}  /* agt_cb_unregister_batch_callback */
+
 /********************************************************************
 * FUNCTION agt_cb_unregister_callbacks
 *
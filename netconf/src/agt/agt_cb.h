@@ -94,9 +94,88 @@ typedef struct agt_cb_fnset_t_ {
     agt_cb_fn_t    cbfn[AGT_NUM_CB];
 } agt_cb_fnset_t;
 
+
+/* one changed instance passed to an agt_cb_batch_fn_t
+ * The editop, newval and curval fields have the same meaning
+ * as the agt_cb_fn_t parameters with the same names
+ */
+typedef struct agt_cb_edit_t_ {
+    dlq_hdr_t          qhdr;
+    op_editop_t        editop;
+    val_value_t       *newval;
+    val_value_t       *curval;
+} agt_cb_edit_t;
+
+
+/* Batch callback function for server object handler 
+ * Used instead of an agt_cb_fn_t to get all the changed
+ * instances of an object in one call per callback phase
+ *
+ * The VALIDATE, APPLY and COMMIT callbacks for all the edits
+ * in a transaction are invoked at the end of the phase.
+ * Any callbacks for the child nodes of the edited instances
+ * are invoked before the batch.  The ROLLBACK callbacks and
+ * the callbacks that reverse a partial commit are invoked
+ * with 1 edit at a time.
+ *
+ * INPUTS:
+ *   scb == session control block making the request
+ *   msg == incoming rpc_msg_t in progress
+ *   cbtyp == reason for the callback
+ *   editQ == Q of agt_cb_edit_t; 1 for each changed instance
+ *            in the order the edits were done.  The Q and the
+ *            records are freed by the server after the call
+ *
+ * RETURNS:
+ *    status; if not NO_ERR then all the edits in editQ
+ *    are considered to have failed
+ */
+typedef status_t 
+    (*agt_cb_batch_fn_t) (ses_cb_t  *scb,
+                          rpc_msg_t *msg,
+                          agt_cbtyp_t cbtyp,
+                          dlq_hdr_t *editQ);
+
+
+/* Commit start function for server object handler 
+ * Used to run the COMMIT callbacks for different top-level
+ * subtrees at the same time.  The commit of the edit is sent
+ * to the backend and the file descriptor that will become
+ * readable when the backend is done is returned.  The server
+ * continues with the edits in other top-level subtrees and
+ * calls the agt_cb_fn_t COMMIT callback for the edit to read
+ * the result once the fd is readable.  The next edit in the
+ * same top-level subtree is not started before that.
+ *
+ * INPUTS:
+ *   scb == session control block making the request
+ *   msg == incoming rpc_msg_t in progress
+ *   editop == the edit operation passed to the COMMIT callback
+ *   newval == new value passed to the COMMIT callback
+ *   curval == current value passed to the COMMIT callback
+ *   fd == address of return file descriptor
+ *
+ * OUTPUTS:
+ *   *fd == file descriptor to wait for
+ *
+ * RETURNS:
+ *    status: NO_ERR if the commit was started;
+ *    any error to call the COMMIT callback directly
+ */
+typedef status_t 
+    (*agt_cb_start_fn_t) (ses_cb_t  *scb,
+                          rpc_msg_t *msg,
+                          op_editop_t  editop,
+                          val_value_t  *newval,
+                          val_value_t  *curval,
+                          int *fd);
+
+
 typedef struct agt_cb_fnset_node_t_ {
     dlq_hdr_t          qhdr;
     agt_cb_fnset_t*    fnset_ptr;
+    agt_cb_batch_fn_t  batchfn;
+    agt_cb_start_fn_t  startfn;
 } agt_cb_fnset_node_t;
 
 
@@ -186,6 +265,68 @@ extern status_t
 			       const agt_cb_fnset_t *cbfnset);
 
 
+/********************************************************************
+* FUNCTION agt_cb_register_batch_callback
+* 
+* Register an object specific batch callback function
+* The function is used for all callback phases and gets
+* all the changed instances of the object in one call
+*
+* INPUTS:
+*   modname == module that defines the target object for
+*              this callback function 
+*   defpath == Xpath with default (or no) prefixes
+*              defining the object that will get the callbacks
+*   version == exact module revision date expected
+*              if condition not met then an error will
+*              be logged  (TBD: force unload of module!)
+*           == NULL means use any version of the module
+*   batchfn == address of batch callback function to use for
+*              all callback phases
+*
+* RETURNS:
+*   status
+*********************************************************************/
+extern status_t 
+    agt_cb_register_batch_callback (const xmlChar *modname,
+                                    const xmlChar *defpath,
+                                    const xmlChar *version,
+                                    const agt_cb_batch_fn_t batchfn);
+
+
+/********************************************************************
+* FUNCTION agt_cb_register_parallel_callback
+* 
+* Register an object specific callback function
+* with a commit start function.  Same as
+* agt_cb_register_callback, but the COMMIT callbacks
+* for the object can run at the same time as the ones
+* for other top-level subtrees
+*
+* INPUTS:
+*   modname == module that defines the target object for
+*              these callback functions 
+*   defpath == Xpath with default (or no) prefixes
+*              defining the object that will get the callbacks
+*   version == exact module revision date expected
+*              if condition not met then an error will
+*              be logged  (TBD: force unload of module!)
+*           == NULL means use any version of the module
+*   cbfn    == address of callback function to use for
+*              all callback phases
+*   startfn == address of commit start function
+*
+* RETURNS:
+*   status
+*********************************************************************/
+extern status_t 
+    agt_cb_register_parallel_callback (const xmlChar *modname,
+                                       const xmlChar *defpath,
+                                       const xmlChar *version,
+                                       const agt_cb_fn_t cbfn,
+                                       const agt_cb_start_fn_t startfn);
+
+
 /********************************************************************
 * FUNCTION agt_cb_unregister_callbacks
 *   !!!DEPRECATED - breaks multiple callbacks per obj id
@@ -226,6 +367,25 @@ extern void
                                const agt_cb_fn_t cbfn);
 
 
+/********************************************************************
+* FUNCTION agt_cb_unregister_batch_callback
+*
+* Unregister a batch callback function for a specific object
+*
+* INPUTS:
+*   modname == module containing the object for this callback
+*   defpath == definition XPath location
+*   batchfn == pointer to registered batch callback function
+*
+* RETURNS:
+*   none
+*********************************************************************/
+extern void
+    agt_cb_unregister_batch_callback (const xmlChar *modname,
+                                      const xmlChar *defpath,
+                                      const agt_cb_batch_fn_t batchfn);
+
+
 #ifdef __cplusplus
 }  /* end extern 'C' */
 #endif
@@ -110,7 +110,8 @@
       |  newnode  | <- val_swap_child  | newnode_marker |
       +-----------+                    +----------------+
 
-   If curnode exists and it is a leaf:
+   The curnode is never copied, except when a leaf is changed in place
+   (see below):
 
       +-----------+                  +---------------+
       |  curnode  | val_clone_ex ->  | curnode_clone |
@@ -126,7 +127,17 @@
 
    AGT_CFG_EDIT_ACTION_SET:
 
-     Merge leaf or duplicate leaf-list if curnode exists.
+     Set leaf or leaf-list if curnode exists.
+     The newnode is put next to the curnode, which is marked
+     as deleted and kept as the backup until the commit.
+     The newnode_marker stays in the source tree.
+
+      +-----------+                     +---------+---------+
+      |  newnode  | val_insert_child -> | curnode | newnode |
+      +-----------+                     +---------+---------+
+
+     An index leaf or a leaf with metadata is changed in place
+     instead, after the curnode_clone is saved.
      The newnode will be placed back in its source tree
       in the recovery phase.
 
@@ -180,6 +191,7 @@ date         init     comment
 
 #include "procdefs.h"
 #include "agt.h"
+#include "agt_cb.h"
 #include "agt_cfg.h"
 #include "agt_util.h"
 #include "cfg.h"
@@ -494,10 +506,11 @@ agt_cfg_transaction_t *
         return NULL;
     }
 
-    memset(txcb, 0x0, sizeof txcb);
+    memset(txcb, 0x0, sizeof *txcb);
     dlq_createSQue(&txcb->undoQ);
     dlq_createSQue(&txcb->auditQ);
     dlq_createSQue(&txcb->deadnodeQ);
+    dlq_createSQue(&txcb->batchQ);
     txcb->txid = allocate_txid();
     txcb->cfg_id = cfgid;
     txcb->rootcheck = rootcheck;
@@ -568,6 +581,13 @@ void
         agt_cfg_free_nodeptr(nodeptr);
     }
 
+    /* clean batch queue; only used if a phase was not finished */
+    while (!dlq_empty(&txcb->batchQ)) {
+        agt_cfg_batch_t *batch = (agt_cfg_batch_t *)
+            dlq_deque(&txcb->batchQ);
+        agt_cfg_free_batch(batch);
+    }
+
     m__free(txcb);
 
 }  /* agt_cfg_free_transaction */
@@ -916,6 +936,95 @@ void
 } /* agt_cfg_free_nodeptr */
 
 
+/********************************************************************
+* FUNCTION agt_cfg_new_batch
+*
+* Malloc and initialize a new agt_cfg_batch_t struct
+*
+* INPUTS:
+*   obj == object the batch callback is registered for
+*   batchfn == batch callback function to invoke
+* RETURNS:
+*   pointer to struct or NULL or memory error
+*********************************************************************/
+agt_cfg_batch_t *
+    agt_cfg_new_batch (obj_template_t *obj,
+                       agt_cb_batch_fn_t batchfn)
+{
+    agt_cfg_batch_t *batch;
+
+    batch = m__getObj(agt_cfg_batch_t);
+    if (!batch) {
+        return NULL;
+    }
+    memset(batch, 0x0, sizeof(agt_cfg_batch_t));
+    dlq_createSQue(&batch->editQ);
+    batch->obj = obj;
+    batch->batchfn = batchfn;
+    batch->res = ERR_NCX_SKIPPED;
+    return batch;
+
+} /* agt_cfg_new_batch */
+
+
+/********************************************************************
+* FUNCTION agt_cfg_add_batch_edit
+*
+* Add an edit to the editQ of a agt_cfg_batch_t struct
+*
+* INPUTS:
+*   batch == agt_cfg_batch_t to add the edit to
+*   editop == edit operation for the SIL callback
+*   newval == new node in the operation
+*   curval == current node in the operation
+* RETURNS:
+*   status
+*********************************************************************/
+status_t
+    agt_cfg_add_batch_edit (agt_cfg_batch_t *batch,
+                            op_editop_t editop,
+                            val_value_t *newval,
+                            val_value_t *curval)
+{
+    agt_cb_edit_t *edit;
+
+    edit = m__getObj(agt_cb_edit_t);
+    if (!edit) {
+        return ERR_INTERNAL_MEM;
+    }
+    memset(edit, 0x0, sizeof(agt_cb_edit_t));
+    edit->editop = editop;
+    edit->newval = newval;
+    edit->curval = curval;
+    dlq_enque(edit, &batch->editQ);
+    return NO_ERR;
+
+} /* agt_cfg_add_batch_edit */
+
+
+/********************************************************************
+* FUNCTION agt_cfg_free_batch
+*
+* Free all the memory used by the specified agt_cfg_batch_t
+*
+* INPUTS:
+*   batch == agt_cfg_batch_t to clean and delete
+*********************************************************************/
+void 
+    agt_cfg_free_batch (agt_cfg_batch_t *batch)
+{
+    if (!batch) {
+        return;
+    }
+    while (!dlq_empty(&batch->editQ)) {
+        agt_cb_edit_t *edit = (agt_cb_edit_t *)dlq_deque(&batch->editQ);
+        m__free(edit);
+    }
+    m__free(batch);
+
+} /* agt_cfg_free_batch */
+
+
 /********************************************************************
 * FUNCTION agt_cfg_update_txid
 *
@@ -36,6 +36,10 @@ date	     init     comment
 #include "agt.h"
 #endif
 
+#ifndef _H_agt_cb
+#include "agt_cb.h"
+#endif
+
 #ifndef _H_cfg
 #include "cfg.h"
 #endif
@@ -101,6 +105,18 @@ typedef enum agt_cfg_edit_type_t_ {
 } agt_cfg_edit_type_t;
 
 
+/* struct of edits queued for 1 SIL batch callback function
+ * for 1 object in the current callback phase
+ */
+typedef struct agt_cfg_batch_t_ {
+    dlq_hdr_t          qhdr;
+    obj_template_t    *obj;
+    agt_cb_batch_fn_t  batchfn;
+    dlq_hdr_t          editQ;     /* Q of agt_cb_edit_t */
+    status_t           res;
+} agt_cfg_batch_t;
+
+
 /* struct representing 1 configuration database edit transaction
  * - A NETCONF transaction is any write attempt to a specific config.
  * 
@@ -150,6 +166,18 @@ typedef struct agt_cfg_transaction_t_ {
 
     /* contains nodes marked as deleted by the delete_dead_nodes test */
     dlq_hdr_t            deadnodeQ;   /* Q of agt_cfg_nodeptr_t */
+
+    /* set while the sort-merge matched child nodes of bulkparent
+     * are applied; lastentry is the last list entry added to it */
+    val_value_t         *bulkparent;
+    val_value_t         *lastentry;
+
+    /* edits for SIL batch callbacks are queued while batching is set
+     * and invoked at the end of the callback phase; editbatch is the
+     * first batch that got an edit since it was last cleared */
+    dlq_hdr_t            batchQ;      /* Q of agt_cfg_batch_t */
+    boolean              batching;
+    agt_cfg_batch_t     *editbatch;
 } agt_cfg_transaction_t;
 
 
@@ -181,6 +209,7 @@ typedef struct agt_cfg_undo_rec_t_ {
     status_t        apply_res;
     status_t        commit_res;
     status_t        rollback_res;
+    agt_cfg_batch_t *batch;        /* batch with the COMMIT edit */
 
 } agt_cfg_undo_rec_t;
 
@@ -428,6 +457,54 @@ extern agt_cfg_nodeptr_t *
 extern void 
     agt_cfg_free_nodeptr (agt_cfg_nodeptr_t *nodeptr);
 
+/********************************************************************
+* FUNCTION agt_cfg_new_batch
+*
+* Malloc and initialize a new agt_cfg_batch_t struct
+*
+* INPUTS:
+*   obj == object the batch callback is registered for
+*   batchfn == batch callback function to invoke
+* RETURNS:
+*   pointer to struct or NULL or memory error
+*********************************************************************/
+extern agt_cfg_batch_t *
+    agt_cfg_new_batch (obj_template_t *obj,
+                       agt_cb_batch_fn_t batchfn);
+
+
+/********************************************************************
+* FUNCTION agt_cfg_add_batch_edit
+*
+* Add an edit to the editQ of a agt_cfg_batch_t struct
+*
+* INPUTS:
+*   batch == agt_cfg_batch_t to add the edit to
+*   editop == edit operation for the SIL callback
+*   newval == new node in the operation
+*   curval == current node in the operation
+* RETURNS:
+*   status
+*********************************************************************/
+extern status_t
+    agt_cfg_add_batch_edit (agt_cfg_batch_t *batch,
+                            op_editop_t editop,
+                            val_value_t *newval,
+                            val_value_t *curval);
+
+
+/********************************************************************
+* FUNCTION agt_cfg_free_batch
+*
+* Free all the memory used by the specified agt_cfg_batch_t
+*
+* INPUTS:
+*   batch == agt_cfg_batch_t to clean and delete
+*********************************************************************/
+extern void 
+    agt_cfg_free_batch (agt_cfg_batch_t *batch);
+
+
 /********************************************************************
 * FUNCTION agt_cfg_update_txid
 *
@@ -42,6 +42,7 @@ date         init     comment
 #include "help.h"
 #include "ncx.h"
 #include "ncxconst.h"
+#include "ncxmod.h"
 #include "obj.h"
 #include "status.h"
 #include "val.h"
@@ -324,6 +325,66 @@ static void
         agt_profile->agt_max_sessions = VAL_UINT(val);
     }
 
+    /* get lazy-groupings param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX, NCX_EL_LAZY_GROUPINGS);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_lazy_groupings = VAL_BOOL(val);
+    }
+
+    /* get getcb-deadline param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX,
+                         NCX_EL_GETCB_DEADLINE);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_getcb_deadline = VAL_UINT(val);
+    }
+
+    /* get commit-deadline param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX,
+                         NCX_EL_COMMIT_DEADLINE);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_commit_deadline = VAL_UINT(val);
+    }
+
+    /* get stream-output param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX, NCX_EL_STREAM_OUTPUT);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_stream_output = VAL_BOOL(val);
+    }
+
+    /* get pipeline-edits param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX, NCX_EL_PIPELINE_EDITS);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_pipeline_edits = VAL_BOOL(val);
+    }
+
+    /* get session-buffer-size param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX,
+                         NCX_EL_SESSION_BUFFER_SIZE);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_buffsize = VAL_UINT(val);
+    }
+
+    /* get max-session-buffer-size param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX,
+                         NCX_EL_MAX_SESSION_BUFFER_SIZE);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_max_buffsize = VAL_UINT(val);
+    }
+
+    /* get max-send-buffers param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX,
+                         NCX_EL_MAX_SEND_BUFFERS);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_max_buffsend = VAL_UINT(val);
+    }
+
+    /* get max-send-bytes param */
+    val = val_find_child(valset, AGT_CLI_MODULE_EX,
+                         NCX_EL_MAX_SEND_BYTES);
+    if (val && val->res == NO_ERR) {
+        agt_profile->agt_max_bytesend = VAL_UINT(val);
+    }
+
     val = val_find_child(valset,
                          AGT_CLI_MODULE_EX,
                          NCX_EL_TCP_DIRECT_PORT);
@@ -545,6 +606,12 @@ status_t
             return res;
         }
 
+        /* check the module-cache parameter */
+        val = val_find_child(valset, AGT_CLI_MODULE_EX, NCX_EL_MODULE_CACHE);
+        if (val && val->res == NO_ERR) {
+            ncxmod_set_modcache(VAL_STR(val));
+        }
+
         /* check the system-sorted param */
         val = val_find_child(valset, AGT_CLI_MODULE, NCX_EL_SYSTEM_SORTED);
         if (val && val->res == NO_ERR) {
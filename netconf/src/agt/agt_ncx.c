@@ -33,6 +33,7 @@ date         init     comment
 
 #include  "procdefs.h"
 #include "agt.h"
+#include "agt_acm.h"
 #include "agt_cap.h"
 #include "agt_cb.h"
 #include "agt_cfg.h"
@@ -48,6 +49,7 @@ date         init     comment
 #include "agt_util.h"
 #include "agt_val.h"
 #include "agt_commit_validate.h"
+#include "b64.h"
 #include "cap.h"
 #include "cfg.h"
 #include "ncxmod.h"
@@ -60,6 +62,8 @@ date         init     comment
 #include  "tstamp.h"
 #include  "val.h"
 #include  "xml_wr.h"
+#include  "xpath.h"
+#include  "xpath1.h"
 #include  "yangconst.h"
 #include  "uptime.h"
 
@@ -71,6 +75,20 @@ date         init     comment
 
 #define IF_MODIFIED_SINCE (const xmlChar *)"if-modified-since"
 
+#define LIST_PAGINATION_MOD \
+    (const xmlChar *)"yuma123-list-pagination"
+
+#define LIST_PAGINATION   (const xmlChar *)"list-pagination"
+#define LIST_TARGET       (const xmlChar *)"list-target"
+#define LIST_LIMIT        (const xmlChar *)"limit"
+#define LIST_OFFSET       (const xmlChar *)"offset"
+#define LIST_START_AFTER  (const xmlChar *)"start-after"
+
+/* <rpc-reply> attributes added for a list-pagination request */
+#define LIST_REMAINING    (const xmlChar *)"remaining"
+#define LIST_NEXT_CURSOR  (const xmlChar *)"next-cursor"
+
+
 
 /********************************************************************
 *                                                                   *
@@ -111,6 +129,19 @@ typedef struct edit_parms_t_ {
 } edit_parms_t;
 
 
+
+
+/* list-pagination page passed from validate to the
+ * data output callback; the entries are sorted by key
+ */
+typedef struct list_page_t_ {
+    val_value_t     *root;            /* config root */
+    val_value_t     *parent;          /* parent of the entries */
+    val_value_t    **entries;         /* malloced */
+    uint32           count;
+} list_page_t;
+
+
 /********************************************************************
 *                                                                   *
 *                       V A R I A B L E S                           *
@@ -252,6 +283,975 @@ static status_t
 } /* cfg_save_inline */
 
 
+/********************************************************************
+* FUNCTION free_list_page
+*
+* Free a list-pagination page
+*
+* INPUTS:
+*    page == page to free
+*********************************************************************/
+static void
+    free_list_page (list_page_t *page)
+{
+    if (page->entries != NULL) {
+        m__free(page->entries);
+    }
+    m__free(page);
+
+} /* free_list_page */
+
+
+/********************************************************************
+* FUNCTION compare_list_entries
+*
+* qsort compare function to sort list entries by key
+*
+* INPUTS:
+*    p1 == pointer to the 1st entry pointer
+*    p2 == pointer to the 2nd entry pointer
+* RETURNS:
+*    -1, 0 or 1 as for val_index_compare
+*********************************************************************/
+static int
+    compare_list_entries (const void *p1,
+                          const void *p2)
+{
+    const val_value_t *val1 = *(val_value_t * const *)p1;
+    const val_value_t *val2 = *(val_value_t * const *)p2;
+
+    return val_index_compare(val1, val2);
+
+} /* compare_list_entries */
+
+
+/********************************************************************
+* FUNCTION sift_up_entry
+*
+* Restore the max-heap order after an entry was added
+* at the end of the heap
+*
+* INPUTS:
+*    heap == array of entries in max-heap order by key
+*    count == number of entries in the heap
+*********************************************************************/
+static void
+    sift_up_entry (val_value_t **heap,
+                   uint32 count)
+{
+    val_value_t  *tmp;
+    uint32        i, parent;
+
+    i = count - 1;
+    while (i > 0) {
+        parent = (i - 1) / 2;
+        if (val_index_compare(heap[i], heap[parent]) <= 0) {
+            break;
+        }
+        tmp = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = tmp;
+        i = parent;
+    }
+
+} /* sift_up_entry */
+
+
+/********************************************************************
+* FUNCTION sift_down_entry
+*
+* Restore the max-heap order after the top entry was replaced
+*
+* INPUTS:
+*    heap == array of entries in max-heap order by key
+*    count == number of entries in the heap
+*********************************************************************/
+static void
+    sift_down_entry (val_value_t **heap,
+                     uint32 count)
+{
+    val_value_t  *tmp;
+    uint32        i, child;
+
+    i = 0;
+    for (;;) {
+        child = 2 * i + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count &&
+            val_index_compare(heap[child + 1], heap[child]) > 0) {
+            child++;
+        }
+        if (val_index_compare(heap[child], heap[i]) <= 0) {
+            break;
+        }
+        tmp = heap[i];
+        heap[i] = heap[child];
+        heap[child] = tmp;
+        i = child;
+    }
+
+} /* sift_down_entry */
+
+
+/********************************************************************
+* FUNCTION make_list_cursor
+*
+* Make the next-cursor value for a list entry
+* The cursor is the base64 encoding of the key values
+* separated by a zero byte
+*
+* INPUTS:
+*    entry == last list entry of the page
+*    res == address of return status
+* OUTPUTS:
+*    *res == return status
+* RETURNS:
+*    malloced cursor string or NULL if error
+*********************************************************************/
+static xmlChar *
+    make_list_cursor (const val_value_t *entry,
+                      status_t *res)
+{
+    const val_index_t  *valindex;
+    xmlChar            *keystr, *buff, *newbuff, *cursor;
+    uint32              len, keylen, cursorlen, retlen;
+
+    buff = NULL;
+    len = 0;
+    for (valindex = val_get_first_index(entry);
+         valindex != NULL;
+         valindex = val_get_next_index(valindex)) {
+
+        keystr = val_make_sprintf_string(valindex->val);
+        if (keystr == NULL) {
+            if (buff) {
+                m__free(buff);
+            }
+            *res = ERR_INTERNAL_MEM;
+            return NULL;
+        }
+
+        /* copy the key with the zero byte after it */
+        keylen = xml_strlen(keystr) + 1;
+        newbuff = m__getMem(len + keylen);
+        if (newbuff == NULL) {
+            m__free(keystr);
+            if (buff) {
+                m__free(buff);
+            }
+            *res = ERR_INTERNAL_MEM;
+            return NULL;
+        }
+        if (buff) {
+            memcpy(newbuff, buff, len);
+            m__free(buff);
+        }
+        memcpy(newbuff + len, keystr, keylen);
+        m__free(keystr);
+        buff = newbuff;
+        len += keylen;
+    }
+
+    if (buff == NULL) {
+        *res = SET_ERROR(ERR_INTERNAL_VAL);
+        return NULL;
+    }
+
+    /* no separator after the last key */
+    len--;
+
+    cursorlen = b64_get_encoded_str_len(len, 0);
+    cursor = m__getMem(cursorlen);
+    if (cursor == NULL) {
+        m__free(buff);
+        *res = ERR_INTERNAL_MEM;
+        return NULL;
+    }
+
+    *res = b64_encode(buff, len, cursor, cursorlen, 0, &retlen);
+    m__free(buff);
+    if (*res != NO_ERR) {
+        m__free(cursor);
+        return NULL;
+    }
+    return cursor;
+
+} /* make_list_cursor */
+
+
+/********************************************************************
+* FUNCTION new_cursor_entry
+*
+* Make a list entry with the key values from a start-after
+* cursor so it can be compared with val_index_compare
+*
+* INPUTS:
+*    listobj == list object of the selected entries
+*    cursor == start-after parameter value
+*    res == address of return status
+* OUTPUTS:
+*    *res == return status
+* RETURNS:
+*    malloced list entry or NULL if error
+*********************************************************************/
+static val_value_t *
+    new_cursor_entry (obj_template_t *listobj,
+                      const xmlChar *cursor,
+                      status_t *res)
+{
+    obj_key_t      *objkey;
+    val_value_t    *entry, *keyval;
+    xmlChar        *buff;
+    const xmlChar  *keystr;
+    uint32          cursorlen, bufflen, retlen;
+
+    cursorlen = xml_strlen(cursor);
+    bufflen = b64_get_decoded_str_len(cursor, cursorlen);
+    buff = m__getMem(bufflen + 1);
+    if (buff == NULL) {
+        *res = ERR_INTERNAL_MEM;
+        return NULL;
+    }
+
+    *res = b64_decode(cursor, cursorlen, buff, bufflen, &retlen);
+    if (*res != NO_ERR) {
+        m__free(buff);
+        return NULL;
+    }
+    buff[retlen] = 0;
+
+    entry = val_new_value();
+    if (entry == NULL) {
+        m__free(buff);
+        *res = ERR_INTERNAL_MEM;
+        return NULL;
+    }
+    val_init_from_template(entry, listobj);
+
+    keystr = buff;
+    for (objkey = obj_first_key(listobj);
+         objkey != NULL && *res == NO_ERR;
+         objkey = obj_next_key(objkey)) {
+
+        if (keystr > buff + retlen) {
+            /* fewer values than keys */
+            *res = ERR_NCX_INVALID_VALUE;
+            break;
+        }
+
+        keyval = val_make_simval_obj(objkey->keyobj, keystr, res);
+        if (keyval != NULL) {
+            val_add_child(keyval, entry);
+        }
+        keystr += xml_strlen(keystr) + 1;
+    }
+
+    if (*res == NO_ERR && keystr != buff + retlen + 1) {
+        /* more values than keys */
+        *res = ERR_NCX_INVALID_VALUE;
+    }
+
+    if (*res == NO_ERR) {
+        *res = val_gen_index_chain(listobj, entry);
+    }
+
+    m__free(buff);
+    if (*res != NO_ERR) {
+        val_free_value(entry);
+        return NULL;
+    }
+    return entry;
+
+} /* new_cursor_entry */
+
+
+/********************************************************************
+* FUNCTION set_reply_attr
+*
+* Set an attribute of the <rpc-reply> element, replacing
+* the attribute with the same name copied from the <rpc>
+*
+* INPUTS:
+*    msg == rpc_msg_t in progress
+*    name == attribute name
+*    value == attribute value
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    set_reply_attr (rpc_msg_t *msg,
+                    const xmlChar *name,
+                    const xmlChar *value)
+{
+    xml_attr_t  *attr;
+
+    attr = xml_find_attr_q(msg->rpc_in_attrs, 0, name);
+    if (attr != NULL) {
+        dlq_remove(attr);
+        xml_free_attr(attr);
+    }
+
+    return xml_add_attr(msg->rpc_in_attrs, 0, name, value);
+
+} /* set_reply_attr */
+
+
+/********************************************************************
+* FUNCTION add_page_entry
+*
+* Add a list entry at the end of the page entries array
+*
+* INPUTS:
+*    entries == address of the malloced entries array
+*    size == address of the array size
+*    count == address of the number of entries in the array
+*    maxcount == max number of entries to keep; 0 for no max
+*    entry == list entry to add
+* OUTPUTS:
+*    *entries and *size are updated if the array is grown
+*    *count is incremented
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    add_page_entry (val_value_t ***entries,
+                    uint32 *size,
+                    uint32 *count,
+                    uint32 maxcount,
+                    val_value_t *entry)
+{
+    val_value_t  **newentries;
+    uint32         newsize;
+
+    if (*count == *size) {
+        newsize = (*size != 0) ? *size * 2 : 64;
+        if (maxcount != 0 && newsize > maxcount) {
+            newsize = maxcount;
+        }
+        newentries = m__getMem(newsize * sizeof(val_value_t *));
+        if (newentries == NULL) {
+            return ERR_INTERNAL_MEM;
+        }
+        if (*entries != NULL) {
+            memcpy(newentries, *entries, *count * sizeof(val_value_t *));
+            m__free(*entries);
+        }
+        *entries = newentries;
+        *size = newsize;
+    }
+
+    (*entries)[(*count)++] = entry;
+    return NO_ERR;
+
+} /* add_page_entry */
+
+
+/********************************************************************
+* FUNCTION page_parent_readable
+*
+* Check if the user can read the ancestors of the page entries
+* Nothing is output if an ancestor is not readable, so the
+* entries are not counted either
+*
+* INPUTS:
+*    scb == session control block
+*    msg == rpc_msg_t in progress
+*    page == page with the root and parent set
+* RETURNS:
+*    TRUE if all ancestors of the entries are readable
+*********************************************************************/
+static boolean
+    page_parent_readable (ses_cb_t *scb,
+                          rpc_msg_t *msg,
+                          const list_page_t *page)
+{
+    const val_value_t  *val;
+
+    for (val = page->parent;
+         val != NULL && val != page->root;
+         val = val->parent) {
+        if (!agt_acm_val_read_allowed(&msg->mhdr, scb->username, val)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+
+} /* page_parent_readable */
+
+
+/********************************************************************
+* FUNCTION select_sorted_entries
+*
+* Select the page entries from a node-set that is in key order,
+* which is the order of a system-ordered list in the config.
+* No heap or sort is needed: the entries up to the cursor are
+* skipped without a key compare once the cursor is passed, and
+* only the limit entries of the page are kept.
+*
+* INPUTS:
+*    scb == session control block
+*    msg == rpc_msg_t in progress
+*    result == list-target node-set
+*    cursorentry == start-after entry or NULL if none
+*    offset == number of readable entries to skip
+*    limit == max number of entries in the page; 0 for no max
+*    entries == address of return entries array
+*    count == address of return page entry count
+*    total == address of return readable entry count
+* OUTPUTS:
+*    *entries == malloced page entries in key order
+*    *count == number of page entries
+*    *total == number of readable entries after the cursor
+* RETURNS:
+*    status; ERR_NCX_SKIPPED if the node-set is not in key order
+*********************************************************************/
+static status_t
+    select_sorted_entries (ses_cb_t *scb,
+                           rpc_msg_t *msg,
+                           xpath_result_t *result,
+                           const val_value_t *cursorentry,
+                           uint32 offset,
+                           uint32 limit,
+                           val_value_t ***entries,
+                           uint32 *count,
+                           uint32 *total)
+{
+    xpath_resnode_t  *resnode;
+    val_value_t      *entry, *preventry;
+    uint32            size;
+    status_t          res;
+
+    res = NO_ERR;
+    preventry = NULL;
+    size = 0;
+
+    for (resnode = (xpath_resnode_t *)dlq_firstEntry(&result->r.nodeQ);
+         resnode != NULL && res == NO_ERR;
+         resnode = (xpath_resnode_t *)dlq_nextEntry(resnode)) {
+
+        entry = resnode->node.valptr;
+        if (val_is_virtual_list(entry)) {
+            continue;
+        }
+
+        if (preventry != NULL && val_index_compare(entry, preventry) <= 0) {
+            res = ERR_NCX_SKIPPED;
+            break;
+        }
+        preventry = entry;
+
+        if (cursorentry != NULL) {
+            if (val_index_compare(entry, cursorentry) <= 0) {
+                continue;
+            }
+            cursorentry = NULL;
+        }
+
+        if (!agt_acm_val_read_allowed(&msg->mhdr, scb->username, entry)) {
+            continue;
+        }
+
+        (*total)++;
+        if (*total <= offset || (limit != 0 && *count == limit)) {
+            continue;
+        }
+        res = add_page_entry(entries, &size, count, limit, entry);
+    }
+
+    if (res != NO_ERR) {
+        if (*entries != NULL) {
+            m__free(*entries);
+            *entries = NULL;
+        }
+        *count = 0;
+        *total = 0;
+    }
+    return res;
+
+} /* select_sorted_entries */
+
+
+/********************************************************************
+* FUNCTION select_heap_entries
+*
+* Select the page entries from a node-set in any order.
+* Only offset + limit entries are kept in a max-heap by key
+* while the selected entries are checked, so the first pages
+* do not need the whole list sorted.
+*
+* INPUTS:
+*    scb == session control block
+*    msg == rpc_msg_t in progress
+*    result == list-target node-set
+*    cursorentry == start-after entry or NULL if none
+*    offset == number of readable entries to skip
+*    limit == max number of entries in the page; 0 for no max
+*    entries == address of return entries array
+*    count == address of return page entry count
+*    total == address of return readable entry count
+* OUTPUTS:
+*    *entries == malloced page entries in key order
+*    *count == number of page entries
+*    *total == number of readable entries after the cursor
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    select_heap_entries (ses_cb_t *scb,
+                         rpc_msg_t *msg,
+                         xpath_result_t *result,
+                         const val_value_t *cursorentry,
+                         uint32 offset,
+                         uint32 limit,
+                         val_value_t ***entries,
+                         uint32 *count,
+                         uint32 *total)
+{
+    xpath_resnode_t  *resnode;
+    val_value_t      *entry, **heap;
+    uint32            maxcount, size, skipped;
+    status_t          res;
+
+    /* number of entries to keep; 0 to keep all of them */
+    maxcount = 0;
+    if (limit != 0 && offset <= NCX_MAX_UINT - limit) {
+        maxcount = offset + limit;
+    }
+
+    res = NO_ERR;
+    heap = NULL;
+    size = 0;
+
+    for (resnode = (xpath_resnode_t *)dlq_firstEntry(&result->r.nodeQ);
+         resnode != NULL && res == NO_ERR;
+         resnode = (xpath_resnode_t *)dlq_nextEntry(resnode)) {
+
+        entry = resnode->node.valptr;
+        if (val_is_virtual_list(entry)) {
+            continue;
+        }
+
+        if (cursorentry != NULL &&
+            val_index_compare(entry, cursorentry) <= 0) {
+            continue;
+        }
+
+        if (!agt_acm_val_read_allowed(&msg->mhdr, scb->username, entry)) {
+            continue;
+        }
+        (*total)++;
+
+        if (maxcount != 0 && *count == maxcount) {
+            /* replace the last kept entry if this one is before it */
+            if (val_index_compare(entry, heap[0]) < 0) {
+                heap[0] = entry;
+                sift_down_entry(heap, *count);
+            }
+            continue;
+        }
+
+        res = add_page_entry(&heap, &size, count, maxcount, entry);
+        if (res == NO_ERR && maxcount != 0) {
+            sift_up_entry(heap, *count);
+        }
+    }
+
+    if (res != NO_ERR) {
+        if (heap != NULL) {
+            m__free(heap);
+        }
+        *count = 0;
+        *total = 0;
+        return res;
+    }
+
+    /* sort the kept entries and skip the offset */
+    if (*count > 1) {
+        qsort(heap, *count, sizeof(val_value_t *), compare_list_entries);
+    }
+    skipped = (offset < *count) ? offset : *count;
+    if (skipped != 0 && skipped < *count) {
+        memmove(heap,
+                &heap[skipped],
+                (*count - skipped) * sizeof(val_value_t *));
+    }
+    *count -= skipped;
+
+    *entries = heap;
+    return NO_ERR;
+
+} /* select_heap_entries */
+
+
+/********************************************************************
+* FUNCTION select_list_page
+*
+* Select the list entries for a <get> or <get-config>
+* with the list-pagination parameter
+*
+* The list-target expression is evaluated against the source
+* config.  Entries the user cannot read are not counted, so the
+* page, the remaining count and the next-cursor only come from
+* readable entries.  A system-ordered list is already in key
+* order, so its page is taken in one pass without a sort.
+*
+* The page is saved in rpc_user2 for output_list_page
+* and freed by get_post_reply.  The remaining and next-cursor
+* attributes are added to the <rpc-reply>.
+*
+* INPUTS:
+*    scb == session control block
+*    msg == rpc_msg_t in progress
+*    methnode == method node for errors
+*    source == config to read
+*    pageval == list-pagination parameter
+*    getop == TRUE for <get>; FALSE for <get-config>
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    select_list_page (ses_cb_t *scb,
+                      rpc_msg_t *msg,
+                      xml_node_t *methnode,
+                      cfg_template_t *source,
+                      val_value_t *pageval,
+                      boolean getop)
+{
+    val_value_t      *targetval, *limitval, *offsetval, *cursorval;
+    val_value_t      *entry, *cursorentry, *errval;
+    obj_template_t   *listobj;
+    xpath_result_t   *result;
+    xpath_resnode_t  *resnode;
+    list_page_t      *page;
+    xmlChar          *cursor;
+    xmlChar           numbuff[NCX_MAX_NUMLEN];
+    uint32            limit, offset, total, skipped, remaining;
+    boolean           readable;
+    status_t          res;
+
+    targetval = val_find_child(pageval, LIST_PAGINATION_MOD, LIST_TARGET);
+    limitval = val_find_child(pageval, LIST_PAGINATION_MOD, LIST_LIMIT);
+    offsetval = val_find_child(pageval, LIST_PAGINATION_MOD, LIST_OFFSET);
+    cursorval = val_find_child(pageval, LIST_PAGINATION_MOD,
+                               LIST_START_AFTER);
+    if (targetval == NULL || targetval->xpathpcb == NULL) {
+        return SET_ERROR(ERR_INTERNAL_VAL);
+    }
+
+    /* the page replaces the filter */
+    if (msg->rpc_filter.op_filtyp != OP_FILTER_NONE) {
+        res = ERR_NCX_EXTRA_PARM;
+        agt_record_error(scb, 
+                         &msg->mhdr, 
+                         NCX_LAYER_OPERATION, 
+                         res,
+                         methnode, 
+                         NCX_NT_VAL, 
+                         pageval, 
+                         NCX_NT_VAL, 
+                         pageval);
+        return res;
+    }
+
+    limit = (limitval != NULL) ? VAL_UINT(limitval) : 0;
+    offset = (offsetval != NULL) ? VAL_UINT(offsetval) : 0;
+
+    page = m__getObj(list_page_t);
+    if (page == NULL) {
+        return ERR_INTERNAL_MEM;
+    }
+    memset(page, 0x0, sizeof(list_page_t));
+    page->root = source->root;
+
+    res = NO_ERR;
+    errval = NULL;
+    listobj = NULL;
+    cursorentry = NULL;
+    result = NULL;
+    readable = TRUE;
+    total = 0;
+
+    if (source->root != NULL) {
+        result = xpath1_eval_xmlexpr(scb->reader,
+                                     targetval->xpathpcb,
+                                     source->root,
+                                     source->root,
+                                     FALSE,
+                                     !getop,
+                                     &res);
+        if (res == NO_ERR &&
+            (result == NULL || result->restype != XP_RT_NODESET)) {
+            res = ERR_NCX_INVALID_VALUE;
+        }
+        if (res != NO_ERR) {
+            errval = targetval;
+        }
+    }
+
+    /* all entries must be in the same list instance */
+    for (resnode = (result != NULL && res == NO_ERR) ?
+             (xpath_resnode_t *)dlq_firstEntry(&result->r.nodeQ) : NULL;
+         resnode != NULL;
+         resnode = (xpath_resnode_t *)dlq_nextEntry(resnode)) {
+
+        entry = resnode->node.valptr;
+
+        /* the entries of a virtual list are not in the tree */
+        if (val_is_virtual_list(entry)) {
+            continue;
+        }
+
+        if (listobj == NULL) {
+            listobj = entry->obj;
+            page->parent = entry->parent;
+            if (listobj->objtype != OBJ_TYP_LIST ||
+                obj_first_key(listobj) == NULL) {
+                res = ERR_NCX_INVALID_VALUE;
+                errval = targetval;
+                break;
+            }
+        } else if (entry->obj != listobj ||
+                   entry->parent != page->parent) {
+            /* entries from more than one list instance */
+            res = ERR_NCX_INVALID_VALUE;
+            errval = targetval;
+            break;
+        }
+    }
+
+    if (res == NO_ERR && listobj != NULL && cursorval != NULL) {
+        cursorentry = new_cursor_entry(listobj, VAL_STR(cursorval), &res);
+        if (res != NO_ERR) {
+            if (res != ERR_INTERNAL_MEM) {
+                res = ERR_NCX_INVALID_VALUE;
+            }
+            errval = cursorval;
+        }
+    }
+
+    if (res == NO_ERR && listobj != NULL) {
+        readable = page_parent_readable(scb, msg, page);
+    }
+
+    if (res == NO_ERR && listobj != NULL && readable) {
+        res = ERR_NCX_SKIPPED;
+        if (obj_is_system_ordered(listobj) && ncx_get_system_sorted()) {
+            res = select_sorted_entries(scb, 
+                                        msg, 
+                                        result, 
+                                        cursorentry,
+                                        offset, 
+                                        limit, 
+                                        &page->entries,
+                                        &page->count, 
+                                        &total);
+        }
+        if (res == ERR_NCX_SKIPPED) {
+            res = select_heap_entries(scb, 
+                                      msg, 
+                                      result, 
+                                      cursorentry,
+                                      offset, 
+                                      limit, 
+                                      &page->entries,
+                                      &page->count, 
+                                      &total);
+        }
+    }
+
+    if (result != NULL) {
+        xpath_free_result(result);
+    }
+    if (cursorentry != NULL) {
+        val_free_value(cursorentry);
+    }
+
+    if (res != NO_ERR) {
+        free_list_page(page);
+        agt_record_error(scb, 
+                         &msg->mhdr, 
+                         NCX_LAYER_OPERATION, 
+                         res,
+                         methnode, 
+                         (errval) ? NCX_NT_VAL : NCX_NT_NONE, 
+                         errval, 
+                         (errval) ? NCX_NT_VAL : NCX_NT_NONE, 
+                         errval);
+        return res;
+    }
+
+    skipped = (offset < total) ? offset : total;
+    remaining = total - skipped - page->count;
+
+    if (LOGDEBUG2) {
+        log_debug2("\nagt_ncx: list page %u of %u entries, %u remaining",
+                   page->count,
+                   total,
+                   remaining);
+    }
+
+    snprintf((char *)numbuff, sizeof(numbuff), "%u", remaining);
+    res = set_reply_attr(msg, LIST_REMAINING, numbuff);
+    if (res == NO_ERR && remaining != 0 && page->count != 0) {
+        cursor = make_list_cursor(page->entries[page->count - 1], &res);
+        if (cursor != NULL) {
+            res = set_reply_attr(msg, LIST_NEXT_CURSOR, cursor);
+            m__free(cursor);
+        }
+    }
+    if (res != NO_ERR) {
+        free_list_page(page);
+        return res;
+    }
+
+    msg->rpc_user2 = page;
+    return NO_ERR;
+
+} /* select_list_page */
+
+
+/********************************************************************
+* FUNCTION output_page_node
+*
+* Output the path from curval to the list-pagination page
+* entries, with the key leafs of any list ancestors
+*
+* INPUTS:
+*    scb == session control block
+*    msg == rpc_msg_t in progress
+*    page == page to output
+*    curval == current ancestor of the page entries
+*    getop == TRUE for <get>; FALSE for <get-config>
+*    indent == start indent amount
+*********************************************************************/
+static void
+    output_page_node (ses_cb_t *scb,
+                      rpc_msg_t *msg,
+                      const list_page_t *page,
+                      val_value_t *curval,
+                      boolean getop,
+                      int32 indent)
+{
+    val_value_t  *childval;
+    val_index_t  *valindex;
+    int32         childindent;
+    uint32        i;
+
+    if (curval == page->parent) {
+        for (i = 0; i < page->count; i++) {
+            xml_wr_full_check_val(scb,
+                                  &msg->mhdr,
+                                  page->entries[i],
+                                  indent,
+                                  (getop) ? agt_check_default
+                                  : agt_check_config);
+        }
+        return;
+    }
+
+    /* find the child of curval on the path to the entries */
+    childval = page->parent;
+    while (childval->parent != curval) {
+        childval = childval->parent;
+    }
+
+    if (!agt_acm_val_read_allowed(&msg->mhdr, scb->username, childval)) {
+        return;
+    }
+
+    xml_wr_begin_elem_ex(scb, 
+                         &msg->mhdr,
+                         curval->nsid,
+                         childval->nsid,
+                         childval->name, 
+                         &childval->metaQ, 
+                         FALSE, 
+                         indent, 
+                         FALSE);
+
+    childindent = indent;
+    if (childindent >= 0) {
+        childindent += ses_indent_count(scb);
+    }
+
+    for (valindex = val_get_first_index(childval);
+         valindex != NULL;
+         valindex = val_get_next_index(valindex)) {
+        xml_wr_full_val(scb, &msg->mhdr, valindex->val, childindent);
+    }
+
+    output_page_node(scb, msg, page, childval, getop, childindent);
+
+    xml_wr_end_elem(scb, 
+                    &msg->mhdr, 
+                    childval->nsid,
+                    childval->name, 
+                    indent);
+
+} /* output_page_node */
+
+
+/********************************************************************
+* FUNCTION output_list_page
+*
+* output the list-pagination page for the get or get-config
+* operation
+*
+* INPUTS:
+*    see rpc/agt_rpc.h   (agt_rpc_data_cb_t)
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    output_list_page (ses_cb_t *scb,
+                      rpc_msg_t *msg,
+                      int32 indent)
+{
+    const list_page_t  *page;
+    boolean             getop;
+
+    page = (const list_page_t *)msg->rpc_user2;
+    if (page == NULL || page->count == 0) {
+        return NO_ERR;
+    }
+
+    getop = !xml_strcmp(obj_get_name(msg->rpc_method), NCX_EL_GET);
+    output_page_node(scb, msg, page, page->root, getop, indent);
+    return NO_ERR;
+
+} /* output_list_page */
+
+
+/********************************************************************
+* FUNCTION get_post_reply
+*
+* get and get-config : post reply callback
+* Free the list-pagination page
+*
+* INPUTS:
+*    see agt/agt_rpc.h
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t 
+    get_post_reply (ses_cb_t *scb,
+                    rpc_msg_t *msg,
+                    xml_node_t *methnode)
+{
+    (void)scb;
+    (void)methnode;
+
+    if (msg->rpc_user2 != NULL) {
+        free_list_page((list_page_t *)msg->rpc_user2);
+        msg->rpc_user2 = NULL;
+    }
+    return NO_ERR;
+
+} /* get_post_reply */
+
+
 /********************************************************************
 * FUNCTION get_validate
 *
@@ -268,7 +1268,7 @@ static status_t
                   xml_node_t *methnode)
 {
     cfg_template_t     *source;
-    val_value_t        *testval;
+    val_value_t        *testval, *pageval;
     status_t            res, res2;
     boolean             empty_callback = FALSE;
 
@@ -340,6 +1340,17 @@ static status_t
         m__free(utcstr);
     }
 
+    /* select one page of list entries instead of the filter */
+    pageval = val_find_child(msg->rpc_input,
+                             LIST_PAGINATION_MOD,
+                             LIST_PAGINATION);
+    if (!empty_callback && pageval != NULL && pageval->res == NO_ERR) {
+        res = select_list_page(scb, msg, methnode, source, pageval, TRUE);
+        if (res != NO_ERR) {
+            return res;   /* error already recorded */
+        }
+    }
+
     /* cache the 2 parameters and the data output callback function 
      * There is no invoke function -- it is handled automatically
      * by the agt_rpc module
@@ -348,6 +1359,8 @@ static status_t
     msg->rpc_data_type = RPC_DATA_STD;
     if (empty_callback) {
         msg->rpc_datacb = agt_output_empty;
+    } else if (msg->rpc_user2 != NULL) {
+        msg->rpc_datacb = output_list_page;
     } else {
         msg->rpc_datacb = agt_output_filter;
     }
@@ -372,7 +1385,7 @@ static status_t
                          xml_node_t *methnode)
 {
     cfg_template_t *source;
-    val_value_t    *testval;
+    val_value_t    *testval, *pageval;
     boolean         empty_callback = FALSE;
     status_t        res, res2;
 
@@ -448,6 +1461,17 @@ static status_t
         m__free(utcstr);
     }
 
+    /* select one page of list entries instead of the filter */
+    pageval = val_find_child(msg->rpc_input,
+                             LIST_PAGINATION_MOD,
+                             LIST_PAGINATION);
+    if (!empty_callback && pageval != NULL && pageval->res == NO_ERR) {
+        res = select_list_page(scb, msg, methnode, source, pageval, FALSE);
+        if (res != NO_ERR) {
+            return res;   /* error already recorded */
+        }
+    }
+
     /* cache the 2 parameters and the data output callback function 
      * There is no invoke function -- it is handled automatically
      * by the agt_rpc module
@@ -456,6 +1480,8 @@ static status_t
     msg->rpc_data_type = RPC_DATA_STD;
     if (empty_callback) {
         msg->rpc_datacb = agt_output_empty;
+    } else if (msg->rpc_user2 != NULL) {
+        msg->rpc_datacb = output_list_page;
     } else {
         msg->rpc_datacb = agt_output_filter;
     }
@@ -767,12 +1793,48 @@ static status_t
         val_free_value(urlval);
     }
     m__free(editparms);
+    msg->rpc_user1 = NULL;
 
     return res;
 
 } /* edit_config_invoke */
 
 
+/********************************************************************
+* FUNCTION edit_config_post_reply
+*
+* edit-config : post reply callback
+* Free the parameters of a validated request that was
+* never invoked, e.g. an aborted pipelined request
+*
+* INPUTS:
+*    see agt/agt_rpc.h
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t 
+    edit_config_post_reply (ses_cb_t *scb,
+                            rpc_msg_t *msg,
+                            xml_node_t *methnode)
+{
+    edit_parms_t   *editparms = (edit_parms_t *)msg->rpc_user1;
+
+    (void)scb;
+    (void)methnode;
+
+    if (editparms != NULL) {
+        if (editparms->urlval != NULL) {
+            val_free_value(editparms->urlval);
+        }
+        m__free(editparms);
+        msg->rpc_user1 = NULL;
+    }
+
+    return NO_ERR;
+
+} /* edit_config_post_reply */
+
+
 /********************************************************************
 * FUNCTION validate_copy_source
 *
@@ -3165,6 +4227,13 @@ static status_t
         return SET_ERROR(res);
     }
 
+    res = agt_rpc_register_method(NC_MODULE,
+                                  op_method_name(OP_GET),
+                                  AGT_RPC_PH_POST_REPLY,
+                                  get_post_reply);
+    if (res != NO_ERR) {
+        return SET_ERROR(res);
+    }
 
     /* get-config */
     res = agt_rpc_register_method(NC_MODULE,
@@ -3175,6 +4244,14 @@ static status_t
         return SET_ERROR(res);
     }
 
+    res = agt_rpc_register_method(NC_MODULE,
+                                  op_method_name(OP_GET_CONFIG),
+                                  AGT_RPC_PH_POST_REPLY,
+                                  get_post_reply);
+    if (res != NO_ERR) {
+        return SET_ERROR(res);
+    }
+
     /* edit-config */
     res = agt_rpc_register_method(NC_MODULE,
                                   op_method_name(OP_EDIT_CONFIG),
@@ -3192,6 +4269,14 @@ static status_t
         return SET_ERROR(res);
     }
 
+    res = agt_rpc_register_method(NC_MODULE,
+                                  op_method_name(OP_EDIT_CONFIG),
+                                  AGT_RPC_PH_POST_REPLY,
+                                  edit_config_post_reply);
+    if (res != NO_ERR) {
+        return SET_ERROR(res);
+    }
+
 
     /* copy-config */
     res = agt_rpc_register_method(NC_MODULE,
@@ -3496,10 +4581,21 @@ static void
 status_t 
     agt_ncx_init (void)
 {
-    status_t  res;
+    agt_profile_t  *agt_profile;
+    status_t        res;
 
     if (!agt_ncx_init_done) {
 
+        /* load the list-pagination augments of get and get-config */
+        agt_profile = agt_get_profile();
+        res = ncxmod_load_module(LIST_PAGINATION_MOD,
+                                 NULL,
+                                 &agt_profile->agt_savedevQ,
+                                 NULL);
+        if (res != NO_ERR) {
+            return res;
+        }
+
         res = register_nc_callbacks();
         if (res != NO_ERR) {
             unregister_nc_callbacks();
@@ -243,6 +243,94 @@ static void
 
 
 
+/********************************************************************
+ * FUNCTION wait_outq
+ * 
+ * Suspend the reply in progress for a session until its outQ
+ * is sent down to SES_OUTQ_LOW_WATER buffers
+ * Called by ses_msg when the outQ reaches SES_OUTQ_HIGH_WATER
+ * buffers.  The output queued for the other sessions is sent
+ * while the reply waits, but no input is processed, no timers
+ * are run and no sessions are killed, since the suspended reply
+ * is still using the datastores and the session state.
+ * A session closed by a write failure here is killed by the
+ * main loop after the reply is finished.
+ * 
+ * INPUTS:
+ *    scb == session with the reply in progress
+ *
+ * RETURNS:
+ *    status; the rest of the reply is dropped if not NO_ERR
+ *********************************************************************/
+static status_t
+    wait_outq (ses_cb_t *scb)
+{
+    ses_cb_t         *wscb;
+    fd_set            wait_fd_set;
+    struct timeval    timeout;
+    int               i, maxfdnum, ret;
+    status_t          res;
+
+    while (scb->outqcnt > SES_OUTQ_LOW_WATER) {
+        if (agt_shutdown_requested()) {
+            return ERR_NCX_OPERATION_FAILED;
+        }
+
+        FD_ZERO(&wait_fd_set);
+        maxfdnum = -1;
+        for (i = 0; i < FD_SETSIZE; i++) {
+            if (!FD_ISSET(i, &active_fd_set)) {
+                continue;
+            }
+            wscb = def_reg_find_scb(i);
+            if (wscb && !dlq_empty(&wscb->outQ) &&
+                (wscb == scb || wscb->state < SES_ST_SHUTDOWN_REQ)) {
+                FD_SET(i, &wait_fd_set);
+                maxfdnum = i;
+            }
+        }
+        if (!FD_ISSET(scb->fd, &wait_fd_set)) {
+            return SET_ERROR(ERR_INTERNAL_VAL);
+        }
+
+        timeout.tv_sec = AGT_NCXSERVER_TIMEOUT;
+        timeout.tv_usec = 0;
+        ret = select(maxfdnum+1, NULL, &wait_fd_set, NULL, &timeout);
+        if (ret < 0) {
+            if (errno == EINTR || errno == EAGAIN) {
+                continue;
+            }
+            log_error("\nncxserver select failed (%s)", strerror(errno));
+            return ERR_NCX_OPERATION_FAILED;
+        }
+
+        for (i = 0; i <= maxfdnum; i++) {
+            if (!FD_ISSET(i, &wait_fd_set)) {
+                continue;
+            }
+            wscb = def_reg_find_scb(i);
+            res = ses_msg_send_buffs(wscb);
+            if (res != NO_ERR) {
+                if (wscb == scb) {
+                    return res;
+                }
+                if (LOGINFO) {
+                    log_info("\nagt_ncxserver write failed; "
+                             "closing session %d ", 
+                             wscb->sid);
+                }
+                wscb->killedbysid = wscb->sid;
+                wscb->termreason = SES_TR_OTHER;
+                wscb->state = SES_ST_SHUTDOWN_REQ;
+            }
+        }
+    }
+
+    return NO_ERR;
+
+} /* wait_outq */
+
+
 /***********     E X P O R T E D   F U N C T I O N S   *************/
 
 
@@ -291,6 +379,7 @@ status_t
     }
 
     stream_output = profile->agt_stream_output;
+    ses_msg_set_outq_wait_fn(wait_outq);
 
     if (listen(ncxsock, 1) < 0) {
         log_error("\nError: listen failed");
@@ -316,8 +405,9 @@ status_t
         ret = 0;
         done2 = FALSE;
         while (!done2) {
-            read_fd_set = active_fd_set;
+            /* may kill sessions and clear them in active_fd_set */
             agt_ses_fill_writeset(&write_fd_set, &maxwrnum);
+            read_fd_set = active_fd_set;
             timeout.tv_sec = AGT_NCXSERVER_TIMEOUT;
             timeout.tv_usec = 0;
 
@@ -512,6 +602,7 @@ ses_accept_defered_input:
     /* all open client sockets will be closed as the sessions are
      * torn down, but the original ncxserver socket needs to be closed now
      */
+    ses_msg_set_outq_wait_fn(NULL);
     close(ncxsock);
     unlink(NCXSERVER_SOCKNAME);
     return NO_ERR;
@@ -196,6 +196,9 @@ static void
     if (sub->stopTime) {
         m__free(sub->stopTime);
     }
+    if (sub->cfilter) {
+        agt_tree_free_filter(sub->cfilter);
+    }
     if (sub->filterval) {
         val_free_value(sub->filterval);
     }
@@ -275,6 +278,13 @@ static agt_not_subscription_t *
     sub->filtertyp = filtertype;
     sub->filterval = filterval;
     sub->selectval = selectval;
+
+    /* compile a subtree filter once for all the notifications;
+     * it is used uncompiled if this fails
+     */
+    if (filtertype == OP_FILTER_SUBTREE && filterval) {
+        sub->cfilter = agt_tree_compile_filter(filterval);
+    }
     if (futurestop) {
         sub->flags = AGT_NOT_FL_FUTURESTOP;
     }
@@ -889,6 +899,7 @@ static status_t
                 agt_tree_test_filter(&msghdr,
                                      sub->scb,
                                      sub->filterval,
+                                     sub->cfilter,
                                      notif->event->parent);
             break;
         case OP_FILTER_XPATH:
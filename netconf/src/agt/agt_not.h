@@ -52,6 +52,10 @@ date             init     comment
 #include "status.h"
 #endif
 
+#ifndef _H_agt_tree
+#include "agt_tree.h"
+#endif
+
 #ifndef _H_tstamp
 #include "tstamp.h"
 #endif
@@ -150,6 +154,7 @@ typedef struct agt_not_subscription_t_ {
     agt_not_stream_t      streamid;
     op_filtertyp_t        filtertyp;
     val_value_t          *filterval;
+    agt_tree_filnode_t   *cfilter;          /* compiled filterval */
     val_value_t          *selectval;
     xmlChar               createTime[TSTAMP_MIN_SIZE];
     xmlChar              *startTime;       /* converted to UTC */
@@ -81,7 +81,21 @@ date         init     comment
 *                           T Y P E S                               *
 *                                                                   *
 *********************************************************************/
-    
+
+/* state of an <rpc> request between the parse, validate
+ * and invoke phases; kept across calls for a request that
+ * is parsed while the previous request is committed
+ */
+struct agt_rpc_job_t_ {
+    rpc_msg_t        *msg;
+    agt_rpc_cbset_t  *cbset;
+    xml_node_t        method;
+    status_t          res;
+    boolean           replyonly;    /* error found; only send reply */
+    boolean           validated;    /* VALIDATE phase done */
+    cfg_template_t   *target;       /* validated edit target */
+};
+
 
 /********************************************************************
 *                                                                   *
@@ -1258,21 +1272,34 @@ void
 } /* agt_rpc_unregister_method */
 
 
+
 /********************************************************************
-* FUNCTION agt_rpc_dispatch
+* FUNCTION begin_rpc
 *
-* Dispatch an incoming <rpc> request
-* called by top.c: 
-* This function is registered with top_register_node
-* for the module 'yuma-netconf', top-node 'rpc'
+* Start an incoming <rpc> request: check the <rpc> element,
+* find the RPC method and parse the input parameters
 *
 * INPUTS:
 *   scb == session control block
 *   top == top element descriptor
+*   job == request state to fill in
+*   pipelined == TRUE if the request is parsed while the
+*                previous request of the session is in progress;
+*                no reply is sent and the session state is not
+*                checked or changed
+*
+* OUTPUTS:
+*   *job is filled in
+*
+* RETURNS:
+*   TRUE if the request needs to be finished with finish_rpc
+*   FALSE if the request is done or the session is dropped
 *********************************************************************/
-void 
-    agt_rpc_dispatch (ses_cb_t *scb,
-                      xml_node_t *top)
+static boolean
+    begin_rpc (ses_cb_t *scb,
+               xml_node_t *top,
+               agt_rpc_job_t *job,
+               boolean pipelined)
 {
     rpc_msg_t             *msg;
     obj_template_t        *rpcobj;
@@ -1282,19 +1309,12 @@ void
     ses_total_stats_t     *agttotals;
     xmlChar               *buff;
     char                  *errstr;
-    xml_node_t             method, testnode;
+    xml_node_t             testnode;
     status_t               res, res2;
     boolean                errdone;
     xmlChar                tstampbuff[TSTAMP_MIN_SIZE];
     xml_attr_t             *attr;
 
-#ifdef DEBUG
-    if (!scb || !top) {
-        SET_ERROR(ERR_INTERNAL_PTR);
-        return;
-    }
-#endif
-
     /* init local vars */
     res = NO_ERR;
     res2 = NO_ERR;
@@ -1302,10 +1322,14 @@ void
     rpcobj = NULL;
     buff = NULL;
 
+    memset(job, 0x0, sizeof(agt_rpc_job_t));
+    xml_init_node(&job->method);
+
     agttotals = ses_get_total_stats();
 
     /* make sure any real session has been properly established */
-    if (scb->type != SES_TYP_DUMMY && scb->state != SES_ST_IDLE) {
+    if (!pipelined &&
+        scb->type != SES_TYP_DUMMY && scb->state != SES_ST_IDLE) {
         res = ERR_NCX_ACCESS_DENIED;
         if (LOGINFO) {
             log_info("\nagt_rpc dropping session %d (%d) %s",
@@ -1317,7 +1341,7 @@ void
         agttotals->droppedSessions++;
         agt_ses_request_close(scb, scb->sid, SES_TR_DROPPED);
 
-        return;
+        return FALSE;
     }
 
     /* the current node is 'rpc' in the netconf namespace
@@ -1334,7 +1358,7 @@ void
                      get_error_string(res));
         }
         agt_ses_request_close(scb, scb->sid, SES_TR_DROPPED);
-        return;
+        return FALSE;
     }
 
     /* make sure 'rpc' is the right kind of node */
@@ -1351,9 +1375,11 @@ void
         }
         agt_ses_request_close(scb, scb->sid, SES_TR_OTHER);
         free_msg(msg);
-        return;
+        return FALSE;
     }
 
+    job->msg = msg;
+
 
     /* setup the struct as an incoming RPC message
      * borrow the top->attrs queue without copying it 
@@ -1418,15 +1444,19 @@ void
 
     /* check any errors in the <rpc> node */
     if (res != NO_ERR || res2 != NO_ERR) {
+        if (pipelined) {
+            job->res = (res != NO_ERR) ? res : res2;
+            job->replyonly = TRUE;
+            return TRUE;
+        }
         send_rpc_reply(scb, msg);
         agt_acm_clear_msg_cache(&msg->mhdr);
         free_msg(msg);
-        return;
+        return FALSE;
     }
     
     /* get the next XML node, which is the RPC method name */
-    xml_init_node(&method);
-    res = agt_xml_consume_node(scb, &method, NCX_LAYER_RPC, &msg->mhdr);
+    res = agt_xml_consume_node(scb, &job->method, NCX_LAYER_RPC, &msg->mhdr);
     if (res != NO_ERR) {
         errdone = TRUE;
     } else {
@@ -1444,24 +1474,24 @@ void
                 msgid = NCX_EL_NONE;
             }
             log_debug("\nagt_rpc: <%s> for %u=%s@%s (m:%s) [%s]", 
-                      method.elname,
+                      job->method.elname,
                       scb->sid,
                       scb->username ? scb->username : NCX_EL_NONE,
                       scb->peeraddr ? scb->peeraddr : NCX_EL_NONE,
                       msgid,
                       tstampbuff);
             if (LOGDEBUG2) {
-                xml_dump_node(&method);
+                xml_dump_node(&job->method);
             }
         }
 
         /* check the node type which should be type start or simple */
-        if (!(method.nodetyp==XML_NT_START || 
-              method.nodetyp==XML_NT_EMPTY)) {
+        if (!(job->method.nodetyp==XML_NT_START || 
+              job->method.nodetyp==XML_NT_EMPTY)) {
             res = ERR_NCX_WRONG_NODETYP;
         } else {
             /* look for the RPC method in the definition registry */
-            rpcobj = find_rpc(method.module, method.elname);
+            rpcobj = find_rpc(job->method.module, job->method.elname);
             msg->rpc_method = rpcobj;
             rpc = (rpcobj) ? rpcobj->def.rpc : NULL;
             if (!rpc) {
@@ -1486,12 +1516,12 @@ void
     if (res != NO_ERR && !errdone) {
         if (res != ERR_NCX_ACCESS_DENIED) {
             /* construct an error-path string */
-            buff = m__getMem(xml_strlen(method.qname) 
+            buff = m__getMem(xml_strlen(job->method.qname) 
                              + xml_strlen(RPC_ROOT) + 2);
             if (buff) {
                 xml_strcpy(buff, RPC_ROOT);
                 xml_strcat(buff, (const xmlChar *)"/");
-                xml_strcat(buff, method.qname);
+                xml_strcat(buff, job->method.qname);
             }
         }
 
@@ -1503,7 +1533,7 @@ void
                          &msg->mhdr, 
                          NCX_LAYER_RPC, 
                          res, 
-                         &method, 
+                         &job->method, 
                          NCX_NT_NONE, 
                          NULL, 
                          (buff) ? NCX_NT_STRING : NCX_NT_NONE, 
@@ -1511,19 +1541,27 @@ void
         if (buff) {
             m__free(buff);
         }
+        if (pipelined) {
+            job->res = res;
+            job->replyonly = TRUE;
+            return TRUE;
+        }
         send_rpc_reply(scb, msg);
         agt_acm_clear_msg_cache(&msg->mhdr);
         free_msg(msg);
-        xml_clean_node(&method);
-        return;
+        xml_clean_node(&job->method);
+        return FALSE;
     }
 
     /* change the session state */
-    scb->state = SES_ST_IN_MSG;
+    if (!pipelined) {
+        scb->state = SES_ST_IN_MSG;
+    }
+    job->cbset = cbset;
 
     /* parameter set parse state */
     if (res == NO_ERR) {
-        res = parse_rpc_input(scb, msg, rpcobj, &method);
+        res = parse_rpc_input(scb, msg, rpcobj, &job->method);
     }
 
     /* read in a node which should be the endnode to match 'top' */
@@ -1559,7 +1597,7 @@ void
                                  &msg->mhdr, 
                                  NCX_LAYER_RPC, 
                                  res, 
-                                 &method, 
+                                 &job->method, 
                                  NCX_NT_NONE, 
                                  NULL, 
                                  (errstr) ? NCX_NT_STRING : NCX_NT_NONE,
@@ -1583,6 +1621,35 @@ void
         }
     }
 
+    job->res = res;
+    return TRUE;
+
+} /* begin_rpc */
+
+
+/********************************************************************
+* FUNCTION validate_rpc
+*
+* Call the VALIDATE phase callback of a request started
+* with begin_rpc
+*
+* INPUTS:
+*   scb == session control block
+*   job == request in progress
+*
+* OUTPUTS:
+*   job->res is updated
+*********************************************************************/
+static void
+    validate_rpc (ses_cb_t *scb,
+                  agt_rpc_job_t *job)
+{
+    rpc_msg_t        *msg = job->msg;
+    agt_rpc_cbset_t  *cbset = job->cbset;
+    status_t          res = job->res;
+
+    job->validated = TRUE;
+
     /* validate state */
     if ((res==NO_ERR) && (cbset && cbset->acb[AGT_RPC_PH_VALIDATE])) {
         /* input passes the basic YANG schema tests at this point;
@@ -1593,7 +1660,7 @@ void
          * validataion in this VALIDATE callback, as needed
          */
         msg->rpc_agt_state = AGT_RPC_PH_VALIDATE;
-        res = (*cbset->acb[AGT_RPC_PH_VALIDATE])(scb, msg, &method);
+        res = (*cbset->acb[AGT_RPC_PH_VALIDATE])(scb, msg, &job->method);
         if (res != NO_ERR) {
             /* make sure there is an error recorded in case
              * the validate phase callback did not add one
@@ -1603,7 +1670,7 @@ void
                                  &msg->mhdr, 
                                  NCX_LAYER_RPC, 
                                  res, 
-                                 &method, 
+                                 &job->method, 
                                  NCX_NT_NONE, 
                                  NULL, 
                                  NCX_NT_OBJ, 
@@ -1612,13 +1679,44 @@ void
         }
     }
 
+    job->res = res;
+
+} /* validate_rpc */
+
+
+/********************************************************************
+* FUNCTION finish_rpc
+*
+* Invoke a request started with begin_rpc, send the reply
+* and free the request
+*
+* INPUTS:
+*   scb == session control block
+*   job == request in progress
+*********************************************************************/
+static void
+    finish_rpc (ses_cb_t *scb,
+                agt_rpc_job_t *job)
+{
+    rpc_msg_t        *msg = job->msg;
+    agt_rpc_cbset_t  *cbset = job->cbset;
+    status_t          res = job->res;
+
+    if (job->replyonly) {
+        send_rpc_reply(scb, msg);
+        agt_acm_clear_msg_cache(&msg->mhdr);
+        free_msg(msg);
+        xml_clean_node(&job->method);
+        return;
+    }
+
     /* there does not always have to be an invoke callback,
      * especially since the return of data can be automated
      * in the send_rpc_reply phase. 
      */
     if ((res==NO_ERR) && cbset && cbset->acb[AGT_RPC_PH_INVOKE]) {
         msg->rpc_agt_state = AGT_RPC_PH_INVOKE;
-        res = (*cbset->acb[AGT_RPC_PH_INVOKE])(scb, msg, &method);
+        res = (*cbset->acb[AGT_RPC_PH_INVOKE])(scb, msg, &job->method);
         if (res != NO_ERR) {
             /* make sure there is an error recorded in case
              * the invoke phase callback did not add one
@@ -1628,7 +1726,7 @@ void
                                  &msg->mhdr, 
                                  NCX_LAYER_RPC, 
                                  res, 
-                                 &method, 
+                                 &job->method, 
                                  NCX_NT_NONE, 
                                  NULL, 
                                  NCX_NT_OBJ, 
@@ -1655,7 +1753,7 @@ void
      */
     if (cbset && cbset->acb[AGT_RPC_PH_POST_REPLY]) {
         msg->rpc_agt_state = AGT_RPC_PH_POST_REPLY;
-        (void)(*cbset->acb[AGT_RPC_PH_POST_REPLY])(scb, msg, &method);
+        (void)(*cbset->acb[AGT_RPC_PH_POST_REPLY])(scb, msg, &job->method);
     }
 
     /* check if there is any auditQ because changes to 
@@ -1673,16 +1771,232 @@ void
     }
 
     /* cleanup and exit */
-    xml_clean_node(&method);
+    xml_clean_node(&job->method);
     agt_acm_clear_msg_cache(&msg->mhdr);
     free_msg(msg);
 
     print_errors();
     clear_errors();
 
+} /* finish_rpc */
+
+
+/********************************************************************
+* FUNCTION abort_rpc
+*
+* Replace the result of a pipelined request that was validated
+* against the changes of the previous request, which failed
+*
+* INPUTS:
+*   scb == session control block
+*   job == request in progress
+*********************************************************************/
+static void
+    abort_rpc (ses_cb_t *scb,
+               agt_rpc_job_t *job)
+{
+    rpc_msg_t  *msg = job->msg;
+
+    if (LOGINFO) {
+        log_info("\nagt_rpc: aborting pipelined <%s> for session %u; "
+                 "previous request failed",
+                 obj_get_name(msg->rpc_method),
+                 scb->sid);
+    }
+
+    /* the errors found against the rolled back changes do not apply */
+    rpc_err_clean_errQ(&msg->mhdr.errQ);
+
+    job->res = ERR_NCX_OPERATION_FAILED;
+    agt_record_error(scb, 
+                     &msg->mhdr, 
+                     NCX_LAYER_OPERATION, 
+                     job->res, 
+                     &job->method, 
+                     NCX_NT_NONE, 
+                     NULL, 
+                     NCX_NT_OBJ, 
+                     msg->rpc_method);
+
+} /* abort_rpc */
+
+
+/********************************************************************
+* FUNCTION agt_rpc_dispatch
+*
+* Dispatch an incoming <rpc> request
+* called by top.c: 
+* This function is registered with top_register_node
+* for the module 'yuma-netconf', top-node 'rpc'
+*
+* INPUTS:
+*   scb == session control block
+*   top == top element descriptor
+*********************************************************************/
+void 
+    agt_rpc_dispatch (ses_cb_t *scb,
+                      xml_node_t *top)
+{
+    agt_rpc_job_t  job;
+
+#ifdef DEBUG
+    if (!scb || !top) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    if (!begin_rpc(scb, top, &job, FALSE)) {
+        return;
+    }
+    validate_rpc(scb, &job);
+    finish_rpc(scb, &job);
+
 } /* agt_rpc_dispatch */
 
 
+/********************************************************************
+* FUNCTION agt_rpc_begin_pipelined
+*
+* Parse an incoming <rpc> request while the previous request
+* of the session is committed
+* An <edit-config> request is also validated against the
+* changes of the previous request; other requests are
+* validated when they are finished
+* No reply is sent until agt_rpc_finish_pipelined is called
+*
+* INPUTS:
+*   scb == session control block
+*   top == top element descriptor; must be kept by the
+*          caller until the request is finished
+*
+* RETURNS:
+*   malloced request state to finish or free later
+*   NULL if there is nothing to finish
+*********************************************************************/
+agt_rpc_job_t *
+    agt_rpc_begin_pipelined (ses_cb_t *scb,
+                             xml_node_t *top)
+{
+    agt_rpc_job_t   *job;
+    obj_template_t  *rpcobj;
+
+#ifdef DEBUG
+    if (!scb || !top) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return NULL;
+    }
+#endif
+
+    job = m__getObj(agt_rpc_job_t);
+    if (job == NULL) {
+        return NULL;
+    }
+
+    if (!begin_rpc(scb, top, job, TRUE)) {
+        m__free(job);
+        return NULL;
+    }
+
+    rpcobj = job->msg->rpc_method;
+    if (job->res == NO_ERR && !job->replyonly &&
+        !xml_strcmp(obj_get_mod_name(rpcobj), NC_MODULE) &&
+        !xml_strcmp(obj_get_name(rpcobj), NCX_EL_EDIT_CONFIG)) {
+        validate_rpc(scb, job);
+        if (job->res == NO_ERR) {
+            (void)agt_get_cfg_from_parm(NCX_EL_TARGET, job->msg,
+                                        &job->method, &job->target);
+        }
+    }
+    return job;
+
+} /* agt_rpc_begin_pipelined */
+
+
+/********************************************************************
+* FUNCTION agt_rpc_finish_pipelined
+*
+* Finish a request started with agt_rpc_begin_pipelined,
+* send the reply and free the request state
+*
+* INPUTS:
+*   scb == session control block
+*   job == request state to finish; freed by this function
+*   abortcfg == config whose changes by the previous request
+*               were rolled back, or NULL; a request that was
+*               validated against them fails with an
+*               operation-failed error
+*********************************************************************/
+void
+    agt_rpc_finish_pipelined (ses_cb_t *scb,
+                              agt_rpc_job_t *job,
+                              const cfg_template_t *abortcfg)
+{
+#ifdef DEBUG
+    if (!scb || !job) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    if (!job->replyonly) {
+        if (scb->state == SES_ST_IDLE) {
+            scb->state = SES_ST_IN_MSG;
+        }
+        if (!job->validated) {
+            validate_rpc(scb, job);
+        } else if (abortcfg != NULL &&
+                   (job->target == NULL || job->target == abortcfg)) {
+            /* the target is not known if the validation failed */
+            abort_rpc(scb, job);
+        }
+    }
+    finish_rpc(scb, job);
+    m__free(job);
+
+} /* agt_rpc_finish_pipelined */
+
+
+/********************************************************************
+* FUNCTION agt_rpc_free_pipelined
+*
+* Free a request started with agt_rpc_begin_pipelined
+* without sending a reply, if the session is closed
+*
+* INPUTS:
+*   scb == session control block
+*   job == request state to free
+*********************************************************************/
+void
+    agt_rpc_free_pipelined (ses_cb_t *scb,
+                            agt_rpc_job_t *job)
+{
+    rpc_msg_t  *msg;
+
+#ifdef DEBUG
+    if (!scb || !job) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    msg = job->msg;
+
+    /* let the method free the state kept since the validate phase */
+    if (job->cbset && job->cbset->acb[AGT_RPC_PH_POST_REPLY]) {
+        msg->rpc_agt_state = AGT_RPC_PH_POST_REPLY;
+        (void)(*job->cbset->acb[AGT_RPC_PH_POST_REPLY])(scb, msg,
+                                                         &job->method);
+    }
+
+    xml_clean_node(&job->method);
+    agt_acm_clear_msg_cache(&msg->mhdr);
+    free_msg(msg);
+    m__free(job);
+
+} /* agt_rpc_free_pipelined */
+
+
 /********************************************************************
 * FUNCTION agt_rpc_load_config_file
 *
@@ -112,6 +112,12 @@ typedef struct agt_rpc_cbset_t_ {
 } agt_rpc_cbset_t;
 
 
+/* <rpc> request parsed while the previous request of
+ * the session is committed; see agt_rpc_begin_pipelined
+ */
+typedef struct agt_rpc_job_t_ agt_rpc_job_t;
+
+
 
 /* Callback template for RPCs that use an inline callback
  * function instead of generating a malloced val_value_t tree
@@ -249,6 +255,65 @@ extern void
     agt_rpc_dispatch (ses_cb_t  *scb,
 		      xml_node_t *top);
 
+
+/********************************************************************
+* FUNCTION agt_rpc_begin_pipelined
+*
+* Parse an incoming <rpc> request while the previous request
+* of the session is committed
+* An <edit-config> request is also validated against the
+* changes of the previous request; other requests are
+* validated when they are finished
+* No reply is sent until agt_rpc_finish_pipelined is called
+*
+* INPUTS:
+*   scb == session control block
+*   top == top element descriptor; must be kept by the
+*          caller until the request is finished
+*
+* RETURNS:
+*   malloced request state to finish or free later
+*   NULL if there is nothing to finish
+*********************************************************************/
+extern agt_rpc_job_t *
+    agt_rpc_begin_pipelined (ses_cb_t *scb,
+			     xml_node_t *top);
+
+
+/********************************************************************
+* FUNCTION agt_rpc_finish_pipelined
+*
+* Finish a request started with agt_rpc_begin_pipelined,
+* send the reply and free the request state
+*
+* INPUTS:
+*   scb == session control block
+*   job == request state to finish; freed by this function
+*   abortcfg == config whose changes by the previous request
+*               were rolled back, or NULL; a request that was
+*               validated against them fails with an
+*               operation-failed error
+*********************************************************************/
+extern void
+    agt_rpc_finish_pipelined (ses_cb_t *scb,
+			      agt_rpc_job_t *job,
+			      const cfg_template_t *abortcfg);
+
+
+/********************************************************************
+* FUNCTION agt_rpc_free_pipelined
+*
+* Free a request started with agt_rpc_begin_pipelined
+* without sending a reply, if the session is closed
+*
+* INPUTS:
+*   scb == session control block
+*   job == request state to free
+*********************************************************************/
+extern void
+    agt_rpc_free_pipelined (ses_cb_t *scb,
+			    agt_rpc_job_t *job);
+
 /********************************************************************
 * FUNCTION agt_rpc_load_config_file
 *
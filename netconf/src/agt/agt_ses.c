@@ -620,7 +620,7 @@ ses_cb_t *
             scb->state = SES_ST_INIT;
             scb->fd = fd;
             scb->instate = SES_INST_IDLE;
-            scb->stream_output = TRUE;
+            scb->stream_output = agt_profile->agt_stream_output;
             res = ses_msg_new_buff(scb, TRUE, &scb->outbuff);
         } else {
             res = ERR_INTERNAL_MEM;
@@ -689,6 +689,9 @@ void
 
     slot = scb->sid;
 
+    /* free the next message if it was already parsed */
+    agt_top_cancel_pipelined(scb);
+
     if (scb->fd) {
         def_reg_del_scb(scb->fd);
     }
@@ -698,6 +701,15 @@ void
     agt_state_remove_session(slot);
     agt_not_remove_subscription(slot);
 
+    if (LOGDEBUG) {
+        log_debug("\nSession %d input: %u bytes in %u messages "
+                  "(%u base:1.1 chunks)",
+                  slot,
+                  scb->stats.in_bytes,
+                  scb->stats.in_msgs,
+                  scb->stats.in_chunks);
+    }
+
     /* add this session to ses stats */
     agttotals->active_sessions--;
     if (scb->active) {
@@ -954,6 +966,30 @@ boolean
         dlq_remove(msg);
         ses_msg_free_msg(scb, msg);
 
+        /* finish the next message now if it was parsed while this
+         * one was committed, before a message from another session
+         * can change the configuration it was validated with
+         */
+        if (agt_top_pipelined(scb)) {
+            msg = (ses_msg_t *)dlq_firstEntry(&scb->msgQ);
+            if (scb->state >= SES_ST_SHUTDOWN_REQ) {
+                agt_top_cancel_pipelined(scb);
+            } else {
+                uint32 vtimeout_copy = ncx_get_vtimeout_value();
+                ncx123_set_vtimeout_value(scb->cache_timeout);
+
+                agt_top_finish_pipelined(&scb);
+
+                ncx123_set_vtimeout_value(vtimeout_copy);
+                if (scb) {
+                    dlq_remove(msg);
+                    ses_msg_free_msg(scb, msg);
+                }
+            }
+        }
+    }
+
+    if (scb) {
         /* check if any messages left for this session */
         msg = (ses_msg_t *)dlq_firstEntry(&scb->msgQ);
         if (msg && msg->ready) {
@@ -1114,6 +1150,9 @@ boolean
 *
 * Drain the ses_msg outreadyQ and set the specified fdset
 * Used by agt_ncxserver write_fd_set
+* Sessions with output left stay in the outreadyQ until
+* their socket is writable; sessions whose output failed
+* while a reply was written are killed
 *
 * INPUTS:
 *    fdset == pointer to fd_set to fill
@@ -1129,9 +1168,11 @@ void
 {
     ses_ready_t *rdy;
     ses_cb_t *scb;
+    dlq_hdr_t waitQ;
     boolean done;
 
     FD_ZERO(fdset);
+    dlq_createSQue(&waitQ);
     done = FALSE;
     while (!done) {
         rdy = ses_msg_get_first_outready();
@@ -1139,15 +1180,29 @@ void
             done = TRUE;
         } else {
             scb = agtses[rdy->sid];
-            if (scb && scb->state <= SES_ST_SHUTDOWN_REQ) {
+            if (scb && scb->outq_dropped && dlq_empty(&scb->outQ)) {
+                /* the output failed; the rest of it was dropped */
+                agt_ses_kill_session(scb,
+                                     scb->killedbysid,
+                                     scb->termreason);
+            } else if (scb && scb->state <= SES_ST_SHUTDOWN_REQ) {
                 FD_SET(scb->fd, fdset);
                 if (scb->fd > *maxfdnum) {
                     *maxfdnum = scb->fd;
                 }
+                if (!dlq_empty(&scb->outQ)) {
+                    /* the select may return before it is writable */
+                    dlq_enque(rdy, &waitQ);
+                }
             }
         }
     }
 
+    while (!dlq_empty(&waitQ)) {
+        rdy = (ses_ready_t *)dlq_deque(&waitQ);
+        ses_msg_make_outready(agtses[rdy->sid]);
+    }
+
 }  /* agt_ses_fill_writeset */
 
 /********************************************************************
@@ -1513,6 +1568,7 @@ status_t
 * FUNCTION agt_ses_invalidate_session_acm_caches
 *
 * Invalidate all session ACM caches so they will be rebuilt
+* The shared user-to-groups map is cleared as well
 * TBD:: optimize and figure out exactly what needs to change
 *
 *********************************************************************/
@@ -1524,6 +1580,8 @@ void
 
     agt_profile = agt_get_profile();
 
+    agt_acm_invalidate_usergroups_cache();
+
     for (i=0; i<agt_profile->agt_max_sessions; i++) {
         if (agtses[i] != NULL) {
             agt_acm_invalidate_session_cache(agtses[i]);
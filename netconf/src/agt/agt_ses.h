@@ -497,6 +497,7 @@ extern status_t
 * FUNCTION agt_ses_invalidate_session_acm_caches
 *
 * Invalidate all session ACM caches so they will be rebuilt
+* The shared user-to-groups map is cleared as well
 * TBD:: optimize and figure out exactly what needs to change
 *
 *********************************************************************/
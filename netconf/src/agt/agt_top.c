@@ -43,6 +43,7 @@ date         init     comment
 
 #include "procdefs.h"
 #include "agt.h"
+#include "agt_rpc.h"
 #include "agt_ses.h"
 #include "agt_top.h"
 #include "agt_xml.h"
@@ -69,57 +70,62 @@ date         init     comment
 *                                                                   *
 *********************************************************************/
 
+/* next message of a session parsed while the current
+ * message of the session is committed
+ */
+typedef struct pipeline_t_ {
+    ses_cb_t          *scb;
+    ses_msg_t         *sesmsg;        /* message that was parsed */
+    xmlTextReaderPtr   reader;        /* reader for sesmsg */
+    xml_node_t         top;
+    status_t           res;           /* status of the top node */
+    boolean            isrpc;         /* top node is <rpc> */
+    agt_rpc_job_t     *job;           /* parsed <rpc> request */
+    const cfg_template_t *abortcfg;   /* config rolled back */
+} pipeline_t;
+
+
 /********************************************************************
 *                                                                   *
 *                       V A R I A B L E S                            *
 *                                                                   *
 *********************************************************************/
 
-
-/**************    E X T E R N A L   F U N C T I O N S **********/
+/* only one message is committed at a time */
+static pipeline_t  *pipeline;
 
 
 /********************************************************************
-* FUNCTION agt_top_dispatch_msg
+* FUNCTION dispatch_top
 * 
-* Find the appropriate top node handler and call it
-* called by the transport manager (through the session manager)
-* when a new message is detected
+* Call the handler for the top node of a message
 *
 * INPUTS:
-*   scb == session control block containing the xmlreader
-*          set at the start of an incoming message.
+*   ppscb == address of session control block; set to NULL
+*            if the session is freed
+*   top == top node of the message
+*   res == status of reading the top node
+*   job == <rpc> request parsed with agt_rpc_begin_pipelined
+*          to finish instead of calling the handler; NULL if none
+*   abortcfg == config rolled back since the job was parsed;
+*               NULL if none
 *
-* RETURNS:
-*  none
 *********************************************************************/
-void
-    agt_top_dispatch_msg (ses_cb_t **ppscb)
+static void
+    dispatch_top (ses_cb_t **ppscb,
+                  xml_node_t *top,
+                  status_t res,
+                  agt_rpc_job_t *job,
+                  const cfg_template_t *abortcfg)
 {
     ses_total_stats_t  *myagttotals;
     agt_profile_t      *profile;
-    xml_node_t          top;
-    status_t            res;
     top_handler_t       handler;
     ses_cb_t           *scb = *ppscb;
-    
-#ifdef DEBUG
-    if (!scb) {
-        SET_ERROR(ERR_INTERNAL_PTR);
-        return;
-    }
-#endif
 
     myagttotals = ses_get_total_stats();
     profile = agt_get_profile();
 
-    xml_init_node(&top);
-
-    /* get the first node */
-    res = agt_xml_consume_node(scb, 
-                               &top, 
-                               NCX_LAYER_TRANSPORT, 
-                               NULL);
     if (res != NO_ERR) {
         scb->stats.inBadRpcs++;
         myagttotals->stats.inBadRpcs++;
@@ -131,7 +137,6 @@ void
                      get_error_string(res));
         }
 
-        xml_clean_node(&top);
         agt_ses_free_session(scb);
 
         /* set the supplied ptr to ptr to scb to NULL so that the 
@@ -142,16 +147,18 @@ void
 
     log_debug3("\nagt_top: got node");
     if (LOGDEBUG4 && scb->state != SES_ST_INIT) {
-        xml_dump_node(&top);
+        xml_dump_node(top);
     }
 
     /* check node type and if handler exists, then call it */
-    if (top.nodetyp==XML_NT_START || top.nodetyp==XML_NT_EMPTY) {
+    if (top->nodetyp==XML_NT_START || top->nodetyp==XML_NT_EMPTY) {
         /* find the owner, elname tuple in the topQ */
-        handler = top_find_handler(top.module, top.elname);
-        if (handler) {
+        handler = top_find_handler(top->module, top->elname);
+        if (job) {
+            agt_rpc_finish_pipelined(scb, job, abortcfg);
+        } else if (handler) {
             /* call the handler */
-            (*handler)(scb, &top);
+            (*handler)(scb, top);
         } else {
             res = ERR_NCX_DEF_NOT_FOUND;
         }
@@ -188,9 +195,260 @@ void
         *ppscb=NULL;
     }
 
+} /* dispatch_top */
+
+
+/**************    E X T E R N A L   F U N C T I O N S **********/
+
+
+/********************************************************************
+* FUNCTION agt_top_dispatch_msg
+* 
+* Find the appropriate top node handler and call it
+* called by the transport manager (through the session manager)
+* when a new message is detected
+*
+* INPUTS:
+*   scb == session control block containing the xmlreader
+*          set at the start of an incoming message.
+*
+* RETURNS:
+*  none
+*********************************************************************/
+void
+    agt_top_dispatch_msg (ses_cb_t **ppscb)
+{
+    xml_node_t          top;
+    status_t            res;
+    ses_cb_t           *scb = *ppscb;
+    
+#ifdef DEBUG
+    if (!scb) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    xml_init_node(&top);
+
+    /* get the first node */
+    res = agt_xml_consume_node(scb, 
+                               &top, 
+                               NCX_LAYER_TRANSPORT, 
+                               NULL);
+
+    dispatch_top(ppscb, &top, res, NULL, NULL);
+
     xml_clean_node(&top);
 
 } /* agt_top_dispatch_msg */
 
 
+/********************************************************************
+* FUNCTION agt_top_pipeline_msg
+* 
+* Parse the next message of a session while the current
+* message is committed, if the pipeline-edits parameter
+* is set and the whole next message has been received
+* See agt_rpc_begin_pipelined for the phases that are done
+*
+* INPUTS:
+*   scb == session control block of the message committed
+*
+* RETURNS:
+*   TRUE if the next message was parsed
+*********************************************************************/
+boolean
+    agt_top_pipeline_msg (ses_cb_t *scb)
+{
+    agt_profile_t      *profile;
+    ses_msg_t          *curmsg, *nextmsg;
+    xmlTextReaderPtr    reader, savereader;
+    top_handler_t       handler;
+    status_t            res;
+
+    profile = agt_get_profile();
+    if (!profile->agt_pipeline_edits || pipeline != NULL ||
+        scb == NULL || scb->type != SES_TYP_NETCONF ||
+        scb->state != SES_ST_IN_MSG) {
+        return FALSE;
+    }
+
+    curmsg = (ses_msg_t *)dlq_firstEntry(&scb->msgQ);
+    nextmsg = (curmsg) ? (ses_msg_t *)dlq_nextEntry(curmsg) : NULL;
+    if (nextmsg == NULL || !nextmsg->ready) {
+        return FALSE;
+    }
+
+    pipeline = m__getObj(pipeline_t);
+    if (pipeline == NULL) {
+        return FALSE;
+    }
+    memset(pipeline, 0x0, sizeof(pipeline_t));
+
+    reader = NULL;
+    res = xml_get_reader_for_session(ses_read_cb, NULL, scb, &reader);
+    if (res != NO_ERR) {
+        m__free(pipeline);
+        pipeline = NULL;
+        return FALSE;
+    }
+
+    /* the session reader reads the first message in the msgQ */
+    dlq_remove(curmsg);
+    savereader = scb->reader;
+    scb->reader = reader;
+
+    pipeline->scb = scb;
+    pipeline->sesmsg = nextmsg;
+    pipeline->reader = reader;
+    xml_init_node(&pipeline->top);
+
+    log_debug2("\nagt_top: parsing next msg for session %d", scb->sid);
+
+    pipeline->res = agt_xml_consume_node(scb, 
+                                         &pipeline->top, 
+                                         NCX_LAYER_TRANSPORT, 
+                                         NULL);
+    if (pipeline->res == NO_ERR &&
+        (pipeline->top.nodetyp == XML_NT_START ||
+         pipeline->top.nodetyp == XML_NT_EMPTY)) {
+        handler = top_find_handler(pipeline->top.module, 
+                                   pipeline->top.elname);
+        if (handler == agt_rpc_dispatch) {
+            pipeline->isrpc = TRUE;
+            pipeline->job = agt_rpc_begin_pipelined(scb, &pipeline->top);
+        }
+    }
+
+    scb->reader = savereader;
+    dlq_insertAhead(curmsg, nextmsg);
+
+    return TRUE;
+
+} /* agt_top_pipeline_msg */
+
+
+/********************************************************************
+* FUNCTION agt_top_abort_pipelined
+* 
+* Record that the changes of the current message of a
+* session were rolled back, so the next message parsed
+* with agt_top_pipeline_msg is aborted if it was
+* validated against the same config
+*
+* INPUTS:
+*   scb == session control block
+*   cfg == config that was rolled back
+*********************************************************************/
+void
+    agt_top_abort_pipelined (ses_cb_t *scb,
+                             const cfg_template_t *cfg)
+{
+    if (agt_top_pipelined(scb)) {
+        pipeline->abortcfg = cfg;
+    }
+
+} /* agt_top_abort_pipelined */
+
+
+/********************************************************************
+* FUNCTION agt_top_pipelined
+* 
+* Check if the next message of a session was parsed
+* with agt_top_pipeline_msg
+*
+* INPUTS:
+*   scb == session control block
+*
+* RETURNS:
+*   TRUE if agt_top_finish_pipelined needs to be called
+*********************************************************************/
+boolean
+    agt_top_pipelined (const ses_cb_t *scb)
+{
+    return pipeline != NULL && pipeline->scb == scb;
+
+} /* agt_top_pipelined */
+
+
+/********************************************************************
+* FUNCTION agt_top_finish_pipelined
+* 
+* Finish the message parsed with agt_top_pipeline_msg
+* It must be the first message in the session msgQ
+*
+* INPUTS:
+*   ppscb == address of session control block
+*
+* NOTES:
+*   This function might de-allocate the scb, if it does scb will be
+*   set to NULL
+*********************************************************************/
+void
+    agt_top_finish_pipelined (ses_cb_t **ppscb)
+{
+    pipeline_t  *done;
+    ses_cb_t    *scb = *ppscb;
+
+    if (!agt_top_pipelined(scb)) {
+        SET_ERROR(ERR_INTERNAL_VAL);
+        return;
+    }
+
+    /* the next message may be parsed again while this one
+     * is committed
+     */
+    done = pipeline;
+    pipeline = NULL;
+
+    /* keep reading the message with its own reader */
+    if (scb->reader) {
+        xml_free_reader(scb->reader);
+    }
+    scb->reader = done->reader;
+
+    log_debug2("\nagt_top: finishing parsed msg for session %d", scb->sid);
+
+    /* nothing is left to do for an <rpc> without a job;
+     * the session is dropped
+     */
+    if (!done->isrpc || done->job) {
+        dispatch_top(ppscb, &done->top, done->res, done->job, 
+                     done->abortcfg);
+    }
+
+    xml_clean_node(&done->top);
+    m__free(done);
+
+} /* agt_top_finish_pipelined */
+
+
+/********************************************************************
+* FUNCTION agt_top_cancel_pipelined
+* 
+* Free the message parsed with agt_top_pipeline_msg
+* without finishing it, if the session is freed
+*
+* INPUTS:
+*   scb == session control block
+*********************************************************************/
+void
+    agt_top_cancel_pipelined (ses_cb_t *scb)
+{
+    if (!agt_top_pipelined(scb)) {
+        return;
+    }
+
+    if (pipeline->job) {
+        agt_rpc_free_pipelined(scb, pipeline->job);
+    }
+    xml_clean_node(&pipeline->top);
+    xml_free_reader(pipeline->reader);
+    m__free(pipeline);
+    pipeline = NULL;
+
+} /* agt_top_cancel_pipelined */
+
+
 /* END file agt_top.c */
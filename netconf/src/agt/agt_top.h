@@ -34,6 +34,10 @@ date	     init     comment
 
 */
 
+#ifndef _H_cfg
+#include "cfg.h"
+#endif
+
 #ifndef _H_ses
 #include "ses.h"
 #endif
@@ -70,6 +74,87 @@ extern "C" {
 extern void
     agt_top_dispatch_msg (ses_cb_t  **scb);
 
+
+/********************************************************************
+* FUNCTION agt_top_pipeline_msg
+* 
+* Parse the next message of a session while the current
+* message is committed, if the pipeline-edits parameter
+* is set and the whole next message has been received
+* See agt_rpc_begin_pipelined for the phases that are done
+*
+* INPUTS:
+*   scb == session control block of the message committed
+*
+* RETURNS:
+*   TRUE if the next message was parsed
+*********************************************************************/
+extern boolean
+    agt_top_pipeline_msg (ses_cb_t *scb);
+
+
+/********************************************************************
+* FUNCTION agt_top_abort_pipelined
+* 
+* Record that the changes of the current message of a
+* session were rolled back, so the next message parsed
+* with agt_top_pipeline_msg is aborted if it was
+* validated against the same config
+*
+* INPUTS:
+*   scb == session control block
+*   cfg == config that was rolled back
+*********************************************************************/
+extern void
+    agt_top_abort_pipelined (ses_cb_t *scb,
+			     const cfg_template_t *cfg);
+
+
+/********************************************************************
+* FUNCTION agt_top_pipelined
+* 
+* Check if the next message of a session was parsed
+* with agt_top_pipeline_msg
+*
+* INPUTS:
+*   scb == session control block
+*
+* RETURNS:
+*   TRUE if agt_top_finish_pipelined needs to be called
+*********************************************************************/
+extern boolean
+    agt_top_pipelined (const ses_cb_t *scb);
+
+
+/********************************************************************
+* FUNCTION agt_top_finish_pipelined
+* 
+* Finish the message parsed with agt_top_pipeline_msg
+* It must be the first message in the session msgQ
+*
+* INPUTS:
+*   ppscb == address of session control block
+*
+* NOTES:
+*   This function might de-allocate the scb, if it does scb will be
+*   set to NULL
+*********************************************************************/
+extern void
+    agt_top_finish_pipelined (ses_cb_t **ppscb);
+
+
+/********************************************************************
+* FUNCTION agt_top_cancel_pipelined
+* 
+* Free the message parsed with agt_top_pipeline_msg
+* without finishing it, if the session is freed
+*
+* INPUTS:
+*   scb == session control block
+*********************************************************************/
+extern void
+    agt_top_cancel_pipelined (ses_cb_t *scb);
+
 #ifdef __cplusplus
 }  /* end extern 'C' */
 #endif
@@ -32,6 +32,14 @@
           optimize node removal and rendering later on.
 
           The filter val_value_t is no longer used after this is done.
+
+          The filter is compiled first into a tree of
+          agt_tree_filnode_t records.  List entries selected by
+          content match nodes for all the list keys are found by
+          comparing the key values instead of processing every entry.
+          If a sibling set selects more than one entry of a list
+          this way, the entries are sorted by key once and each
+          entry is found by a binary search.
  
        - If a filter node has any child nodes, they must
          all be TRUE, for the node itself to be TRUE.
@@ -115,6 +123,30 @@ date         init     comment
 *                                                                   *
 *********************************************************************/
 
+/* number of keyed filter nodes for the same list in one
+ * sibling set before the list entries are sorted by key
+ */
+#define KEYIDX_MIN_LOOKUPS   2
+
+
+/********************************************************************
+*                                                                   *
+*                            T Y P E S                              *
+*                                                                   *
+*********************************************************************/
+
+/* key index of the entries of one list within the target
+ * node compared to a filter sibling set
+ */
+typedef struct keyidx_t_ {
+    dlq_hdr_t          qhdr;
+    obj_template_t    *listobj;      /* back-ptr to indexed list */
+    uint32             lookups;      /* keyed filter nodes seen */
+    boolean            useidx;       /* entryA can be searched */
+    uint32             count;        /* number of entries */
+    val_value_t      **entryA;       /* entries sorted by key */
+} keyidx_t;
+
 
 /********************************************************************
 *                                                                   *
@@ -187,6 +219,495 @@ static ncx_filptr_t *
 } /* find_filptr */
 
 
+/********************************************************************
+* FUNCTION clean_filnode_keys
+*
+* clean the bound key values in a compiled filter node
+* 
+* INPUTS:
+*    filnode == compiled filter node to clean
+*********************************************************************/
+static void
+    clean_filnode_keys (agt_tree_filnode_t *filnode)
+{
+    val_value_t  *keyval;
+
+    while (!dlq_empty(&filnode->keyQ)) {
+        keyval = (val_value_t *)dlq_deque(&filnode->keyQ);
+        val_free_value(keyval);
+    }
+    filnode->listobj = NULL;
+    filnode->keymatch = FALSE;
+
+} /* clean_filnode_keys */
+
+
+/********************************************************************
+* FUNCTION new_filnode
+*
+* create a compiled filter node for a filter container node
+* and all its descendant container nodes
+* 
+* INPUTS:
+*    filval == filter container node to compile
+*
+* RETURNS:
+*    pointer to new agt_tree_filnode_t struct
+*    NULL if malloc error
+*********************************************************************/
+static agt_tree_filnode_t *
+    new_filnode (val_value_t *filval)
+{
+    agt_tree_filnode_t  *filnode, *chnode;
+    val_value_t         *filchild;
+
+    filnode = m__getObj(agt_tree_filnode_t);
+    if (!filnode) {
+        return NULL;
+    }
+    memset(filnode, 0x0, sizeof(agt_tree_filnode_t));
+    filnode->filval = filval;
+    dlq_createSQue(&filnode->childQ);
+    dlq_createSQue(&filnode->keyQ);
+
+    for (filchild = val_get_first_child(filval);
+         filchild != NULL;
+         filchild = val_get_next_child(filchild)) {
+
+        if (filchild->btyp != NCX_BT_CONTAINER) {
+            continue;
+        }
+
+        chnode = new_filnode(filchild);
+        if (!chnode) {
+            agt_tree_free_filter(filnode);
+            return NULL;
+        }
+        dlq_enque(chnode, &filnode->childQ);
+    }
+
+    return filnode;
+
+} /* new_filnode */
+
+
+/********************************************************************
+* FUNCTION bind_filnode
+*
+* bind a compiled filter node to the list template of
+* the target node instances it is compared against.
+* If there is a content match node for every key of the list
+* then the key values are converted for the key objects,
+* and the keymatch flag is set.
+*
+* Only key types compared by value the same way as
+* content_match_test are converted; the filter is processed
+* without key matching for any other key type
+* 
+* INPUTS:
+*    filnode == compiled filter node to bind
+*    listobj == object template of the target instances
+*    isnotif == TRUE if this is for a notification
+*
+* OUTPUTS:
+*    filnode->listobj, keymatch and keyQ are set
+*********************************************************************/
+static void
+    bind_filnode (agt_tree_filnode_t *filnode,
+                  obj_template_t *listobj,
+                  boolean isnotif)
+{
+    obj_key_t        *objkey;
+    obj_template_t   *keyobj;
+    val_value_t      *filchild, *cmval, *keyval;
+    xmlns_id_t        ncid, nsid;
+    status_t          res;
+
+    clean_filnode_keys(filnode);
+
+    if (listobj == NULL || listobj->objtype != OBJ_TYP_LIST) {
+        filnode->listobj = listobj;
+        return;
+    }
+
+    ncid = xmlns_nc_id();
+    res = NO_ERR;
+
+    for (objkey = obj_first_key(listobj);
+         objkey != NULL && res == NO_ERR;
+         objkey = obj_next_key(objkey)) {
+
+        keyobj = objkey->keyobj;
+        if (keyobj == NULL || obj_is_password(keyobj)) {
+            res = ERR_NCX_SKIPPED;
+            continue;
+        }
+
+        switch (obj_get_basetype(keyobj)) {
+        case NCX_BT_ENUM:
+        case NCX_BT_STRING:
+        case NCX_BT_INT8:
+        case NCX_BT_INT16:
+        case NCX_BT_INT32:
+        case NCX_BT_INT64:
+        case NCX_BT_UINT8:
+        case NCX_BT_UINT16:
+        case NCX_BT_UINT32:
+        case NCX_BT_UINT64:
+            break;
+        default:
+            res = ERR_NCX_SKIPPED;
+            continue;
+        }
+
+        /* find the content match node for this key;
+         * all of them have to match so any one will do
+         */
+        cmval = NULL;
+        for (filchild = val_get_first_child(filnode->filval);
+             filchild != NULL && cmval == NULL;
+             filchild = val_get_next_child(filchild)) {
+
+            if (filchild->btyp != NCX_BT_STRING ||
+                xml_strcmp(filchild->name, obj_get_name(keyobj))) {
+                continue;
+            }
+
+            nsid = filchild->nsid;
+            if (!isnotif && nsid == ncid) {
+                nsid = 0;
+            }
+            if (nsid == 0 || nsid == obj_get_nsid(keyobj)) {
+                cmval = filchild;
+            }
+        }
+
+        if (cmval == NULL) {
+            res = ERR_NCX_SKIPPED;
+            continue;
+        }
+
+        keyval = val_make_simval_obj(keyobj, VAL_STR(cmval), &res);
+        if (keyval) {
+            dlq_enque(keyval, &filnode->keyQ);
+        } else if (res == NO_ERR) {
+            res = ERR_INTERNAL_MEM;
+        }
+    }
+
+    if (res != NO_ERR) {
+        clean_filnode_keys(filnode);
+    } else if (!dlq_empty(&filnode->keyQ)) {
+        filnode->keymatch = TRUE;
+        if (LOGDEBUG3) {
+            log_debug3("\nagt_tree: keyed match for list '%s'",
+                       obj_get_name(listobj));
+        }
+    }
+    filnode->listobj = listobj;
+
+} /* bind_filnode */
+
+
+/********************************************************************
+* FUNCTION key_match_test
+*
+* Check the bound key values of a compiled filter node
+* against the keys of a list entry
+* 
+* INPUTS:
+*    filnode == compiled filter node with keymatch set
+*    curval == list entry to check
+*
+* RETURNS:
+*    TRUE if the keys match or could not be checked
+*    FALSE if any key is different
+*********************************************************************/
+static boolean
+    key_match_test (agt_tree_filnode_t *filnode,
+                    val_value_t *curval)
+{
+    val_index_t   *valindex;
+    val_value_t   *keyval;
+
+    keyval = (val_value_t *)dlq_firstEntry(&filnode->keyQ);
+    for (valindex = val_get_first_index(curval);
+         valindex != NULL && keyval != NULL;
+         valindex = val_get_next_index(valindex)) {
+
+        if (valindex->val == NULL || val_is_virtual(valindex->val)) {
+            return TRUE;
+        }
+        if (val_compare(keyval, valindex->val)) {
+            return FALSE;
+        }
+        keyval = (val_value_t *)dlq_nextEntry(keyval);
+    }
+
+    return TRUE;
+
+} /* key_match_test */
+
+
+/********************************************************************
+* FUNCTION clean_keyidxQ
+*
+* free all the list key indexes in a Q
+* 
+* INPUTS:
+*    keyidxQ == Q of keyidx_t to clean
+*********************************************************************/
+static void
+    clean_keyidxQ (dlq_hdr_t *keyidxQ)
+{
+    keyidx_t  *keyidx;
+
+    while (!dlq_empty(keyidxQ)) {
+        keyidx = (keyidx_t *)dlq_deque(keyidxQ);
+        if (keyidx->entryA) {
+            m__free(keyidx->entryA);
+        }
+        m__free(keyidx);
+    }
+
+} /* clean_keyidxQ */
+
+
+/********************************************************************
+* FUNCTION compare_keyidx_entries
+*
+* qsort compare function to sort list entries by key
+*
+* INPUTS:
+*    p1 == pointer to the 1st entry pointer
+*    p2 == pointer to the 2nd entry pointer
+* RETURNS:
+*    -1, 0 or 1 as for val_index_compare
+*********************************************************************/
+static int
+    compare_keyidx_entries (const void *p1,
+                            const void *p2)
+{
+    const val_value_t *val1 = *(val_value_t * const *)p1;
+    const val_value_t *val2 = *(val_value_t * const *)p2;
+
+    return val_index_compare(val1, val2);
+
+} /* compare_keyidx_entries */
+
+
+/********************************************************************
+* FUNCTION compare_filnode_keys
+*
+* Compare the bound key values of a compiled filter node
+* to the keys of a list entry, in the same order
+* as val_index_compare
+* 
+* INPUTS:
+*    filnode == compiled filter node with keymatch set
+*    curval == list entry with all its keys
+*
+* RETURNS:
+*    -1, 0 or 1 for the filter keys compared to the entry keys
+*********************************************************************/
+static int32
+    compare_filnode_keys (agt_tree_filnode_t *filnode,
+                          val_value_t *curval)
+{
+    val_index_t   *valindex;
+    val_value_t   *keyval;
+    int32          ret;
+
+    keyval = (val_value_t *)dlq_firstEntry(&filnode->keyQ);
+    for (valindex = val_get_first_index(curval);
+         valindex != NULL && keyval != NULL;
+         valindex = val_get_next_index(valindex)) {
+
+        ret = val_compare(keyval, valindex->val);
+        if (ret) {
+            return ret;
+        }
+        keyval = (val_value_t *)dlq_nextEntry(keyval);
+    }
+
+    return 0;
+
+} /* compare_filnode_keys */
+
+
+/********************************************************************
+* FUNCTION build_keyidx
+*
+* Sort the entries of the list in a key index by key
+* The index is not used if any entry does not have all
+* its keys or has a virtual key, since key_match_test
+* cannot reject those entries either
+* 
+* INPUTS:
+*    keyidx == key index to fill in
+*    useval == target node with the list entries
+*    filval == keyed filter node for the list
+*
+* OUTPUTS:
+*    keyidx->entryA, count and useidx are set
+*    useidx is left FALSE if the index cannot be used
+*********************************************************************/
+static void
+    build_keyidx (keyidx_t *keyidx,
+                  val_value_t *useval,
+                  val_value_t *filval)
+{
+    val_value_t   *curchild;
+    val_index_t   *valindex;
+    uint32         keycnt, count;
+
+    keycnt = obj_key_count(keyidx->listobj);
+    count = 0;
+    for (curchild = val_first_child_qname(useval, 
+                                          filval->nsid,
+                                          filval->name);
+         curchild != NULL;
+         curchild = val_next_child_qname(useval,
+                                         filval->nsid,
+                                         filval->name,
+                                         curchild)) {
+
+        if (curchild->obj != keyidx->listobj ||
+            dlq_count(&curchild->indexQ) != keycnt) {
+            return;
+        }
+        for (valindex = val_get_first_index(curchild);
+             valindex != NULL;
+             valindex = val_get_next_index(valindex)) {
+            if (valindex->val == NULL || val_is_virtual(valindex->val)) {
+                return;
+            }
+        }
+        count++;
+    }
+
+    if (count == 0) {
+        keyidx->useidx = TRUE;
+        return;
+    }
+
+    keyidx->entryA = m__getMem(count * sizeof(val_value_t *));
+    if (!keyidx->entryA) {
+        /* not an error; the entries are just checked one at a time */
+        return;
+    }
+
+    count = 0;
+    for (curchild = val_first_child_qname(useval, 
+                                          filval->nsid,
+                                          filval->name);
+         curchild != NULL;
+         curchild = val_next_child_qname(useval,
+                                         filval->nsid,
+                                         filval->name,
+                                         curchild)) {
+        keyidx->entryA[count++] = curchild;
+    }
+
+    qsort(keyidx->entryA, count, sizeof(val_value_t *),
+          compare_keyidx_entries);
+    keyidx->count = count;
+    keyidx->useidx = TRUE;
+
+    if (LOGDEBUG3) {
+        log_debug3("\nagt_tree: key index of %u '%s' entries",
+                   count, 
+                   obj_get_name(keyidx->listobj));
+    }
+
+} /* build_keyidx */
+
+
+/********************************************************************
+* FUNCTION find_keyed_entry
+*
+* Find the list entry selected by the key content match
+* nodes of a compiled filter node, using a key index
+* of the list entries if the list is selected by more than
+* one keyed filter node in the same sibling set
+* 
+* INPUTS:
+*    keyidxQ == Q of keyidx_t for the current sibling set
+*    useval == target node with the list entries
+*    filval == keyed filter node for the list
+*    filnode == compiled filter node for filval, with keymatch set
+*    listobj == object template of the list
+*    retval == address of return entry
+*
+* OUTPUTS:
+*    *retval == matching entry or NULL if none;
+*               only set if TRUE is returned
+*
+* RETURNS:
+*    TRUE if *retval is the only entry that can match
+*    FALSE if the entries have to be checked one at a time
+*********************************************************************/
+static boolean
+    find_keyed_entry (dlq_hdr_t *keyidxQ,
+                      val_value_t *useval,
+                      val_value_t *filval,
+                      agt_tree_filnode_t *filnode,
+                      obj_template_t *listobj,
+                      val_value_t **retval)
+{
+    keyidx_t      *keyidx;
+    uint32         low, high, mid;
+    int32          ret;
+
+    for (keyidx = (keyidx_t *)dlq_firstEntry(keyidxQ);
+         keyidx != NULL;
+         keyidx = (keyidx_t *)dlq_nextEntry(keyidx)) {
+        if (keyidx->listobj == listobj) {
+            break;
+        }
+    }
+
+    if (!keyidx) {
+        keyidx = m__getObj(keyidx_t);
+        if (!keyidx) {
+            return FALSE;
+        }
+        memset(keyidx, 0x0, sizeof(keyidx_t));
+        keyidx->listobj = listobj;
+        dlq_enque(keyidx, keyidxQ);
+    }
+
+    if (++keyidx->lookups < KEYIDX_MIN_LOOKUPS) {
+        return FALSE;
+    }
+    if (keyidx->lookups == KEYIDX_MIN_LOOKUPS) {
+        build_keyidx(keyidx, useval, filval);
+    }
+    if (!keyidx->useidx) {
+        return FALSE;
+    }
+
+    *retval = NULL;
+    low = 0;
+    high = keyidx->count;
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        ret = compare_filnode_keys(filnode, keyidx->entryA[mid]);
+        if (ret == 0) {
+            *retval = keyidx->entryA[mid];
+            break;
+        } else if (ret < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+
+    return TRUE;
+
+} /* find_keyed_entry */
+
+
 /********************************************************************
 * FUNCTION attr_test
 *
@@ -394,8 +915,12 @@ static boolean
 *   isnotif == TRUE if this is for a notification
 *              FALSE if for <get> or <get-config>
 *    filval == filter node
+*    filnode == compiled filter node for filval
+*            == NULL if the filter is not compiled
 *    curval == current database node
 *    result == filptr tree result to fill in
+*    keyidxQ == empty Q of keyidx_t to use for the list
+*               entries of curval; cleaned by the caller
 *    keepempty == address of return keepempty flag
 *
 * OUTPUTS:
@@ -414,14 +939,18 @@ static status_t
                  boolean getop,
                  boolean isnotif,
                  val_value_t *filval,
+                 agt_tree_filnode_t *filnode,
                  val_value_t *curval,
                  ncx_filptr_t *result,
+                 dlq_hdr_t *keyidxQ,
                  boolean *keepempty)
 {
     val_value_t      *filchild, *curchild, *useval, *virtualval;
     val_index_t      *valindex;
     ncx_filptr_t     *filptr;
-    boolean           test, anycon, anysel, mykeepempty;
+    agt_tree_filnode_t *chnode;
+    dlq_hdr_t         chkeyidxQ;
+    boolean           test, anycon, anysel, mykeepempty, done, keyed;
     xmlns_id_t        ncid, wildid;
     status_t          res;
 
@@ -465,7 +994,8 @@ static status_t
                                            curval,
                                            &res);
         if (virtualval == NULL) {
-            return res;
+            /* a skipped node is not a match */
+            return (res == ERR_NCX_SKIPPED) ? NO_ERR : res;
         } else {
             useval = virtualval;
             result->virtualnode = virtualval;
@@ -584,10 +1114,24 @@ static status_t
     /* Go through the filval child nodes again and this
      * time select nodes for real
      */
+    chnode = NULL;
     for (filchild = val_get_first_child(filval);
          filchild != NULL;
          filchild = val_get_next_child(filchild)) {
 
+        /* the compiled child nodes are in the same order
+         * as the container child nodes of the filter
+         */
+        if (filnode && filchild->btyp == NCX_BT_CONTAINER) {
+            chnode = (chnode) ? (agt_tree_filnode_t *)dlq_nextEntry(chnode)
+                : (agt_tree_filnode_t *)dlq_firstEntry(&filnode->childQ);
+            if (chnode && chnode->filval != filchild) {
+                SET_ERROR(ERR_INTERNAL_VAL);
+                filnode = NULL;
+                chnode = NULL;
+            }
+        }
+
         /* first check if this is a get-config operation 
          * and if so, if the test node fails the config test 
          */
@@ -600,14 +1144,39 @@ static status_t
         /* go through all the actual instances of 'filchild'
          * within the child nodes of 'curval'
          */
-        for (curchild = val_first_child_qname(useval, 
-                                              filchild->nsid,
-                                              filchild->name);
-             curchild != NULL;
-             curchild = val_next_child_qname(useval,
-                                             filchild->nsid,
-                                             filchild->name,
-                                             curchild)) {
+        curchild = val_first_child_qname(useval, 
+                                         filchild->nsid,
+                                         filchild->name);
+
+        /* a list entry selected by its keys can be found
+         * in the key index of the list instead
+         */
+        keyed = FALSE;
+        if (chnode && curchild && 
+            filchild->btyp == NCX_BT_CONTAINER &&
+            filchild->nsid != 0 &&
+            curchild->btyp == NCX_BT_LIST) {
+            if (chnode->listobj != curchild->obj) {
+                bind_filnode(chnode, curchild->obj, isnotif);
+            }
+            if (chnode->keymatch) {
+                keyed = find_keyed_entry(keyidxQ,
+                                         useval,
+                                         filchild,
+                                         chnode,
+                                         curchild->obj,
+                                         &curchild);
+            }
+        }
+
+        done = FALSE;
+        for (;
+             curchild != NULL && !done;
+             curchild = (keyed) ? NULL :
+                 val_next_child_qname(useval,
+                                      filchild->nsid,
+                                      filchild->name,
+                                      curchild)) {
             
             filptr = NULL;
 
@@ -653,6 +1222,19 @@ static status_t
                     break;
                 }
 
+                /* a list entry with different key values than the
+                 * key content match nodes cannot match the filter
+                 */
+                if (chnode) {
+                    if (chnode->listobj != curchild->obj) {
+                        bind_filnode(chnode, curchild->obj, isnotif);
+                    }
+                    if (chnode->keymatch &&
+                        !key_match_test(chnode, curchild)) {
+                        break;
+                    }
+                }
+
                 /* save this node for now */
                 filptr = save_filptr(result, curchild);
                 if (!filptr) {
@@ -662,14 +1244,18 @@ static status_t
                 /* go through the child nodes of the filter
                  * and compare to the complex target 
                  */
+                dlq_createSQue(&chkeyidxQ);
                 res = process_val(msg,
                                   scb, 
                                   getop, 
                                   isnotif,
                                   filchild,
+                                  chnode,
                                   curchild, 
                                   filptr, 
+                                  &chkeyidxQ,
                                   &mykeepempty);
+                clean_keyidxQ(&chkeyidxQ);
                 if (res != NO_ERR) {
                     return res;
                 }
@@ -679,6 +1265,14 @@ static status_t
                     ncx_free_filptr(filptr);
                     filptr = NULL;
                 }
+
+                /* the list keys are unique so no other
+                 * entry can match the key content match nodes;
+                 * a wildcard namespace can match other lists
+                 */
+                if (chnode && chnode->keymatch && filchild->nsid != 0) {
+                    done = TRUE;
+                }
                 break;
             default:
                 return SET_ERROR(ERR_INTERNAL_VAL);
@@ -862,6 +1456,68 @@ static void
 /************  E X T E R N A L    F U N C T I O N S    **************/
 
 
+/********************************************************************
+* FUNCTION agt_tree_compile_filter
+*
+* Compile a subtree filter so it can be evaluated
+* more than once with keyed list lookups
+*
+* INPUTS:
+*    filter == subtree filter to compile
+*              !!! must remain valid while the compiled filter is used
+*
+* RETURNS:
+*    pointer to malloced compiled filter
+*    NULL if malloc error or filter is not a container node
+*********************************************************************/
+agt_tree_filnode_t *
+    agt_tree_compile_filter (val_value_t *filter)
+{
+#ifdef DEBUG
+    if (!filter) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return NULL;
+    }
+#endif
+
+    if (filter->btyp != NCX_BT_CONTAINER) {
+        return NULL;
+    }
+    return new_filnode(filter);
+
+} /* agt_tree_compile_filter */
+
+
+/********************************************************************
+* FUNCTION agt_tree_free_filter
+*
+* Free a compiled subtree filter
+*
+* INPUTS:
+*    filnode == compiled filter to free
+*********************************************************************/
+void
+    agt_tree_free_filter (agt_tree_filnode_t *filnode)
+{
+    agt_tree_filnode_t  *chnode;
+
+#ifdef DEBUG
+    if (!filnode) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    while (!dlq_empty(&filnode->childQ)) {
+        chnode = (agt_tree_filnode_t *)dlq_deque(&filnode->childQ);
+        agt_tree_free_filter(chnode);
+    }
+    clean_filnode_keys(filnode);
+    m__free(filnode);
+
+} /* agt_tree_free_filter */
+
+
 /********************************************************************
 * FUNCTION agt_tree_prune_filter
 *
@@ -913,6 +1569,8 @@ ncx_filptr_t *
 {
     val_value_t       *filter;
     ncx_filptr_t      *top;
+    agt_tree_filnode_t *filnode;
+    dlq_hdr_t          keyidxQ;
     status_t           res;
     boolean            keepempty;
 
@@ -955,15 +1613,27 @@ ncx_filptr_t *
         }
         top->node = cfg->root;
 
+        /* the filter is processed without keyed list lookups
+         * if it cannot be compiled
+         */
+        filnode = agt_tree_compile_filter(filter);
+
         keepempty = FALSE;
+        dlq_createSQue(&keyidxQ);
         res = process_val((msg) ? &msg->mhdr : NULL,
                           scb, 
                           getop, 
                           FALSE,
                           filter, 
+                          filnode,
                           cfg->root, 
                           top, 
+                          &keyidxQ,
                           &keepempty);
+        clean_keyidxQ(&keyidxQ);
+        if (filnode) {
+            agt_tree_free_filter(filnode);
+        }
         if (res != NO_ERR || dlq_empty(&top->childQ)) {
             /* ignore keepempty because the result will
              * be the same w/NULL return, just faster
@@ -1031,6 +1701,8 @@ void
 *    msghdr == message in progress; needed for access control
 *    scb == session control block; needed for access control
 *    filter == subtree filter to use
+*    cfilter == compiled filter for 'filter'
+*            == NULL to test the filter without compiling it
 *    topval == value tree to check against
 *
 * RETURNS:
@@ -1041,9 +1713,11 @@ boolean
     agt_tree_test_filter (xml_msg_hdr_t *msghdr,
                           ses_cb_t *scb,
                           val_value_t *filter,
+                          agt_tree_filnode_t *cfilter,
                           val_value_t *topval)
 {
     ncx_filptr_t      *top;
+    dlq_hdr_t          keyidxQ;
     status_t           res;
     boolean            keepempty, retval;
 
@@ -1082,14 +1756,18 @@ boolean
         top->node = topval;
 
         keepempty = FALSE;        
+        dlq_createSQue(&keyidxQ);
         res = process_val(msghdr,
                           scb, 
                           TRUE, 
                           TRUE,
                           filter, 
+                          cfilter,
                           topval, 
                           top, 
+                          &keyidxQ,
                           &keepempty);
+        clean_keyidxQ(&keyidxQ);
         if (res != NO_ERR || dlq_empty(&top->childQ)) {
             /* ignore keepempty because the result will
              * be the same w/NULL return, just faster
@@ -37,6 +37,14 @@ date	     init     comment
 #include "cfg.h"
 #endif
 
+#ifndef _H_dlq
+#include "dlq.h"
+#endif
+
+#ifndef _H_obj
+#include "obj.h"
+#endif
+
 #ifndef _H_rpc
 #include "rpc.h"
 #endif
@@ -49,6 +57,31 @@ date	     init     comment
 extern "C" {
 #endif
 
+/********************************************************************
+*								    *
+*			     T Y P E S				    *
+*								    *
+*********************************************************************/
+
+/* compiled subtree filter node
+ * There is one entry for each container node in the filter,
+ * and the childQ is in the same order as the container child
+ * nodes of filval.  If filval selects list entries, the content
+ * match nodes for the list keys are converted to typed values
+ * for the list template, the first time an entry is tested.
+ * A list can then be searched by comparing the key values
+ * instead of processing every entry.
+ */
+typedef struct agt_tree_filnode_t_ {
+    dlq_hdr_t          qhdr;
+    val_value_t       *filval;       /* back-ptr to filter node */
+    dlq_hdr_t          childQ;       /* Q of agt_tree_filnode_t */
+    obj_template_t    *listobj;      /* back-ptr to bound list */
+    boolean            keymatch;     /* all keys content matched */
+    dlq_hdr_t          keyQ;         /* Q of val_value_t */
+} agt_tree_filnode_t;
+
+
 /********************************************************************
 *								    *
 *			F U N C T I O N S			    *
@@ -56,6 +89,36 @@ extern "C" {
 *********************************************************************/
 
 
+/********************************************************************
+* FUNCTION agt_tree_compile_filter
+*
+* Compile a subtree filter so it can be evaluated
+* more than once with keyed list lookups
+*
+* INPUTS:
+*    filter == subtree filter to compile
+*              !!! must remain valid while the compiled filter is used
+*
+* RETURNS:
+*    pointer to malloced compiled filter
+*    NULL if malloc error or filter is not a container node
+*********************************************************************/
+extern agt_tree_filnode_t *
+    agt_tree_compile_filter (val_value_t *filter);
+
+
+/********************************************************************
+* FUNCTION agt_tree_free_filter
+*
+* Free a compiled subtree filter
+*
+* INPUTS:
+*    filnode == compiled filter to free
+*********************************************************************/
+extern void
+    agt_tree_free_filter (agt_tree_filnode_t *filnode);
+
+
 /********************************************************************
 * FUNCTION agt_tree_prune_filter
 *
@@ -143,6 +206,8 @@ extern void
 *    msghdr == message in progress; needed for access control
 *    scb == session control block; needed for access control
 *    filter == subtree filter to use
+*    cfilter == compiled filter for 'filter'
+*            == NULL to test the filter without compiling it
 *    topval == value tree to check against
 *
 * RETURNS:
@@ -153,6 +218,7 @@ extern boolean
     agt_tree_test_filter (xml_msg_hdr_t *msghdr,
                           ses_cb_t *scb,
                           val_value_t *filter,
+                          agt_tree_filnode_t *cfilter,
                           val_value_t *topval);
 
 #ifdef __cplusplus
@@ -31,6 +31,9 @@ date         init     comment
 #include <memory.h>
 #include <string.h>
 #include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
 
 #include "procdefs.h"
 #include "agt.h"
@@ -84,12 +87,42 @@ typedef struct agt_keywalker_parms_t_ {
 }  agt_keywalker_parms_t;
 
 
+/* one virtual node with an asynchronous get started
+ * for the <get> reply in progress
+ */
+typedef struct agt_getcb_pending_t_ {
+    dlq_hdr_t     qhdr;
+    val_value_t  *val;
+    int           fd;
+    boolean       done;
+}  agt_getcb_pending_t;
+
+
+/* one virtual list node replaced by its entries
+ * for the filtered <get> reply in progress
+ */
+typedef struct agt_virtual_list_t_ {
+    dlq_hdr_t     qhdr;
+    val_value_t  *listval;
+    val_value_t  *parent;
+    val_value_t  *prev;       /* sibling before listval or NULL */
+    val_value_t  *first;      /* first entry or NULL */
+    uint32        count;
+}  agt_virtual_list_t;
+
+
 /********************************************************************
 *                                                                   *
 *                       V A R I A B L E S                           *
 *                                                                   *
 *********************************************************************/
 
+/* number of objects with a getcb_start_fn_t installed */
+static uint32 getcb_start_count = 0;
+
+/* number of virtual list nodes made with agt_make_virtual_list */
+static uint32 virtual_list_count = 0;
+
 /********************************************************************
 * FUNCTION is_default
 *
@@ -321,6 +354,605 @@ static status_t validate_subtree_filter( rpc_msg_t* msg,
     return NO_ERR;
 }
 
+/********************************************************************
+* FUNCTION filter_node_match
+*
+* Check if a subtree filter node is for a data node
+*
+* INPUTS:
+*    filval == subtree filter node
+*    val == data node to check
+*
+* RETURNS:
+*    TRUE if the names match and the filter node namespace
+*      is the same or a wildcard
+*    FALSE otherwise
+*********************************************************************/
+static boolean
+    filter_node_match (const val_value_t *filval,
+                       val_value_t *val)
+{
+    if (xml_strcmp(filval->name, val->name)) {
+        return FALSE;
+    }
+
+    /* unqualified filter nodes inherit the NETCONF namespace */
+    return (filval->nsid == 0 || filval->nsid == xmlns_nc_id() ||
+            filval->nsid == val_get_nsid(val)) ? TRUE : FALSE;
+
+}  /* filter_node_match */
+
+
+/********************************************************************
+* FUNCTION filter_selects_top
+*
+* Check if a top-level node can be selected by a subtree filter
+*
+* INPUTS:
+*    filter == subtree filter in the request; NULL if none
+*    val == top-level node to check
+*
+* RETURNS:
+*    TRUE if the filter has a top-level node for val
+*    FALSE if val is never in the reply
+*********************************************************************/
+static boolean
+    filter_selects_top (val_value_t *filter,
+                        val_value_t *val)
+{
+    val_value_t  *filchild;
+
+    if (filter == NULL) {
+        return TRUE;
+    }
+
+    for (filchild = val_get_first_child(filter);
+         filchild != NULL;
+         filchild = val_get_next_child(filchild)) {
+        if (filter_node_match(filchild, val)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+
+}  /* filter_selects_top */
+
+
+/********************************************************************
+* FUNCTION collect_list_entry
+*
+* getcb_emit_fn_t to save a copy of a virtual list entry
+*
+* INPUTS:
+*    cookie == Q of val_value_t to add the copy to
+*    entry == list entry emitted by the getcb_bulk_fn_t
+*
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    collect_list_entry (void *cookie,
+                        val_value_t *entry)
+{
+    val_value_t  *copy;
+
+    copy = val_clone(entry);
+    if (copy == NULL) {
+        return ERR_INTERNAL_MEM;
+    }
+    dlq_enque(copy, (dlq_hdr_t *)cookie);
+    return NO_ERR;
+
+}  /* collect_list_entry */
+
+
+/********************************************************************
+* FUNCTION filter_has_keys
+*
+* Check if a subtree filter node has a content match node
+* for each key of a list
+*
+* INPUTS:
+*    filval == subtree filter node for the list
+*    listobj == list object
+*
+* RETURNS:
+*    TRUE if filval can be passed to a getcb_bulk_fn_t as keyval
+*    FALSE otherwise
+*********************************************************************/
+static boolean
+    filter_has_keys (const val_value_t *filval,
+                     obj_template_t *listobj)
+{
+    obj_key_t    *objkey;
+    val_value_t  *filchild;
+    boolean       found;
+
+    if (filval->btyp != NCX_BT_CONTAINER) {
+        return FALSE;
+    }
+
+    objkey = obj_first_key(listobj);
+    if (objkey == NULL) {
+        return FALSE;
+    }
+
+    for (; objkey != NULL; objkey = obj_next_key(objkey)) {
+        found = FALSE;
+        for (filchild = val_get_first_child(filval);
+             filchild != NULL && !found;
+             filchild = val_get_next_child(filchild)) {
+            if (filchild->btyp == NCX_BT_STRING &&
+                objkey->keyobj != NULL &&
+                !xml_strcmp(filchild->name, obj_get_name(objkey->keyobj))) {
+                found = TRUE;
+            }
+        }
+        if (!found) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+
+}  /* filter_has_keys */
+
+
+/********************************************************************
+* FUNCTION filter_selects_all
+*
+* Check if a subtree filter node selects the whole subtree
+* of the data nodes it matches
+*
+* INPUTS:
+*    filval == subtree filter node
+*
+* RETURNS:
+*    TRUE if filval is a selection node or only has
+*      content match nodes
+*    FALSE if filval has containment or selection child nodes
+*********************************************************************/
+static boolean
+    filter_selects_all (const val_value_t *filval)
+{
+    val_value_t  *filchild;
+
+    if (filval->btyp != NCX_BT_CONTAINER) {
+        return TRUE;
+    }
+
+    for (filchild = val_get_first_child(filval);
+         filchild != NULL;
+         filchild = val_get_next_child(filchild)) {
+        if (filchild->btyp != NCX_BT_STRING) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+
+}  /* filter_selects_all */
+
+
+/********************************************************************
+* FUNCTION expand_virtual_list
+*
+* Replace a virtual list node with all its entries
+*
+* INPUTS:
+*    scb == session issuing the get
+*    listval == virtual list node to expand
+*    keyval == key filter to pass to the getcb_bulk_fn_t
+*    listQ == Q of agt_virtual_list_t to add to
+*
+* OUTPUTS:
+*    listQ has an entry to restore listval
+*********************************************************************/
+static void
+    expand_virtual_list (ses_cb_t *scb,
+                         val_value_t *listval,
+                         const val_value_t *keyval,
+                         dlq_hdr_t *listQ)
+{
+    agt_virtual_list_t  *vlist;
+    getcb_bulk_fn_t      bulkfn;
+    val_value_t         *entry;
+    dlq_hdr_t            entryQ;
+    status_t             res;
+
+    vlist = m__getObj(agt_virtual_list_t);
+    if (vlist == NULL) {
+        return;
+    }
+    memset(vlist, 0x0, sizeof(agt_virtual_list_t));
+
+    dlq_createSQue(&entryQ);
+    bulkfn = (getcb_bulk_fn_t)listval->getcb;
+    res = (*bulkfn)(scb, listval, keyval, collect_list_entry, &entryQ);
+    if (res != NO_ERR) {
+        log_error("\nError: get of virtual list '%s' failed (%s)",
+                  listval->name, get_error_string(res));
+        while (!dlq_empty(&entryQ)) {
+            entry = (val_value_t *)dlq_deque(&entryQ);
+            val_free_value(entry);
+        }
+    }
+
+    vlist->listval = listval;
+    vlist->parent = listval->parent;
+    vlist->prev = (val_value_t *)dlq_prevEntry(listval);
+    vlist->first = (val_value_t *)dlq_firstEntry(&entryQ);
+    for (entry = vlist->first;
+         entry != NULL;
+         entry = (val_value_t *)dlq_nextEntry(entry)) {
+        entry->parent = vlist->parent;
+        vlist->count++;
+    }
+
+    if (vlist->count > 0) {
+        dlq_block_insertAfter(&entryQ, listval);
+    }
+    val_remove_child(listval);
+    dlq_enque(vlist, listQ);
+
+}  /* expand_virtual_list */
+
+
+/********************************************************************
+* FUNCTION expand_virtual_lists
+*
+* Replace the virtual list nodes in a subtree with their
+* entries so the filter can be applied to them.  Only the
+* virtual lists that can be selected by the subtree filter
+* are expanded.  A list entry filter with all the keys is
+* passed to the getcb_bulk_fn_t.
+*
+* INPUTS:
+*    scb == session issuing the get
+*    parent == parent node of the subtree to expand
+*    filparent == subtree filter node for parent;
+*                 NULL to expand all virtual lists in the subtree
+*    listQ == Q of agt_virtual_list_t to add to
+*
+* OUTPUTS:
+*    listQ has an entry for each virtual list replaced
+*********************************************************************/
+static void
+    expand_virtual_lists (ses_cb_t *scb,
+                          val_value_t *parent,
+                          val_value_t *filparent,
+                          dlq_hdr_t *listQ)
+{
+    val_value_t  *chval, *nextval, *filchild, *filmatch;
+    uint32        matchcount;
+
+    for (chval = val_get_first_child(parent);
+         chval != NULL;
+         chval = nextval) {
+
+        nextval = val_get_next_child(chval);
+
+        filmatch = NULL;
+        matchcount = 0;
+        if (filparent != NULL) {
+            for (filchild = val_get_first_child(filparent);
+                 filchild != NULL;
+                 filchild = val_get_next_child(filchild)) {
+                if (filter_node_match(filchild, chval)) {
+                    filmatch = filchild;
+                    matchcount++;
+                }
+            }
+            if (matchcount == 0) {
+                continue;
+            }
+        }
+
+        if (val_is_virtual_list(chval)) {
+            if (matchcount == 1 && filter_has_keys(filmatch, chval->obj)) {
+                expand_virtual_list(scb, chval, filmatch, listQ);
+            } else {
+                expand_virtual_list(scb, chval, NULL, listQ);
+            }
+        } else if (val_is_virtual(chval)) {
+            continue;
+        } else if (typ_has_children(chval->btyp)) {
+            if (matchcount == 1 && !filter_selects_all(filmatch)) {
+                expand_virtual_lists(scb, chval, filmatch, listQ);
+            } else {
+                expand_virtual_lists(scb, chval, NULL, listQ);
+            }
+        }
+    }
+
+}  /* expand_virtual_lists */
+
+
+/********************************************************************
+* FUNCTION restore_virtual_lists
+*
+* Put back the virtual list nodes replaced by
+* expand_virtual_lists and free the entries
+*
+* INPUTS:
+*    listQ == Q of agt_virtual_list_t to restore
+*********************************************************************/
+static void
+    restore_virtual_lists (dlq_hdr_t *listQ)
+{
+    agt_virtual_list_t  *vlist;
+    val_value_t         *entry, *nextentry, *firstval;
+    uint32               i;
+
+    /* the last list replaced is put back first so the
+     * prev sibling of each list is still in the tree
+     */
+    while (!dlq_empty(listQ)) {
+        vlist = (agt_virtual_list_t *)dlq_lastEntry(listQ);
+        dlq_remove(vlist);
+
+        entry = vlist->first;
+        for (i = 0; i < vlist->count && entry != NULL; i++) {
+            nextentry = val_get_next_child(entry);
+            val_remove_child(entry);
+            val_free_value(entry);
+            entry = nextentry;
+        }
+
+        vlist->listval->parent = vlist->parent;
+        if (vlist->prev != NULL) {
+            dlq_insertAfter(vlist->listval, vlist->prev);
+        } else {
+            firstval = val_get_first_child(vlist->parent);
+            if (firstval != NULL) {
+                dlq_insertAhead(vlist->listval, firstval);
+            } else {
+                dlq_enque(vlist->listval, &vlist->parent->v.childQ);
+            }
+        }
+        m__free(vlist);
+    }
+
+}  /* restore_virtual_lists */
+
+
+/********************************************************************
+* FUNCTION start_virtual_gets
+*
+* Start the asynchronous get for each virtual node
+* in a subtree with a getcb_start_fn_t for its object
+* and no cached value.  The virtual nodes are not expanded.
+*
+* INPUTS:
+*    scb == session issuing the get
+*    parent == parent node of the subtree to check
+*    filter == subtree filter to select the top-level
+*              nodes to check; NULL to check all child nodes
+*    pendingQ == Q of agt_getcb_pending_t to add to
+*
+* OUTPUTS:
+*    pendingQ has an entry for each get started
+*********************************************************************/
+static void
+    start_virtual_gets (ses_cb_t *scb,
+                        val_value_t *parent,
+                        val_value_t *filter,
+                        dlq_hdr_t *pendingQ)
+{
+    val_value_t         *chval;
+    agt_getcb_pending_t *pending;
+    getcb_start_fn_t     startfn;
+    getcb_fn_t           getcb;
+    status_t             res;
+    int                  fd;
+
+    for (chval = val_get_first_child(parent);
+         chval != NULL;
+         chval = val_get_next_child(chval)) {
+
+        if (!filter_selects_top(filter, chval)) {
+            continue;
+        }
+
+        if (!val_is_virtual(chval)) {
+            if (typ_has_children(chval->btyp)) {
+                start_virtual_gets(scb, chval, NULL, pendingQ);
+            }
+            continue;
+        }
+
+        if (chval->obj == NULL || chval->obj->getcb_start == NULL ||
+            val_virtual_value_cached(scb, chval)) {
+            continue;
+        }
+
+        startfn = (getcb_start_fn_t)chval->obj->getcb_start;
+        fd = -1;
+        res = (*startfn)(scb, chval, &fd);
+        if (res != NO_ERR || fd < 0) {
+            /* the get callback will be called when the node
+             * is written to the reply
+             */
+            continue;
+        }
+
+        pending = m__getObj(agt_getcb_pending_t);
+        if (pending == NULL) {
+            getcb = (getcb_fn_t)chval->getcb;
+            (void)(*getcb)(scb, GETCB_CANCEL_VALUE, chval, NULL);
+            continue;
+        }
+        memset(pending, 0x0, sizeof(agt_getcb_pending_t));
+        pending->val = chval;
+        pending->fd = fd;
+        dlq_enque(pending, pendingQ);
+    }
+
+}  /* start_virtual_gets */
+
+
+/********************************************************************
+* FUNCTION get_msec_now
+*
+* Get the monotonic time in milliseconds
+*
+* RETURNS:
+*    current time in milliseconds
+*********************************************************************/
+static int64
+    get_msec_now (void)
+{
+    struct timespec  ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000);
+
+}  /* get_msec_now */
+
+
+/********************************************************************
+* FUNCTION finish_virtual_gets
+*
+* Wait for the replies to the asynchronous gets started
+* with start_virtual_gets.  The get callback for each node
+* is called as soon as its file descriptor is readable,
+* in the order the replies arrive.  The gets still running
+* when the getcb-deadline expires are cancelled and the
+* nodes are left out of the reply in progress.
+*
+* INPUTS:
+*    scb == session issuing the get
+*    pendingQ == Q of agt_getcb_pending_t to wait for
+*
+* OUTPUTS:
+*    the nodes in pendingQ have VAL_FL_VIRTUAL_FETCHED or
+*    VAL_FL_VIRTUAL_TIMEOUT set; the entries stay in pendingQ
+*    until clear_virtual_gets is called
+*********************************************************************/
+static void
+    finish_virtual_gets (ses_cb_t *scb,
+                         dlq_hdr_t *pendingQ)
+{
+    agt_getcb_pending_t *pending;
+    struct pollfd       *fds;
+    val_value_t         *v_val;
+    getcb_fn_t           getcb;
+    int64                deadline, waittime;
+    uint32               count, i;
+    int                  ret;
+    status_t             res;
+
+    count = 0;
+    for (pending = (agt_getcb_pending_t *)dlq_firstEntry(pendingQ);
+         pending != NULL;
+         pending = (agt_getcb_pending_t *)dlq_nextEntry(pending)) {
+        count++;
+    }
+
+    if (LOGDEBUG2) {
+        log_debug2("\nagt_util: started %u virtual gets", count);
+    }
+
+    fds = m__getMem(count * sizeof(struct pollfd));
+    deadline = get_msec_now() + agt_get_profile()->agt_getcb_deadline;
+
+    while (fds != NULL && count > 0) {
+        i = 0;
+        for (pending = (agt_getcb_pending_t *)dlq_firstEntry(pendingQ);
+             pending != NULL;
+             pending = (agt_getcb_pending_t *)dlq_nextEntry(pending)) {
+            if (!pending->done) {
+                fds[i].fd = pending->fd;
+                fds[i].events = POLLIN;
+                fds[i].revents = 0;
+                i++;
+            }
+        }
+
+        waittime = deadline - get_msec_now();
+        if (waittime <= 0) {
+            break;
+        }
+
+        ret = poll(fds, count, (int)waittime);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            log_error("\nError: agt_util: poll failed (%s)",
+                      strerror(errno));
+            break;
+        } else if (ret == 0) {
+            break;
+        }
+
+        /* run the get callbacks for the replies that arrived */
+        i = 0;
+        for (pending = (agt_getcb_pending_t *)dlq_firstEntry(pendingQ);
+             pending != NULL;
+             pending = (agt_getcb_pending_t *)dlq_nextEntry(pending)) {
+            if (pending->done) {
+                continue;
+            }
+            if (fds[i++].revents) {
+                pending->done = TRUE;
+                count--;
+                res = NO_ERR;
+                v_val = val_get_virtual_value(scb, pending->val, &res);
+                if (v_val != NULL) {
+                    pending->val->flags |= VAL_FL_VIRTUAL_FETCHED;
+                }
+            }
+        }
+    }
+
+    if (fds != NULL) {
+        m__free(fds);
+    }
+
+    /* cancel the gets that missed the deadline */
+    for (pending = (agt_getcb_pending_t *)dlq_firstEntry(pendingQ);
+         pending != NULL;
+         pending = (agt_getcb_pending_t *)dlq_nextEntry(pending)) {
+        if (pending->done) {
+            continue;
+        }
+        pending->done = TRUE;
+        if (LOGDEBUG) {
+            log_debug("\nagt_util: get for virtual node '%s' "
+                      "missed the deadline",
+                      pending->val->name);
+        }
+        getcb = (getcb_fn_t)pending->val->getcb;
+        (void)(*getcb)(scb, GETCB_CANCEL_VALUE, pending->val, NULL);
+        pending->val->flags |= VAL_FL_VIRTUAL_TIMEOUT;
+    }
+
+}  /* finish_virtual_gets */
+
+
+/********************************************************************
+* FUNCTION clear_virtual_gets
+*
+* Clear the reply flags set by finish_virtual_gets
+* and free the pendingQ entries
+*
+* INPUTS:
+*    pendingQ == Q of agt_getcb_pending_t to clear
+*********************************************************************/
+static void
+    clear_virtual_gets (dlq_hdr_t *pendingQ)
+{
+    agt_getcb_pending_t *pending;
+
+    while (!dlq_empty(pendingQ)) {
+        pending = (agt_getcb_pending_t *)dlq_deque(pendingQ);
+        pending->val->flags &= 
+            ~(VAL_FL_VIRTUAL_FETCHED | VAL_FL_VIRTUAL_TIMEOUT);
+        m__free(pending);
+    }
+
+}  /* clear_virtual_gets */
+
+
 /************  E X T E R N A L    F U N C T I O N S    **************/
 
 /********************************************************************
@@ -1405,6 +2037,7 @@ status_t
 {
     cfg_template_t  *source;
     ncx_filptr_t    *top;
+    dlq_hdr_t        pendingQ, listQ;
     boolean          getop=FALSE;
     boolean          rpc_is_get=FALSE;
     boolean          rpc_is_get_data=FALSE;
@@ -1436,6 +2069,51 @@ status_t
 
     res = NO_ERR;
 
+    /* a filter is applied to the entries of a virtual list,
+     * so they are put in the tree until the reply is done;
+     * otherwise they are written as they are emitted
+     */
+    dlq_createSQue(&listQ);
+    if (getop && virtual_list_count > 0) {
+        switch (msg->rpc_filter.op_filtyp) {
+        case OP_FILTER_SUBTREE:
+            if (msg->rpc_filter.op_filter->btyp == NCX_BT_CONTAINER) {
+                expand_virtual_lists(scb, source->root,
+                                     msg->rpc_filter.op_filter, &listQ);
+            }
+            break;
+        case OP_FILTER_XPATH:
+            expand_virtual_lists(scb, source->root, NULL, &listQ);
+            break;
+        default:
+            ;
+        }
+    }
+
+    /* start all the asynchronous state data gets before
+     * any of them is waited for; XPath filters get
+     * the virtual nodes one at a time as they are evaluated
+     */
+    dlq_createSQue(&pendingQ);
+    if (getop && getcb_start_count > 0) {
+        switch (msg->rpc_filter.op_filtyp) {
+        case OP_FILTER_NONE:
+            start_virtual_gets(scb, source->root, NULL, &pendingQ);
+            break;
+        case OP_FILTER_SUBTREE:
+            if (msg->rpc_filter.op_filter->btyp == NCX_BT_CONTAINER) {
+                start_virtual_gets(scb, source->root,
+                                   msg->rpc_filter.op_filter, &pendingQ);
+            }
+            break;
+        default:
+            ;
+        }
+        if (!dlq_empty(&pendingQ)) {
+            finish_virtual_gets(scb, &pendingQ);
+        }
+    }
+
     switch (msg->rpc_filter.op_filtyp) {
     case OP_FILTER_NONE:
         switch (msg->mhdr.withdef) {
@@ -1487,6 +2165,9 @@ status_t
     default:
         res = SET_ERROR(ERR_INTERNAL_PTR);
     }
+
+    clear_virtual_gets(&pendingQ);
+    restore_virtual_lists(&listQ);
     return res;
                 
 } /* agt_output_filter */
@@ -2500,6 +3181,108 @@ status_t
 }  /* agt_add_top_virtual */
 
 
+/********************************************************************
+* FUNCTION agt_set_virtual_start_cb
+*
+* Install a start function for the asynchronous get of
+* the virtual nodes of an object.  The gets for all the
+* virtual nodes needed for a <get> reply are started
+* before the server waits for any reply, so slow state
+* data sources are queried in parallel.  The getcb_fn_t
+* installed for each virtual node reads the reply.
+*
+* INPUTS:
+*   obj == object node of the virtual data nodes
+*   startfn == start function to install
+*
+* RETURNS:
+*   status
+*********************************************************************/
+status_t
+    agt_set_virtual_start_cb (obj_template_t *obj,
+                              getcb_start_fn_t startfn)
+{
+#ifdef DEBUG
+    if (obj == NULL || startfn == NULL) {
+        return SET_ERROR(ERR_INTERNAL_PTR);
+    }
+#endif
+
+    if (obj->getcb_start == NULL) {
+        getcb_start_count++;
+    }
+    obj->getcb_start = (void *)startfn;
+    return NO_ERR;
+
+}  /* agt_set_virtual_start_cb */
+
+
+/********************************************************************
+* FUNCTION agt_make_virtual_list
+*
+* make a val_value_t struct for all the entries of
+* a virtual list.  The getcb_bulk_fn_t is called once
+* per reply and emits the list entries one at a time.
+* The entries are written as they are emitted unless
+* a filter has to be applied to them.
+*
+INPUTS:
+*   parentobj == parent object to find child list object
+*   listname == name of list to find (namespace hardwired)
+*   bulkfn == bulk get callback function to install
+*   res == address of return status
+*
+* OUTPUTS:
+*   *res == return status
+*
+* RETURNS:
+*   malloced value struct or NULL if some error
+*********************************************************************/
+val_value_t *
+    agt_make_virtual_list (obj_template_t *parentobj,
+                           const xmlChar *listname,
+                           getcb_bulk_fn_t bulkfn,
+                           status_t *res)
+{
+    obj_template_t  *listobj;
+    val_value_t     *listval;
+
+#ifdef DEBUG
+    if (parentobj == NULL || 
+        listname == NULL ||
+        bulkfn == NULL ||
+        res == NULL) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return NULL;
+    }
+#endif
+    
+    listobj = obj_find_child(parentobj,
+                             obj_get_mod_name(parentobj),
+                             listname);
+    if (!listobj) {
+        *res = ERR_NCX_DEF_NOT_FOUND;
+        return NULL;
+    }
+    if (listobj->objtype != OBJ_TYP_LIST) {
+        *res = ERR_NCX_WRONG_TYPE;
+        return NULL;
+    }
+
+    listval = val_new_value();
+    if (!listval) {
+        *res = ERR_INTERNAL_MEM;
+        return NULL;
+    }
+    val_init_virtual_list(listval, bulkfn, listobj);
+    virtual_list_count++;
+
+    *res = NO_ERR;
+    return listval;
+
+}  /* agt_make_virtual_list */
+
+
 /********************************************************************
 * FUNCTION agt_add_top_container
 *
@@ -871,6 +871,56 @@ extern status_t
                          getcb_fn_t callbackfn);
 
 
+/********************************************************************
+* FUNCTION agt_set_virtual_start_cb
+*
+* Install a start function for the asynchronous get of
+* the virtual nodes of an object.  The gets for all the
+* virtual nodes needed for a <get> reply are started
+* before the server waits for any reply, so slow state
+* data sources are queried in parallel.  The getcb_fn_t
+* installed for each virtual node reads the reply.
+*
+* INPUTS:
+*   obj == object node of the virtual data nodes
+*   startfn == start function to install
+*
+* RETURNS:
+*   status
+*********************************************************************/
+extern status_t
+    agt_set_virtual_start_cb (obj_template_t *obj,
+                              getcb_start_fn_t startfn);
+
+
+/********************************************************************
+* FUNCTION agt_make_virtual_list
+*
+* make a val_value_t struct for all the entries of
+* a virtual list.  The getcb_bulk_fn_t is called once
+* per reply and emits the list entries one at a time.
+* The entries are written as they are emitted unless
+* a filter has to be applied to them.
+*
+INPUTS:
+*   parentobj == parent object to find child list object
+*   listname == name of list to find (namespace hardwired)
+*   bulkfn == bulk get callback function to install
+*   res == address of return status
+*
+* OUTPUTS:
+*   *res == return status
+*
+* RETURNS:
+*   malloced value struct or NULL if some error
+*********************************************************************/
+extern val_value_t *
+    agt_make_virtual_list (obj_template_t *parentobj,
+                           const xmlChar *listname,
+                           getcb_bulk_fn_t bulkfn,
+                           status_t *res);
+
+
 /********************************************************************
 * FUNCTION agt_add_top_container
 *
@@ -31,8 +31,11 @@ date         init     comment
 *********************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <memory.h>
 #include <assert.h>
+#include <errno.h>
+#include <poll.h>
 
 #include "procdefs.h"
 #include "agt.h"
@@ -42,6 +45,7 @@ date         init     comment
 #include "agt_cfg.h"
 #include "agt_commit_complete.h"
 #include "agt_ncx.h"
+#include "agt_top.h"
 #include "agt_util.h"
 #include "agt_val.h"
 #include "agt_val_parse.h"
@@ -74,6 +78,33 @@ date         init     comment
 *                                                                   *
 *********************************************************************/
 
+/* min number of source list entries for the sort-merge
+ * matching of the child nodes of one parent   */
+#define BULK_LIST_MIN  16
+
+
+/********************************************************************
+*                                                                   *
+*                            T Y P E S                              *
+*                                                                   *
+*********************************************************************/
+
+/* a source list entry and its matching target entry */
+typedef struct list_match_t_ {
+    val_value_t  *newval;
+    val_value_t  *curval;
+} list_match_t;
+
+
+/* an edit with a COMMIT callback started in the backend */
+typedef struct commit_pending_t_ {
+    dlq_hdr_t            qhdr;
+    agt_cfg_undo_rec_t  *undo;
+    val_value_t         *top;
+    int                  fd;
+} commit_pending_t;
+
+
 /* recursive callback function forward decls */
 static status_t
     invoke_btype_cb (agt_cbtyp_t cbtyp,
@@ -555,6 +586,160 @@ static status_t
 } /* delete_children_first */
 
 
+/********************************************************************
+* FUNCTION invoke_batch_cb
+* 
+* Queue or invoke 1 edit for a SIL batch callback function
+* The edit is added to the batch for the object if the
+* transaction is collecting batches for the current phase;
+* otherwise the function is invoked now with just this edit
+*
+* INPUTS:
+*    cbtyp == agent callback type
+*    editop == edit operation applied to newnode and/or curnode
+*    scb == session control block invoking the callback
+*    msg == RPC message in progress
+*    obj == object the batch callback is registered for
+*    batchfn == batch callback function
+*    newnode == new node in operation
+*    curnode == current node in operation
+*
+* RETURNS:
+*   status of the operation
+*********************************************************************/
+static status_t
+    invoke_batch_cb (agt_cbtyp_t cbtyp,
+                     op_editop_t editop,
+                     ses_cb_t  *scb,
+                     rpc_msg_t  *msg,
+                     obj_template_t *obj,
+                     agt_cb_batch_fn_t batchfn,
+                     val_value_t *newnode,
+                     val_value_t *curnode)
+{
+    agt_cfg_transaction_t *txcb = msg->rpc_txcb;
+    agt_cfg_batch_t       *batch = NULL;
+    status_t               res;
+
+    if (txcb && txcb->batching) {
+        /* most edits go to the batch that got the last one */
+        batch = (agt_cfg_batch_t *)dlq_lastEntry(&txcb->batchQ);
+        if (batch && (batch->obj != obj || batch->batchfn != batchfn)) {
+            for (batch = (agt_cfg_batch_t *)dlq_firstEntry(&txcb->batchQ);
+                 batch != NULL;
+                 batch = (agt_cfg_batch_t *)dlq_nextEntry(batch)) {
+                if (batch->obj == obj && batch->batchfn == batchfn) {
+                    break;
+                }
+            }
+        }
+        if (batch == NULL) {
+            batch = agt_cfg_new_batch(obj, batchfn);
+            if (batch == NULL) {
+                return ERR_INTERNAL_MEM;
+            }
+            dlq_enque(batch, &txcb->batchQ);
+        }
+        if (txcb->editbatch == NULL) {
+            txcb->editbatch = batch;
+        }
+        return agt_cfg_add_batch_edit(batch, editop, newnode, curnode);
+    }
+
+    /* not collecting edits; invoke with a batch of 1 */
+    batch = agt_cfg_new_batch(obj, batchfn);
+    if (batch == NULL) {
+        return ERR_INTERNAL_MEM;
+    }
+    res = agt_cfg_add_batch_edit(batch, editop, newnode, curnode);
+    if (res == NO_ERR) {
+        res = (*batchfn)(scb, msg, cbtyp, &batch->editQ);
+    }
+    agt_cfg_free_batch(batch);
+    return res;
+
+} /* invoke_batch_cb */
+
+
+/********************************************************************
+* FUNCTION flush_batch_callbacks
+* 
+* Stop collecting batches for the current phase and invoke
+* each SIL batch callback function once with all its edits
+* The batches are kept in the txcb->batchQ with the result
+* of the call until free_batch_callbacks is called
+*
+* INPUTS:
+*    cbtyp == agent callback type
+*    scb == session control block invoking the callbacks
+*    msg == RPC message in progress
+*    res == status of the phase so far; the batches are
+*           skipped if not NO_ERR
+*
+* RETURNS:
+*   res or the status of the first batch callback that failed
+*********************************************************************/
+static status_t
+    flush_batch_callbacks (agt_cbtyp_t cbtyp,
+                           ses_cb_t  *scb,
+                           rpc_msg_t  *msg,
+                           status_t res)
+{
+    agt_cfg_transaction_t *txcb = msg->rpc_txcb;
+    agt_cfg_batch_t       *batch;
+
+    txcb->batching = FALSE;
+    txcb->editbatch = NULL;
+
+    for (batch = (agt_cfg_batch_t *)dlq_firstEntry(&txcb->batchQ);
+         batch != NULL && res == NO_ERR;
+         batch = (agt_cfg_batch_t *)dlq_nextEntry(batch)) {
+
+        if (LOGDEBUG2) {
+            log_debug2("\nInvoking %s batch callback for %u edits on %s:%s",
+                       agt_cbtype_name(cbtyp),
+                       dlq_count(&batch->editQ),
+                       obj_get_mod_name(batch->obj),
+                       obj_get_name(batch->obj));
+        }
+
+        res = batch->res = (*batch->batchfn)(scb, msg, cbtyp, 
+                                             &batch->editQ);
+        if (res != NO_ERR && LOGDEBUG) {
+            log_debug("\n%s batch callback failed (%s) on %s:%s",
+                      agt_cbtype_name(cbtyp),
+                      get_error_string(res),
+                      obj_get_mod_name(batch->obj),
+                      obj_get_name(batch->obj));
+        }
+    }
+
+    return res;
+
+} /* flush_batch_callbacks */
+
+
+/********************************************************************
+* FUNCTION free_batch_callbacks
+* 
+* Free all the batches left by flush_batch_callbacks
+*
+* INPUTS:
+*    txcb == transaction control block to clean
+*
+*********************************************************************/
+static void
+    free_batch_callbacks (agt_cfg_transaction_t *txcb)
+{
+    while (!dlq_empty(&txcb->batchQ)) {
+        agt_cfg_batch_t *batch = (agt_cfg_batch_t *)
+            dlq_deque(&txcb->batchQ);
+        agt_cfg_free_batch(batch);
+    }
+
+} /* free_batch_callbacks */
+
+
 /********************************************************************
 * FUNCTION handle_user_callback
 * 
@@ -646,6 +831,16 @@ static status_t
             cbset_node!=NULL;
             cbset_node=(agt_cb_fnset_node_t *)dlq_nextEntry(cbset_node)) {
             cbset = cbset_node->fnset_ptr;
+            if (cbset_node->batchfn != NULL) {
+                cbfn_calls++;
+                editop = cvt_editop(editop, newnode, curnode);
+                res = invoke_batch_cb(cbtyp, editop, scb, msg, val->obj,
+                                      cbset_node->batchfn, newnode, curnode);
+                if (res != NO_ERR) {
+                    return res;
+                }
+                continue;
+            }
             if(cbset->cbfn[cbtyp]==NULL) {
                 continue;
             } else {
@@ -748,17 +943,6 @@ static agt_cfg_undo_rec_t *
         return NULL;
     }
 
-    /* save a copy of the current value in case it gets modified
-     * in a merge operation;; done for leafs only!!!
-     */
-    if (curnode && obj_is_leafy(curnode->obj)) {
-        undo->curnode_clone = val_clone(curnode);
-        if (!undo->curnode_clone) {
-            agt_cfg_free_undorec(undo);
-            return NULL;
-        }
-    }
-
     undo->editop = cvt_editop(editop, newnode, curnode);
     undo->newnode = newnode;
     undo->newnode_marker = newnode_marker;
@@ -796,6 +980,9 @@ static agt_cfg_undo_rec_t *
 *    parent == complex value node with a childQ
 *    cleanQ == address of Q to receive any agt_cfg_nodeptr_t
 *      structs for nodes marked as deleted
+*    lastentry == entry of the same list or leaf-list in the
+*      parent to add the child after, if it is added last;
+*      NULL to search the parent for the place of the child
 *
 * OUTPUTS:
 *    cleanQ may have nodes added if the child being added
@@ -808,7 +995,8 @@ static status_t
     add_child_clean (val_editvars_t *editvars,
                      val_value_t *child,
                      val_value_t *parent,
-                     dlq_hdr_t *cleanQ)
+                     dlq_hdr_t *cleanQ,
+                     val_value_t *lastentry)
 {
     val_value_t  *testval, *nextval;
     agt_cfg_nodeptr_t *nodeptr;
@@ -864,7 +1052,11 @@ static status_t
             break;
         case OP_INSOP_LAST:
         case OP_INSOP_NONE:
-            val_add_child_sorted(child, parent);
+            if (lastentry) {
+                dlq_insertAfter(child, lastentry);
+            } else {
+                val_add_child_sorted(child, parent);
+            }
             break;
         case OP_INSOP_BEFORE:
         case OP_INSOP_AFTER:
@@ -904,6 +1096,118 @@ static status_t
 }   /* add_child_clean */
 
 
+/********************************************************************
+* FUNCTION compare_entries
+* 
+* Compare 2 entries of the same list or leaf-list
+* in the same way as val_add_child_sorted
+*
+* INPUTS:
+*   val1 == 1st entry
+*   val2 == 2nd entry
+*
+* RETURNS:
+*   compare result as for val_index_compare or val_compare
+*********************************************************************/
+static int32
+    compare_entries (const val_value_t *val1,
+                     const val_value_t *val2)
+{
+    if (val1->obj->objtype == OBJ_TYP_LIST) {
+        return val_index_compare(val1, val2);
+    }
+    return val_compare(val1, val2);
+
+}  /* compare_entries */
+
+
+/********************************************************************
+* FUNCTION get_prev_entry
+* 
+* Get the previous entry of the same list or leaf-list
+*
+* INPUTS:
+*   val == entry to start from
+*
+* RETURNS:
+*   previous entry that is not deleted; NULL if none
+*********************************************************************/
+static val_value_t *
+    get_prev_entry (val_value_t *val)
+{
+    val_value_t *prev = (val_value_t *)dlq_prevEntry(val);
+
+    while (prev != NULL && VAL_IS_DELETED(prev)) {
+        prev = (val_value_t *)dlq_prevEntry(prev);
+    }
+    if (prev != NULL && prev->obj == val->obj) {
+        return prev;
+    }
+    return NULL;
+
+}  /* get_prev_entry */
+
+
+/********************************************************************
+* FUNCTION get_entry_before
+* 
+* Find the entry of a list or leaf-list in the parent that a new
+* entry has to be added after, starting from an entry that was
+* added before, so the parent does not have to be searched from
+* its first child
+*
+* The new entry goes after the last entry, or in sorted order
+* if system ordered entries are kept sorted, so an edit with
+* entries in key order only compares each entry with its
+* neighbours
+*
+* INPUTS:
+*   lastentry == entry added to the parent before (may be NULL)
+*   child == new entry to add
+*   parent == parent value to add child to
+*
+* RETURNS:
+*   entry to add the child after;
+*   NULL if the parent has to be searched for the place
+*   of the new entry
+*********************************************************************/
+static val_value_t *
+    get_entry_before (val_value_t *lastentry,
+                      val_value_t *child,
+                      val_value_t *parent)
+{
+    val_value_t *nextval;
+    boolean      sorted;
+
+    if (lastentry == NULL || lastentry->obj != child->obj ||
+        lastentry->parent != parent || VAL_IS_DELETED(lastentry)) {
+        return NULL;
+    }
+
+    sorted = obj_is_system_ordered(child->obj) && ncx_get_system_sorted();
+
+    if (sorted && compare_entries(child, lastentry) < 0) {
+        /* go back to the entry before the first greater entry */
+        for (lastentry = get_prev_entry(lastentry);
+             lastentry != NULL && compare_entries(child, lastentry) < 0;
+             lastentry = get_prev_entry(lastentry)) {
+            ;
+        }
+        return lastentry;
+    }
+
+    /* go forward past all entries, or all entries not greater */
+    for (nextval = val_get_next_child(lastentry);
+         nextval != NULL && nextval->obj == child->obj &&
+             (!sorted || compare_entries(child, nextval) >= 0);
+         nextval = val_get_next_child(lastentry)) {
+        lastentry = nextval;
+    }
+    return lastentry;
+
+}  /* get_entry_before */
+
+
 /********************************************************************
 * FUNCTION add_child_node
 * 
@@ -944,9 +1248,21 @@ static status_t
         val_free_value(marker);
         return ERR_INTERNAL_MEM;
     }
+
+    agt_cfg_transaction_t *txcb = msg->rpc_txcb;
+    val_value_t *lastentry = NULL;
+    boolean islist = (child->obj->objtype == OBJ_TYP_LIST ||
+                      child->obj->objtype == OBJ_TYP_LEAF_LIST);
+    if (islist && parent == txcb->bulkparent) {
+        lastentry = get_entry_before(txcb->lastentry, child, parent);
+    }
+
     undo->apply_res = add_child_clean(child->editvars, child, parent, 
-                                      &undo->extra_deleteQ);
+                                      &undo->extra_deleteQ, lastentry);
     undo->edit_action = AGT_CFG_EDIT_ACTION_ADD;
+    if (islist && parent == txcb->bulkparent) {
+        txcb->lastentry = child;
+    }
     return undo->apply_res;
 
 }  /* add_child_node */
@@ -1001,7 +1317,7 @@ static status_t
     VAL_MARK_DELETED(curchild);
 
     undo->apply_res = add_child_clean(newchild->editvars, newchild, parent, 
-                                      &undo->extra_deleteQ);
+                                      &undo->extra_deleteQ, NULL);
     undo->edit_action = AGT_CFG_EDIT_ACTION_MOVE;
     return undo->apply_res;
 
@@ -1048,7 +1364,7 @@ static status_t
     undo->curnode_marker = marker;
     val_swap_child(marker, curchild);
     undo->apply_res = add_child_clean(newchild->editvars, curchild, parent,
-                                      &undo->extra_deleteQ);
+                                      &undo->extra_deleteQ, NULL);
     undo->edit_action = AGT_CFG_EDIT_ACTION_MOVE;
     return undo->apply_res;
 
@@ -1101,6 +1417,64 @@ static void
 }  /* restore_newnode2 */
 
 
+/********************************************************************
+* FUNCTION set_leafy_node
+* 
+* Apply a new value to an existing leaf or leaf-list node
+*
+* The new node is put in the target next to the current node,
+* which is marked as deleted and kept as the backup for
+* rollback_edit and reverse_edit, so no copy is made.
+* Index nodes and nodes with metadata keep their identity:
+* a copy of the current node is saved in the undo record
+* and the new value is merged into the current node instead.
+*
+* INPUTS:
+*   undo == undo record in progress, already in the undoQ
+*           with newnode, newnode_marker and curnode set
+*
+* OUTPUTS:
+*   undo->edit_action set to AGT_CFG_EDIT_ACTION_SET
+*   undo record removed from the undoQ and freed on
+*   ERR_INTERNAL_MEM error
+*
+* RETURNS:
+*   status
+*********************************************************************/
+static status_t
+    set_leafy_node (agt_cfg_undo_rec_t *undo)
+{
+    val_value_t *newval = undo->newnode;
+    val_value_t *curval = undo->curnode;
+
+    undo->edit_action = AGT_CFG_EDIT_ACTION_SET;
+
+    if (curval->index == NULL && newval->index == NULL &&
+        val_meta_empty(curval) && val_meta_empty(newval)) {
+        /* swap the nodes; the newnode_marker stays in the source */
+        val_insert_child(newval, curval, curval->parent);
+        VAL_MARK_DELETED(curval);
+        undo->free_curnode = TRUE;
+        undo->apply_res = NO_ERR;
+        return NO_ERR;
+    }
+
+    undo->curnode_clone = val_clone(curval);
+    if (undo->curnode_clone == NULL) {
+        /* no detailed rpc-error is recorded here!!!
+         * relying on catch-all operation-failed in agt_rpc_dispatch */
+        restore_newnode(undo);
+        dlq_remove(undo);
+        agt_cfg_free_undorec(undo);
+        return ERR_INTERNAL_MEM;
+    }
+    undo->apply_res = val_merge(newval, curval);
+    restore_newnode(undo);
+    return undo->apply_res;
+
+}  /* set_leafy_node */
+
+
 /********************************************************************
 * FUNCTION restore_curnode
 * 
@@ -1122,12 +1496,14 @@ static void
         VAL_UNMARK_DELETED(undo->curnode);
         undo->free_curnode = FALSE;
         if (undo->commit_res != ERR_NCX_SKIPPED &&
+            undo->commit_res != ERR_NCX_TIMEOUT &&
             target->cfg_id == NCX_CFGID_RUNNING) {
             val_check_swap_resnode(undo->newnode, undo->curnode);
         }
     } else if (undo->curnode_clone) {
         /* node is a leaf or leaf-list that was merged */
         if (undo->commit_res != ERR_NCX_SKIPPED &&
+            undo->commit_res != ERR_NCX_TIMEOUT &&
             target->cfg_id == NCX_CFGID_RUNNING) {
             val_check_swap_resnode(undo->newnode, undo->curnode_clone);
         }
@@ -1711,8 +2087,7 @@ static status_t
                     res = move_child_node(newval, newval_marker, curval,
                                           parent, msg, cur_editop);
                 } else if (newval) {
-                    /* merging a simple leaf or leaf-list
-                     * make a copy of the current node first */
+                    /* merging a simple leaf or leaf-list */
                     undo = add_undo_node(msg, cur_editop, newval, 
                                          newval_marker, curval, NULL, parent);
                     if (undo == NULL) {
@@ -1722,9 +2097,7 @@ static status_t
                         restore_newnode2(newval, newval_marker);
                         return ERR_INTERNAL_MEM;
                      }
-                     undo->apply_res = res = val_merge(newval, curval);
-                     undo->edit_action = AGT_CFG_EDIT_ACTION_SET;
-                     restore_newnode(undo);
+                     res = set_leafy_node(undo);
                 } else {
                     res = SET_ERROR(ERR_INTERNAL_VAL);
                 }
@@ -1754,9 +2127,7 @@ static status_t
                      }
 
                      if (obj_is_leafy(curval->obj)) {
-                         undo->apply_res = res = val_merge(newval, curval);
-                         undo->edit_action = AGT_CFG_EDIT_ACTION_SET;
-                         restore_newnode(undo);
+                         res = set_leafy_node(undo);
                      } else {
                          val_insert_child(newval, curval, parent);
                          VAL_MARK_DELETED(curval);
@@ -1785,9 +2156,7 @@ static status_t
                      restore_newnode2(newval, newval_marker);
                      return ERR_INTERNAL_MEM;
                  }
-                 undo->apply_res = res = val_merge(newval, curval);
-                 undo->edit_action = AGT_CFG_EDIT_ACTION_SET;
-                 restore_newnode(undo);
+                 res = set_leafy_node(undo);
              } else if (newval) {
                  res = add_child_node(newval, newval_marker, parent, msg,
                                       cur_editop);
@@ -1829,7 +2198,14 @@ static status_t
 
              /* check if this is a leaf with a default */
              if (obj_get_default(curval->obj)) {
-                 /* convert this leaf to its default value */
+                 /* convert this leaf to its default value;
+                  * save a copy of the current value first */
+                 undo->curnode_clone = val_clone(curval);
+                 if (undo->curnode_clone == NULL) {
+                     dlq_remove(undo);
+                     agt_cfg_free_undorec(undo);
+                     return ERR_INTERNAL_MEM;
+                 }
                  res = val_delete_default_leaf(curval);
                  undo->edit_action = AGT_CFG_EDIT_ACTION_DELETE_DEFAULT;
              } else {
@@ -2182,6 +2558,227 @@ static status_t
 } /* check_keys_present */
 
 
+/********************************************************************
+* FUNCTION compare_list_entries
+*
+* qsort compare function to sort list entries by object and key
+*
+* INPUTS:
+*    val1 == 1st list entry
+*    val2 == 2nd list entry
+* RETURNS:
+*    -1, 0 or 1
+*********************************************************************/
+static int
+    compare_list_entries (const val_value_t *val1,
+                          const val_value_t *val2)
+{
+    int ret;
+
+    if (val1->obj != val2->obj) {
+        return ((uintptr_t)val1->obj < (uintptr_t)val2->obj) ? -1 : 1;
+    }
+    ret = val_index_compare(val1, val2);
+    if (ret < 0) {
+        return -1;
+    }
+    return (ret > 0) ? 1 : 0;
+
+} /* compare_list_entries */
+
+
+/********************************************************************
+* FUNCTION compare_curvals
+*
+* qsort compare function for an array of target list entries
+*********************************************************************/
+static int
+    compare_curvals (const void *p1,
+                     const void *p2)
+{
+    return compare_list_entries(*(val_value_t * const *)p1,
+                                *(val_value_t * const *)p2);
+
+} /* compare_curvals */
+
+
+/********************************************************************
+* FUNCTION compare_matches
+*
+* qsort compare function for an array of list_match_t pointers
+*********************************************************************/
+static int
+    compare_matches (const void *p1,
+                     const void *p2)
+{
+    return compare_list_entries((*(list_match_t * const *)p1)->newval,
+                                (*(list_match_t * const *)p2)->newval);
+
+} /* compare_matches */
+
+
+/********************************************************************
+* FUNCTION is_bulk_entry
+*
+* Check if a list entry can be matched by sort-merge:
+* the list has keys and the index chain has all of them
+*
+* INPUTS:
+*    val == child node to check
+* RETURNS:
+*    TRUE if the node can be sorted by key
+*********************************************************************/
+static boolean
+    is_bulk_entry (const val_value_t *val)
+{
+    uint32 keycnt;
+
+    if (val->btyp != NCX_BT_LIST || VAL_IS_DELETED(val)) {
+        return FALSE;
+    }
+    keycnt = obj_key_count(val->obj);
+    return (keycnt != 0 && dlq_count(&val->indexQ) == keycnt);
+
+} /* is_bulk_entry */
+
+
+/********************************************************************
+* FUNCTION match_list_entries
+*
+* Match the list entries that are child nodes of the source
+* parent against the list entries of the target parent
+*
+* The source entries are sorted by key once and merge-joined
+* against the sorted target entries, instead of searching all
+* the target entries for each source entry.
+* This is only done for BULK_LIST_MIN or more source entries.
+* Each match is the same entry val_first_child_match would find,
+* so the sort-merge is not done if two source entries have the
+* same key; then an entry added for one of them is the match
+* of the other one.
+*
+* INPUTS:
+*    newparent == source parent node
+*    curparent == target parent node
+*    count == address of return count of matches
+*
+* OUTPUTS:
+*    *count == number of matches in the return array
+*
+* RETURNS:
+*    malloced array of the matches of the source entries
+*    in source order; NULL if the child nodes have to be
+*    matched one at a time
+*********************************************************************/
+static list_match_t *
+    match_list_entries (val_value_t *newparent,
+                        val_value_t *curparent,
+                        uint32 *count)
+{
+    list_match_t  *matchA = NULL, **sortA = NULL;
+    val_value_t  **curA = NULL, *val;
+    uint32         newcnt = 0, curcnt = 0, i = 0, k = 0;
+    boolean        ok = TRUE;
+
+    *count = 0;
+
+    for (val = val_get_first_child(newparent);
+         val != NULL;
+         val = val_get_next_child(val)) {
+        if (is_bulk_entry(val)) {
+            newcnt++;
+        }
+    }
+    if (newcnt < BULK_LIST_MIN) {
+        return NULL;
+    }
+
+    for (val = val_get_first_child(curparent);
+         val != NULL;
+         val = val_get_next_child(val)) {
+        if (is_bulk_entry(val)) {
+            curcnt++;
+        }
+    }
+
+    matchA = m__getMem(newcnt * sizeof(list_match_t));
+    sortA = m__getMem(newcnt * sizeof(list_match_t *));
+    if (curcnt) {
+        curA = m__getMem(curcnt * sizeof(val_value_t *));
+    }
+    if (matchA == NULL || sortA == NULL || (curcnt && curA == NULL)) {
+        ok = FALSE;
+    }
+
+    if (ok) {
+        for (val = val_get_first_child(newparent);
+             val != NULL;
+             val = val_get_next_child(val)) {
+            if (is_bulk_entry(val)) {
+                matchA[i].newval = val;
+                matchA[i].curval = NULL;
+                sortA[i] = &matchA[i];
+                i++;
+            }
+        }
+        for (val = val_get_first_child(curparent);
+             val != NULL;
+             val = val_get_next_child(val)) {
+            if (is_bulk_entry(val)) {
+                curA[k++] = val;
+            }
+        }
+
+        qsort(sortA, newcnt, sizeof(list_match_t *), compare_matches);
+        for (i = 1; i < newcnt && ok; i++) {
+            if (compare_matches(&sortA[i-1], &sortA[i]) == 0) {
+                ok = FALSE;
+            }
+        }
+    }
+
+    if (ok && curcnt) {
+        qsort(curA, curcnt, sizeof(val_value_t *), compare_curvals);
+
+        i = 0;
+        k = 0;
+        while (i < newcnt && k < curcnt) {
+            int ret = compare_list_entries(sortA[i]->newval, curA[k]);
+            if (ret < 0) {
+                i++;
+            } else if (ret > 0) {
+                k++;
+            } else {
+                sortA[i++]->curval = curA[k];
+            }
+        }
+    }
+
+    if (sortA) {
+        m__free(sortA);
+    }
+    if (curA) {
+        m__free(curA);
+    }
+    if (!ok) {
+        if (matchA) {
+            m__free(matchA);
+        }
+        return NULL;
+    }
+
+    if (LOGDEBUG3) {
+        log_debug3("\nagt_val: sort-merge %u entries of '%s' with %u "
+                   "entries of '%s'", newcnt, newparent->name,
+                   curcnt, curparent->name);
+    }
+
+    *count = newcnt;
+    return matchA;
+
+} /* match_list_entries */
+
+
 /********************************************************************
 * FUNCTION invoke_cpxval_cb
 * 
@@ -2393,13 +2990,33 @@ static status_t
     /* check all the child nodes next */
     if (retres == NO_ERR && !done && curparent) {
         val_value_t      *chval, *curch, *nextch;
+        list_match_t     *matchA = NULL;
+        uint32            matchcnt = 0, matchnum = 0;
+        val_value_t      *savebulkparent = msg->rpc_txcb->bulkparent;
+        val_value_t      *savelastentry = msg->rpc_txcb->lastentry;
+
+        if (curval && curparent != curval) {
+            matchA = match_list_entries(curparent, curval, &matchcnt);
+        }
+        if (matchA && cbtyp == AGT_CB_APPLY) {
+            /* let add_child_node append new entries after the
+             * last entry it added to curval    */
+            msg->rpc_txcb->bulkparent = curval;
+            msg->rpc_txcb->lastentry = NULL;
+        }
+
         for (chval = val_get_first_child(curparent);
              chval != NULL && retres == NO_ERR;
              chval = nextch) {
 
             nextch = val_get_next_child(chval);
 
-            if (curval) {
+            if (matchnum < matchcnt && matchA[matchnum].newval == chval) {
+                curch = matchA[matchnum++].curval;
+                if (curch && VAL_IS_DELETED(curch)) {
+                    curch = val_first_child_match(curval, chval);
+                }
+            } else if (curval) {
                 curch = val_first_child_match(curval, chval);
             } else {
                 curch = NULL;
@@ -2416,6 +3033,12 @@ static status_t
             //}
             CHK_EXIT(res, retres);
         }
+
+        if (matchA) {
+            msg->rpc_txcb->bulkparent = savebulkparent;
+            msg->rpc_txcb->lastentry = savelastentry;
+            m__free(matchA);
+        }
     }
 
     return retres;
@@ -2606,6 +3229,13 @@ static void
         case OP_EDITOP_COMMIT:
             val_check_swap_resnode(undo->curnode, undo->newnode);
             break;
+        case OP_EDITOP_MERGE:
+        case OP_EDITOP_CREATE:
+            /* check if the newnode took the place of the curnode */
+            if (undo->curnode && VAL_IS_DELETED(undo->curnode)) {
+                val_check_swap_resnode(undo->curnode, undo->newnode);
+            }
+            break;
         case OP_EDITOP_DELETE:
         case OP_EDITOP_REMOVE:
             if (undo->curnode) {
@@ -2853,8 +3483,11 @@ static status_t
         break;
 
     case ERR_NCX_SKIPPED:
+    case ERR_NCX_TIMEOUT:
         /* need a simple undo since the commit fn was never called
-         * first call the SIL with the ROLLBACK request
+         * first call the SIL with the ROLLBACK request; for a commit
+         * started in the backend that missed the commit-deadline
+         * this lets the SIL cancel it
          */
         if (cfgid == NCX_CFGID_RUNNING) {
             undo->rollback_res = handle_user_callback(AGT_CB_ROLLBACK, 
@@ -2935,6 +3568,302 @@ static status_t
 }  /* rollback_edit */
 
 
+/********************************************************************
+* FUNCTION get_top_node
+* 
+* Get the top-level ancestor of an edited node
+*
+* INPUTS:
+*   val == edited node
+*
+* RETURNS:
+*   the ancestor that is a child of the config root, or val
+*********************************************************************/
+static val_value_t *
+    get_top_node (val_value_t *val)
+{
+    while (val->parent != NULL && !obj_is_root(val->parent->obj)) {
+        val = val->parent;
+    }
+    return val;
+
+}  /* get_top_node */
+
+
+/********************************************************************
+* FUNCTION start_commit_edit
+* 
+* Start the COMMIT callback for an edit if the SIL for
+* the edited node registered a commit start function
+* The SIL is found the same way as in handle_user_callback
+*
+* INPUTS:
+*   scb == session control block
+*   msg == incoming rpc_msg_t in progress
+*   undo == edit to start
+*   fd == address of return file descriptor
+*
+* OUTPUTS:
+*   *fd == file descriptor to wait for if started
+*
+* RETURNS:
+*   TRUE if the commit was started; FALSE if the COMMIT
+*   callbacks need to be called now
+*********************************************************************/
+static boolean
+    start_commit_edit (ses_cb_t *scb,
+                       rpc_msg_t *msg,
+                       agt_cfg_undo_rec_t *undo,
+                       int *fd)
+{
+    agt_cb_fnset_node_t *cbset_node;
+    val_value_t         *val;
+    op_editop_t          editop;
+    status_t             res;
+    boolean              hascommit;
+
+    val = (undo->newnode) ? undo->newnode : undo->curnode;
+    if (val == NULL || obj_is_root(val->obj)) {
+        return FALSE;
+    }
+
+    editop = undo->editop;
+    if (editop == OP_EDITOP_REMOVE) {
+        editop = OP_EDITOP_DELETE;
+    }
+    if (obj_is_sil_delete_children_first(val->obj) &&
+        !obj_is_leafy(val->obj) &&
+        editop == OP_EDITOP_DELETE) {
+        return FALSE;
+    }
+
+    /* the first object with COMMIT callbacks gets them */
+    for (;;) {
+        hascommit = FALSE;
+        for (cbset_node = (agt_cb_fnset_node_t *)
+                 dlq_firstEntry(&val->obj->cbsetQ);
+             cbset_node != NULL;
+             cbset_node = (agt_cb_fnset_node_t *)dlq_nextEntry(cbset_node)) {
+            if (cbset_node->startfn != NULL) {
+                break;
+            }
+            if (cbset_node->batchfn != NULL ||
+                cbset_node->fnset_ptr->cbfn[AGT_CB_COMMIT] != NULL) {
+                hascommit = TRUE;
+            }
+        }
+        if (cbset_node != NULL) {
+            break;
+        }
+        if (hascommit) {
+            return FALSE;
+        }
+        if (val->parent != NULL &&
+            !obj_is_root(val->parent->obj) &&
+            val_get_nsid(val) == val_get_nsid(val->parent)) {
+            val = val->parent;
+        } else {
+            return FALSE;
+        }
+    }
+
+    editop = cvt_editop(editop, undo->newnode, undo->curnode);
+    *fd = -1;
+    res = (*cbset_node->startfn)(scb, msg, editop, undo->newnode,
+                                 undo->curnode, fd);
+    if (res != NO_ERR || *fd < 0) {
+        return FALSE;
+    }
+
+    if (LOGDEBUG2) {
+        log_debug2("\nStarted commit of %s edit on %s:%s",
+                   op_editop_name(editop),
+                   val_get_mod_name(val),
+                   val->name);
+    }
+    return TRUE;
+
+}  /* start_commit_edit */
+
+
+/********************************************************************
+* FUNCTION invoke_commit_cb
+* 
+* Invoke the SIL COMMIT callbacks for one edit
+*
+* INPUTS:
+*   scb == session control block
+*   msg == incoming rpc_msg_t in progress
+*   undo == edit to commit
+*
+* OUTPUTS:
+*   undo->commit_res is set
+*
+* RETURNS:
+*   status
+*********************************************************************/
+static status_t
+    invoke_commit_cb (ses_cb_t *scb,
+                      rpc_msg_t *msg,
+                      agt_cfg_undo_rec_t *undo)
+{
+    agt_cfg_transaction_t *txcb = msg->rpc_txcb;
+
+    txcb->editbatch = NULL;
+    undo->commit_res = 
+        handle_user_callback(AGT_CB_COMMIT, undo->editop, scb, msg, 
+                             undo->newnode, undo->curnode, TRUE, FALSE);
+    undo->batch = txcb->editbatch;
+    if (undo->commit_res != NO_ERR) {
+        val_value_t *logval = undo->newnode ? undo->newnode : 
+            undo->curnode;
+        if (LOGDEBUG) {
+            log_debug("\nHalting commit %llu: %s:%s SIL returned error"
+                      " (%s)",
+                      (unsigned long long)txcb->txid,
+                      val_get_mod_name(logval), 
+                      logval->name,
+                      get_error_string(undo->commit_res));
+        }
+    }
+    return undo->commit_res;
+
+}  /* invoke_commit_cb */
+
+
+/********************************************************************
+* FUNCTION finish_commit_edits
+* 
+* Wait for the commits started with start_commit_edit.
+* The COMMIT callbacks for each edit are called as soon
+* as its file descriptor is readable.  The commits still
+* running when the deadline expires are not finished;
+* their edits get a commit_res of ERR_NCX_TIMEOUT and the
+* SIL ROLLBACK callback is called for them in the rollback
+*
+* INPUTS:
+*   scb == session control block
+*   msg == incoming rpc_msg_t in progress
+*   pendingQ == Q of commit_pending_t to wait for
+*   top == top-level node to wait for; NULL to wait for all
+*   deadline == monotonic time in msec to stop waiting
+*
+* OUTPUTS:
+*   the finished entries are removed from pendingQ and freed
+*   all entries are removed if the deadline expired
+*
+* RETURNS:
+*   status of the first COMMIT callback that failed
+*   ERR_NCX_TIMEOUT if the deadline expired
+*********************************************************************/
+static status_t
+    finish_commit_edits (ses_cb_t *scb,
+                         rpc_msg_t *msg,
+                         dlq_hdr_t *pendingQ,
+                         const val_value_t *top,
+                         int64 deadline)
+{
+    commit_pending_t *pending, *nextpending;
+    struct pollfd    *fds;
+    val_value_t      *logval;
+    int64             waittime;
+    uint32            count, i;
+    int               ret;
+    status_t          res = NO_ERR, res2;
+
+    while (!dlq_empty(pendingQ)) {
+        count = 0;
+        for (pending = (commit_pending_t *)dlq_firstEntry(pendingQ);
+             pending != NULL;
+             pending = (commit_pending_t *)dlq_nextEntry(pending)) {
+            if (top == NULL || pending->top == top) {
+                break;
+            }
+        }
+        if (pending == NULL) {
+            break;
+        }
+
+        /* use the wait to parse the next request of the session */
+        (void)agt_top_pipeline_msg(scb);
+
+        waittime = deadline - (int64)(tstamp_monotonic_usec() / 1000);
+        if (waittime <= 0) {
+            res = ERR_NCX_TIMEOUT;
+            break;
+        }
+
+        count = dlq_count(pendingQ);
+        fds = m__getMem(count * sizeof(struct pollfd));
+        ret = -1;
+        if (fds != NULL) {
+            i = 0;
+            for (pending = (commit_pending_t *)dlq_firstEntry(pendingQ);
+                 pending != NULL;
+                 pending = (commit_pending_t *)dlq_nextEntry(pending)) {
+                fds[i].fd = pending->fd;
+                fds[i].events = POLLIN;
+                fds[i].revents = 0;
+                i++;
+            }
+            ret = poll(fds, count, (int)waittime);
+            if ((ret < 0 && errno == EINTR) || ret == 0) {
+                /* the deadline is checked again */
+                m__free(fds);
+                continue;
+            } else if (ret < 0) {
+                log_error("\nError: agt_val: poll failed (%s)",
+                          strerror(errno));
+            }
+        }
+
+        /* finish the commits that are done; all of them if
+         * the wait failed, so the COMMIT callbacks block   */
+        i = 0;
+        for (pending = (commit_pending_t *)dlq_firstEntry(pendingQ);
+             pending != NULL;
+             pending = nextpending) {
+            nextpending = (commit_pending_t *)dlq_nextEntry(pending);
+            if (ret < 0 || fds[i++].revents) {
+                dlq_remove(pending);
+                res2 = invoke_commit_cb(scb, msg, pending->undo);
+                if (res == NO_ERR) {
+                    res = res2;
+                }
+                m__free(pending);
+            }
+        }
+        if (fds != NULL) {
+            m__free(fds);
+        }
+    }
+
+    if (res != ERR_NCX_TIMEOUT) {
+        return res;
+    }
+
+    /* the backend did not finish these commits in time */
+    while (!dlq_empty(pendingQ)) {
+        pending = (commit_pending_t *)dlq_deque(pendingQ);
+        pending->undo->commit_res = ERR_NCX_TIMEOUT;
+        logval = (pending->undo->newnode) ? pending->undo->newnode :
+            pending->undo->curnode;
+        log_error("\nError: commit of %s:%s in transaction %llu "
+                  "missed the commit-deadline",
+                  val_get_mod_name(logval),
+                  logval->name,
+                  (unsigned long long)msg->rpc_txcb->txid);
+        agt_record_error(scb, &msg->mhdr, NCX_LAYER_OPERATION,
+                         ERR_NCX_TIMEOUT, NULL, NCX_NT_NONE, NULL,
+                         NCX_NT_VAL, logval);
+        m__free(pending);
+    }
+
+    return res;
+
+}  /* finish_commit_edits */
+
+
 /********************************************************************
 * FUNCTION attempt_commit
 * 
@@ -2984,32 +3913,83 @@ static status_t
         }
     }
 
-    /* first make sure all SIL callbacks accept the commit */
+    /* first make sure all SIL callbacks accept the commit
+     * the commits started in the backend run while the edits
+     * in other top-level subtrees are committed     */
     if (target->cfg_id == NCX_CFGID_RUNNING) {
+        status_t res = NO_ERR, res2;
+        dlq_hdr_t pendingQ;
+        commit_pending_t *pending;
+        val_value_t *top;
+        int64 deadline;
+        int fd;
+
+        dlq_createSQue(&pendingQ);
+        deadline = (int64)(tstamp_monotonic_usec() / 1000) +
+            agt_get_profile()->agt_commit_deadline;
+        txcb->batching = TRUE;
         undo = (agt_cfg_undo_rec_t *)dlq_firstEntry(&txcb->undoQ);
-        for (; undo != NULL; undo = (agt_cfg_undo_rec_t *)dlq_nextEntry(undo)) {
+        for (; undo != NULL && res == NO_ERR;
+             undo = (agt_cfg_undo_rec_t *)dlq_nextEntry(undo)) {
 
             if (undo->curnode && undo->curnode->parent == NULL) {
                 /* node was actually removed in delete operation */
                 undo->curnode->parent = undo->parentnode;
             }
 
-            undo->commit_res = 
-                handle_user_callback(AGT_CB_COMMIT, undo->editop, scb, msg, 
-                                     undo->newnode, undo->curnode, TRUE, FALSE);
-            if (undo->commit_res != NO_ERR) {
-                val_value_t *logval = undo->newnode ? undo->newnode : 
-                    undo->curnode;
-                if (LOGDEBUG) {
-                    log_debug("\nHalting commit %llu: %s:%s SIL returned error"
-                              " (%s)",
-                              (unsigned long long)txcb->txid,
-                              val_get_mod_name(logval), 
-                              logval->name,
-                              get_error_string(undo->commit_res));
+            /* keep the order of the edits in one top-level subtree */
+            top = (undo->newnode) ? undo->newnode : undo->curnode;
+            if (top != NULL) {
+                top = get_top_node(top);
+            }
+            if (!dlq_empty(&pendingQ)) {
+                res = finish_commit_edits(scb, msg, &pendingQ, top,
+                                          deadline);
+                if (res != NO_ERR) {
+                    break;
+                }
+            }
+
+            if (start_commit_edit(scb, msg, undo, &fd)) {
+                pending = m__getObj(commit_pending_t);
+                if (pending != NULL) {
+                    memset(pending, 0x0, sizeof(commit_pending_t));
+                    pending->undo = undo;
+                    pending->top = top;
+                    pending->fd = fd;
+                    dlq_enque(pending, &pendingQ);
+                    continue;
                 }
-                return undo->commit_res;
+                /* wait for it in the COMMIT callback instead */
             }
+            res = invoke_commit_cb(scb, msg, undo);
+        }
+
+        /* all the started commits are done before returning */
+        res2 = finish_commit_edits(scb, msg, &pendingQ, NULL, deadline);
+        if (res == NO_ERR) {
+            res = res2;
+        }
+
+        /* the edits queued for batch callbacks are only committed
+         * if their batch was invoked and accepted them */
+        res = flush_batch_callbacks(AGT_CB_COMMIT, scb, msg, res);
+        undo = (agt_cfg_undo_rec_t *)dlq_firstEntry(&txcb->undoQ);
+        for (; undo != NULL; undo = (agt_cfg_undo_rec_t *)dlq_nextEntry(undo)) {
+            if (undo->batch) {
+                if (undo->commit_res == NO_ERR) {
+                    undo->commit_res = undo->batch->res;
+                }
+                undo->batch = NULL;
+            }
+        }
+        free_batch_callbacks(txcb);
+        if (res != NO_ERR) {
+            /* a request parsed during the commit was validated
+             * against the edits that are rolled back now
+             */
+            agt_top_abort_pipelined(scb, target);
+            return res;
         }
     }
 
@@ -3063,7 +4043,10 @@ static status_t
 *  if commit tried:
 *   There are N edits that succeeded and commit_res == NO_ERR
 *   There is 1 edit that the SIL callback rejected with an error
+*     (or more if commits started in the backend also failed)
 *   There are M edits with a commit_res of NCX_ERR_SKIPPED
+*   There are K edits started in the backend with a commit_res
+*     of ERR_NCX_TIMEOUT if the commit-deadline expired
 *
 * INPUTS:
 *   scb == session control block
@@ -3155,6 +4138,7 @@ static status_t
 
     agt_cfg_transaction_t *txcb = msg->rpc_txcb;
     status_t res = NO_ERR;
+    boolean batching;
 
     if (LOGDEBUG2) {
         if (editop == OP_EDITOP_DELETE) {
@@ -3195,9 +4179,19 @@ static status_t
     switch (cbtyp) {
     case AGT_CB_VALIDATE:
     case AGT_CB_APPLY:
+        /* collect the edits for SIL batch callbacks unless this
+         * is a nested call in a phase that is already collecting */
+        batching = !txcb->batching;
+        txcb->batching = TRUE;
+
         /* keep checking until all the child nodes have been processed */
         res = invoke_btype_cb(cbtyp, editop, scb, msg, target, newval, curval,
                               curparent);
+
+        if (batching) {
+            res = flush_batch_callbacks(cbtyp, scb, msg, res);
+            free_batch_callbacks(txcb);
+        }
         if (cbtyp == AGT_CB_APPLY) {
             txcb->apply_res = res;
         }
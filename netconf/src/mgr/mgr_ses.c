@@ -1641,6 +1641,9 @@ status_t
 
     /* go through buffer outQ */
     buff = (ses_msg_buff_t *)dlq_deque(&scb->outQ);
+    if (buff) {
+        scb->outqcnt--;
+    }
 
     if (!buff) {
         if (LOGINFO) {
@@ -1710,6 +1713,9 @@ status_t
 
         if (res == NO_ERR) {
             buff = (ses_msg_buff_t *)dlq_deque(&scb->outQ);
+            if (buff) {
+                scb->outqcnt--;
+            }
         } else {
             buff = NULL;
         }
@@ -88,7 +88,8 @@ extern "C" {
 /* placeholder for expansion modes */
 typedef enum getcb_mode_t_ {
     GETCB_NONE,
-    GETCB_GET_VALUE
+    GETCB_GET_VALUE,
+    GETCB_CANCEL_VALUE     /* started get missed the deadline */
 } getcb_mode_t;
 
 
@@ -117,6 +118,84 @@ typedef status_t
 		   const val_value_t *virval,
 		   val_value_t *dstval);
 
+
+/* getcb_start_fn_t
+ *
+ * Callback function to start an asynchronous get for
+ * a virtual value node.  The request is sent to the backend
+ * and the file descriptor that will become readable when
+ * the reply arrives is returned.  All the gets needed for
+ * a request are started before the server waits for any
+ * of them.  The getcb_fn_t for the node is called in
+ * GETCB_GET_VALUE mode to read the reply once the fd is
+ * readable, or in GETCB_CANCEL_VALUE mode with a NULL dstval
+ * if the reply did not arrive before the deadline.
+ * 
+ * INPUTS:
+ *   scb    == session that issued the get (may be NULL)
+ *   virval == place-holder node in the data model for
+ *              this virtual value node
+ *   fd     == address of return file descriptor
+ *
+ * OUTPUTS:
+ *   *fd == file descriptor to wait for
+ *
+ * RETURNS:
+ *    status: NO_ERR if the get was started;
+ *    any error to use the getcb_fn_t directly
+ */
+typedef status_t 
+    (*getcb_start_fn_t) (ses_cb_t *scb,
+			 const val_value_t *virval,
+			 int *fd);
+
+
+/* getcb_emit_fn_t
+ *
+ * Callback function passed to a getcb_bulk_fn_t to
+ * output one list entry.  The entry is not kept by the
+ * server, so the same entry can be filled in and emitted
+ * again for the next list entry.
+ * 
+ * INPUTS:
+ *   cookie == cookie passed to the getcb_bulk_fn_t
+ *   entry  == list entry to output
+ *
+ * RETURNS:
+ *    status: the getcb_bulk_fn_t should stop and return
+ *            any error status
+ */
+typedef status_t 
+    (*getcb_emit_fn_t) (void *cookie,
+			val_value_t *entry);
+
+
+/* getcb_bulk_fn_t
+ *
+ * Callback function for a virtual list node.  All the
+ * entries of the list are output with one call to this
+ * function, which passes each entry to emitfn in order.
+ * 
+ * INPUTS:
+ *   scb    == session that issued the get (may be NULL)
+ *   virval == place-holder node for the whole list
+ *   keyval == node with a child leaf in string form
+ *             for each key of the list entries requested;
+ *             NULL to output all entries.  Returning
+ *             extra entries is allowed.
+ *   emitfn == function to call for each list entry
+ *   cookie == cookie to pass to emitfn
+ *
+ * RETURNS:
+ *    status
+ */
+typedef status_t 
+    (*getcb_bulk_fn_t) (ses_cb_t *scb,
+			const val_value_t *virval,
+			const val_value_t *keyval,
+			getcb_emit_fn_t emitfn,
+			void *cookie);
+
 #ifdef __cplusplus
 }  /* end extern 'C' */
 #endif
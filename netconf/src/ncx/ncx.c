@@ -232,6 +232,10 @@ static uint32 ncx_vtimeout=NCX_DEF_VTIMEOUT;
  * mandatory data nodes; applies to server <load> operation  */
 static boolean      allow_top_mandatory;
 
+/* flag to let yang_parse expand a grouping only when it is
+ * first used instead of when the module is loaded */
+static boolean      lazy_groupings;
+
 /**
  * \fn check_moddef
  * \brief Check if a specified module is loaded; if not, load it.
@@ -963,6 +967,7 @@ status_t
 #endif
 
     allow_top_mandatory = TRUE;
+    lazy_groupings = FALSE;
 
     /* check that the correct version of libxml2 is installed */
     LIBXML_TEST_VERSION;
@@ -6064,6 +6069,10 @@ void
     }
 
     if (len > warn_linelen) {
+        if (tkc) {
+            /* keep the warning in case the chain is cached */
+            (void)tk_add_warning(tkc, ERR_NCX_LINELEN_EXCEEDED, len);
+        }
         log_warn("\nWarning: line is %u chars, limit is %u chars",
                  len,
                  warn_linelen);
@@ -6073,6 +6082,53 @@ void
 } /* ncx_check_warn_linelen */
 
 
+/********************************************************************
+* FUNCTION ncx_print_tk_warnings
+* 
+* Print the warnings recorded in a token chain again
+* Used when a chain is restored from the token cache
+* instead of tokenizing the source file, so the same
+* tokenizer warnings are reported either way
+*
+* INPUTS:
+*   tkc == token chain with the recorded warnings
+*   mod == module (used in warning message only
+*
+* OUTPUTS:
+*    may generate log_warn ouput
+*********************************************************************/
+void
+    ncx_print_tk_warnings (tk_chain_t *tkc,
+                           ncx_module_t *mod)
+{
+    assert ( tkc && " param tkc is NULL" );
+
+    const tk_warn_t  *warn;
+    uint32            linenum, linepos;
+
+    linenum = tkc->linenum;
+    linepos = tkc->linepos;
+
+    for (warn = (const tk_warn_t *)dlq_firstEntry(&tkc->warnQ);
+         warn != NULL;
+         warn = (const tk_warn_t *)dlq_nextEntry(warn)) {
+
+        tkc->linenum = warn->linenum;
+        tkc->linepos = warn->linepos;
+        if (warn->res == ERR_NCX_LINELEN_EXCEEDED) {
+            log_warn("\nWarning: line is %u chars, limit is %u chars",
+                     warn->val,
+                     warn_linelen);
+        }
+        ncx_print_errormsg(tkc, mod, warn->res);
+    }
+
+    tkc->linenum = linenum;
+    tkc->linepos = linepos;
+
+} /* ncx_print_tk_warnings */
+
+
 /********************************************************************
 * FUNCTION ncx_turn_off_warning
 * 
@@ -7096,6 +7152,36 @@ boolean
     return allow_top_mandatory;
 }
 
+/********************************************************************
+* FUNCTION ncx_set_lazy_groupings
+* 
+* Expand the uses-stmts within a grouping only when the
+* grouping is first used, instead of when the module is loaded;
+* a grouping that is never used is not expanded at all
+*
+* INPUTS:
+*   lazy == value to set T: expand on first use; F: expand at load
+*********************************************************************/
+void
+    ncx_set_lazy_groupings (boolean lazy)
+{
+    lazy_groupings = lazy;
+}
+
+/********************************************************************
+* FUNCTION ncx_get_lazy_groupings
+* 
+* Check if groupings are expanded when they are first used
+*
+* RETURNS:
+*   T: expand on first use; F: expand when the module is loaded
+*********************************************************************/
+boolean
+    ncx_get_lazy_groupings (void)
+{
+    return lazy_groupings;
+}
+
 /********************************************************************
 * FUNCTION identity_get_first_iffeature
 *
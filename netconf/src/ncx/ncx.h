@@ -2440,6 +2440,26 @@ extern void
                             const xmlChar *line);
 
 
+/********************************************************************
+* FUNCTION ncx_print_tk_warnings
+* 
+* Print the warnings recorded in a token chain again
+* Used when a chain is restored from the token cache
+* instead of tokenizing the source file, so the same
+* tokenizer warnings are reported either way
+*
+* INPUTS:
+*   tkc == token chain with the recorded warnings
+*   mod == module (used in warning message only
+*
+* OUTPUTS:
+*    may generate log_warn ouput
+*********************************************************************/
+extern void
+    ncx_print_tk_warnings (tk_chain_t *tkc,
+                           ncx_module_t *mod);
+
+
 /********************************************************************
 * FUNCTION ncx_turn_off_warning
 * 
@@ -2952,6 +2972,32 @@ extern boolean
     ncx_get_top_mandatory_allowed (void);
 
 
+/********************************************************************
+* FUNCTION ncx_set_lazy_groupings
+* 
+* Expand the uses-stmts within a grouping only when the
+* grouping is first used, instead of when the module is loaded;
+* a grouping that is never used is not expanded at all
+*
+* INPUTS:
+*   lazy == value to set T: expand on first use; F: expand at load
+*********************************************************************/
+extern void
+    ncx_set_lazy_groupings (boolean lazy);
+
+
+/********************************************************************
+* FUNCTION ncx_get_lazy_groupings
+* 
+* Check if groupings are expanded when they are first used
+*
+* RETURNS:
+*   T: expand on first use; F: expand when the module is loaded
+*********************************************************************/
+extern boolean
+    ncx_get_lazy_groupings (void);
+
+
 #ifdef __cplusplus
 }  /* end extern 'C' */
 #endif
@@ -731,6 +731,17 @@ extern "C" {
 #define NCX_EL_YIN             (const xmlChar *)"yin"
 #define NCX_EL_YUMA_HOME       (const xmlChar *)"yuma-home"
 #define NCX_EL_MAX_SESSIONS    (const xmlChar *)"max-sessions"
+#define NCX_EL_MODULE_CACHE    (const xmlChar *)"module-cache"
+#define NCX_EL_LAZY_GROUPINGS  (const xmlChar *)"lazy-groupings"
+#define NCX_EL_GETCB_DEADLINE  (const xmlChar *)"getcb-deadline"
+#define NCX_EL_COMMIT_DEADLINE (const xmlChar *)"commit-deadline"
+#define NCX_EL_STREAM_OUTPUT   (const xmlChar *)"stream-output"
+#define NCX_EL_PIPELINE_EDITS  (const xmlChar *)"pipeline-edits"
+#define NCX_EL_SESSION_BUFFER_SIZE (const xmlChar *)"session-buffer-size"
+#define NCX_EL_MAX_SESSION_BUFFER_SIZE \
+    (const xmlChar *)"max-session-buffer-size"
+#define NCX_EL_MAX_SEND_BUFFERS (const xmlChar *)"max-send-buffers"
+#define NCX_EL_MAX_SEND_BYTES  (const xmlChar *)"max-send-bytes"
 
 /* bit definitions for ncx_lstr_t flags field */
 #define NCX_FL_RANGE_ERR   bit0
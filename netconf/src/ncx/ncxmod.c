@@ -33,13 +33,17 @@ date         init     comment
 #include <memory.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #include <pwd.h>
 #include <dirent.h>
+#include <errno.h>
 #include <unistd.h>
 #include <libxml/xmlstring.h>
 #include <libxml/xmlreader.h>
 
 #include "procdefs.h"
+#include "bobhash.h"
 #include "help.h"
 #include "log.h"
 #include "ncx.h"
@@ -47,6 +51,7 @@ date         init     comment
 #include "ncxtypes.h"
 #include "ncxmod.h"
 #include "status.h"
+#include "tk.h"
 #include "tstamp.h"
 #include "xml_util.h"
 #include "yangconst.h"
@@ -60,6 +65,16 @@ date         init     comment
 *********************************************************************/
 
 
+/* token cache file identification */
+#define NCXMOD_CACHE_MAGIC     "YTKC"
+#define NCXMOD_CACHE_VERSION   2
+#define NCXMOD_CACHE_SUFFIX    "tkc"
+
+/* 256 row module name hash table of a search path index */
+#define NCXMOD_IDX_HASH_SIZE   (hashsize(8))
+#define NCXMOD_IDX_HASH_MASK   (hashmask(8))
+
+
 /* Enumeration of the basic value type classifications */
 typedef enum ncxmod_mode_t_ {
     NCXMOD_MODE_NONE,
@@ -79,6 +94,77 @@ typedef enum search_type_t_ {
 } search_type_t;
 
 
+/* Enumeration of the directory index entry types */
+typedef enum ncxmod_idx_type_t_ {
+    NCXMOD_IDX_OTHER,
+    NCXMOD_IDX_REG,
+    NCXMOD_IDX_DIR
+} ncxmod_idx_type_t;
+
+
+/* one directory in the module search path index */
+typedef struct ncxmod_idx_dir_t_ {
+    dlq_hdr_t                  qhdr;
+    struct ncxmod_idx_dir_t_  *parent;       /* NULL for the root */
+    uint32                     seq;         /* seq of entry in parent */
+} ncxmod_idx_dir_t;
+
+
+/* one YANG or YIN file in the module search path index;
+ * the seq numbers follow the order search_subdirs visits
+ * the directory entries, so a search of the index returns
+ * the same file as a search of the directory
+ */
+typedef struct ncxmod_idx_file_t_ {
+    dlq_hdr_t          qhdr;
+    ncxmod_idx_dir_t  *dir;
+    xmlChar           *relpath;        /* path from the root dir */
+    const xmlChar     *revision;         /* '@' in relpath or NULL */
+    uint32             revisionlen;       /* not counting the '@' */
+    uint32             seq;
+    ncxmod_idx_type_t  dtyp;      /* readdir type; links are OTHER */
+    ncxmod_idx_type_t  styp;           /* stat type; links followed */
+    boolean            isyang;
+} ncxmod_idx_file_t;
+
+
+/* all the files of one module name in the module search path index */
+typedef struct ncxmod_idx_name_t_ {
+    dlq_hdr_t          qhdr;
+    xmlChar           *modname;
+    dlq_hdr_t          fileQ;       /* Q of ncxmod_idx_file_t in seq order */
+} ncxmod_idx_name_t;
+
+
+/* index of one module search path directory tree,
+ * with the module files hashed by module name
+ */
+typedef struct ncxmod_idx_root_t_ {
+    dlq_hdr_t          qhdr;
+    xmlChar           *path;
+    ncxmod_idx_dir_t  *dir;
+    uint32             seq;              /* next entry seq number */
+    dlq_hdr_t          dirQ;            /* Q of ncxmod_idx_dir_t */
+    dlq_hdr_t          nameQ[NCXMOD_IDX_HASH_SIZE];  /* ncxmod_idx_name_t */
+} ncxmod_idx_root_t;
+
+
+/* header of a token cache file; the source filespec
+ * (not Z-terminated) follows it, then the saved token chain
+ * The entry is keyed by the size and a 64 bit hash of the
+ * source file contents, and the warn-linelen setting the
+ * recorded tokenizer warnings depend on
+ */
+typedef struct ncxmod_cache_hdr_t_ {
+    char     magic[4];
+    uint32   version;
+    uint32   pathlen;
+    uint32   warnlen;
+    int64    size;
+    uint32   hash[2];
+} ncxmod_cache_hdr_t;
+
+
 /********************************************************************
 *                                                                   *
 *                       V A R I A B L E S                           *
@@ -114,6 +200,18 @@ static xmlChar *ncxmod_run_path_cli;
 
 static boolean ncxmod_subdirs;
 
+static const xmlChar *ncxmod_modcache;
+
+static xmlChar *ncxmod_modcache_cli;
+
+static uint32 ncxmod_modcache_hits;
+
+static uint32 ncxmod_modcache_misses;
+
+static boolean ncxmod_use_index;
+
+static dlq_hdr_t ncxmod_indexQ;           /* Q of ncxmod_idx_root_t */
+
 
 /********************************************************************
 * FUNCTION is_yang_file
@@ -1147,34 +1245,685 @@ static status_t
             }
         }
 
-        if(*done==TRUE) {
-            if(revision != NULL) {
-                /*strict revision no need to keep going on checking if there is newer revision*/
-                dirdone = TRUE;
-            } else {
-                if(best_match==NULL) {
-                    best_match=strdup(buff);
-                } else {
-                    if(is_later_revision(buff,best_match)) {
-                        free(best_match);
-                        best_match=strdup(buff);
-                    }
-                }
-                *done=FALSE;
-            }
+        if(*done==TRUE) {
+            if(revision != NULL) {
+                /*strict revision no need to keep going on checking if there is newer revision*/
+                dirdone = TRUE;
+            } else {
+                if(best_match==NULL) {
+                    best_match=strdup(buff);
+                } else {
+                    if(is_later_revision(buff,best_match)) {
+                        free(best_match);
+                        best_match=strdup(buff);
+                    }
+                }
+                *done=FALSE;
+            }
+        }
+    }
+    if(best_match) {
+        *done=TRUE;
+        xml_strcpy(buff,best_match);
+        free(best_match);
+    }
+
+    (void)closedir(dp);
+
+    return res;
+
+}  /* search_subdirs */
+
+
+/********************************************************************
+* FUNCTION free_index_root
+*
+* Free a module search path index and all its dirs and files
+*
+* INPUTS:
+*    root == index root to free
+*********************************************************************/
+static void
+    free_index_root (ncxmod_idx_root_t *root)
+{
+    ncxmod_idx_name_t  *idxname;
+    ncxmod_idx_file_t  *file;
+    ncxmod_idx_dir_t   *dir;
+    uint32              i;
+
+    for (i = 0; i < NCXMOD_IDX_HASH_SIZE; i++) {
+        while (!dlq_empty(&root->nameQ[i])) {
+            idxname = (ncxmod_idx_name_t *)dlq_deque(&root->nameQ[i]);
+            while (!dlq_empty(&idxname->fileQ)) {
+                file = (ncxmod_idx_file_t *)dlq_deque(&idxname->fileQ);
+                if (file->relpath) {
+                    m__free(file->relpath);
+                }
+                m__free(file);
+            }
+            if (idxname->modname) {
+                m__free(idxname->modname);
+            }
+            m__free(idxname);
+        }
+    }
+    while (!dlq_empty(&root->dirQ)) {
+        dir = (ncxmod_idx_dir_t *)dlq_deque(&root->dirQ);
+        m__free(dir);
+    }
+    if (root->path) {
+        m__free(root->path);
+    }
+    m__free(root);
+
+}  /* free_index_root */
+
+
+/********************************************************************
+* FUNCTION get_stat_type
+*
+* Get the index type of a file, following symbolic links
+*
+* INPUTS:
+*    fspec == filespec to check
+*
+* RETURNS:
+*    index type for the file
+*********************************************************************/
+static ncxmod_idx_type_t
+    get_stat_type (const xmlChar *fspec)
+{
+    struct stat  statbuf;
+
+    memset(&statbuf, 0x0, sizeof(statbuf));
+    if (stat((const char *)fspec, &statbuf) != 0) {
+        return NCXMOD_IDX_OTHER;
+    }
+    if (S_ISREG(statbuf.st_mode)) {
+        return NCXMOD_IDX_REG;
+    }
+    if (S_ISDIR(statbuf.st_mode)) {
+        return NCXMOD_IDX_DIR;
+    }
+    return NCXMOD_IDX_OTHER;
+
+}  /* get_stat_type */
+
+
+/********************************************************************
+* FUNCTION find_index_name
+*
+* Find the files of a module name in a module search path index
+*
+* INPUTS:
+*    root == index root to check
+*    modname == module name to find
+*    modnamelen == length of modname to use
+*
+* RETURNS:
+*    pointer to the module name entry or NULL if not found
+*********************************************************************/
+static ncxmod_idx_name_t *
+    find_index_name (ncxmod_idx_root_t *root,
+                     const xmlChar *modname,
+                     uint32 modnamelen)
+{
+    ncxmod_idx_name_t  *idxname;
+    uint32              hash;
+
+    hash = (uint32)bobhash((const ub1 *)modname, (ub4)modnamelen, 0) &
+        NCXMOD_IDX_HASH_MASK;
+
+    for (idxname = (ncxmod_idx_name_t *)dlq_firstEntry(&root->nameQ[hash]);
+         idxname != NULL;
+         idxname = (ncxmod_idx_name_t *)dlq_nextEntry(idxname)) {
+        if (!xml_strncmp(idxname->modname, modname, modnamelen) &&
+            idxname->modname[modnamelen] == 0) {
+            return idxname;
+        }
+    }
+    return NULL;
+
+}  /* find_index_name */
+
+
+/********************************************************************
+* FUNCTION add_index_file
+*
+* Add a directory entry to the module search path index
+* if it is named like a YANG or YIN module file
+*
+* INPUTS:
+*    root == index root to add the file to
+*    dir == index directory of the entry
+*    relpath == path of the entry from the root dir
+*    seq == entry seq number
+*    dtyp == readdir type of the entry
+*    styp == stat type of the entry
+*
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    add_index_file (ncxmod_idx_root_t *root,
+                    ncxmod_idx_dir_t *dir,
+                    const xmlChar *relpath,
+                    uint32 seq,
+                    ncxmod_idx_type_t dtyp,
+                    ncxmod_idx_type_t styp)
+{
+    ncxmod_idx_name_t  *idxname;
+    ncxmod_idx_file_t  *file;
+    const xmlChar      *name, *str, *at;
+    uint32              namelen, modnamelen, hash;
+    boolean             isyang;
+
+    name = &relpath[ncxmod_get_pathlen_from_filespec(relpath)];
+    namelen = xml_strlen(name);
+
+    if (namelen > 5 && 
+        !xml_strcmp(&name[namelen - 5], (const xmlChar *)".yang")) {
+        isyang = TRUE;
+        namelen -= 5;
+    } else if (namelen > 4 &&
+               !xml_strcmp(&name[namelen - 4], (const xmlChar *)".yin")) {
+        isyang = FALSE;
+        namelen -= 4;
+    } else {
+        return NO_ERR;
+    }
+
+    /* the module name ends at the last '@' before the suffix */
+    at = NULL;
+    for (str = name; str < &name[namelen]; str++) {
+        if (*str == '@') {
+            at = str;
+        }
+    }
+    modnamelen = (at != NULL) ? (uint32)(at - name) : namelen;
+    if (modnamelen == 0) {
+        return NO_ERR;
+    }
+
+    idxname = find_index_name(root, name, modnamelen);
+    if (idxname == NULL) {
+        idxname = m__getObj(ncxmod_idx_name_t);
+        if (idxname == NULL) {
+            return ERR_INTERNAL_MEM;
+        }
+        memset(idxname, 0x0, sizeof(ncxmod_idx_name_t));
+        dlq_createSQue(&idxname->fileQ);
+        idxname->modname = xml_strndup(name, modnamelen);
+        if (idxname->modname == NULL) {
+            m__free(idxname);
+            return ERR_INTERNAL_MEM;
+        }
+        hash = (uint32)bobhash((const ub1 *)name, (ub4)modnamelen, 0) &
+            NCXMOD_IDX_HASH_MASK;
+        dlq_enque(idxname, &root->nameQ[hash]);
+    }
+
+    file = m__getObj(ncxmod_idx_file_t);
+    if (file == NULL) {
+        return ERR_INTERNAL_MEM;
+    }
+    memset(file, 0x0, sizeof(ncxmod_idx_file_t));
+    file->relpath = xml_strdup(relpath);
+    if (file->relpath == NULL) {
+        m__free(file);
+        return ERR_INTERNAL_MEM;
+    }
+    if (at != NULL) {
+        file->revision = &file->relpath[at - relpath];
+        file->revisionlen = namelen - modnamelen - 1;
+    }
+    file->dir = dir;
+    file->seq = seq;
+    file->dtyp = dtyp;
+    file->styp = styp;
+    file->isyang = isyang;
+    dlq_enque(file, &idxname->fileQ);
+    return NO_ERR;
+
+}  /* add_index_file */
+
+
+/********************************************************************
+* FUNCTION build_index_dir
+*
+* Read one directory and all the subdirs search_subdirs would
+* visit into a module search path index
+*
+* INPUTS:
+*    root == index root to fill
+*    dir == index directory for the path in buff
+*    buff == buffer containing the directory path;
+*            the subdir names are added to it and removed again
+*    bufflen == size of buff in bytes
+*    rootlen == length of the root dir path in buff
+*
+* RETURNS:
+*    status
+*********************************************************************/
+static status_t
+    build_index_dir (ncxmod_idx_root_t *root,
+                     ncxmod_idx_dir_t *dir,
+                     xmlChar *buff,
+                     uint32 bufflen,
+                     uint32 rootlen)
+{
+    ncxmod_idx_dir_t   *subdir;
+    ncxmod_idx_type_t   dtyp, styp;
+    DIR                *dp;
+    struct dirent      *ep;
+    uint32              pathlen, namelen, seq;
+    status_t            res;
+
+    pathlen = xml_strlen(buff);
+    if (pathlen + 1 >= bufflen) {
+        return ERR_BUFF_OVFL;
+    }
+    if (pathlen == 0 || buff[pathlen-1] != NCXMOD_PSCHAR) {
+        buff[pathlen++] = NCXMOD_PSCHAR;
+        buff[pathlen] = 0;
+    }
+    if (dir->parent == NULL) {
+        rootlen = pathlen;
+    }
+
+    dp = opendir((const char *)buff);
+    if (dp == NULL) {
+        return NO_ERR;
+    }
+
+    res = NO_ERR;
+    while (res == NO_ERR && (ep = readdir(dp)) != NULL) {
+        if (!strcmp(ep->d_name, ".") || !strcmp(ep->d_name, "..")) {
+            continue;
+        }
+
+        seq = root->seq++;
+        namelen = (uint32)strlen(ep->d_name);
+        if (pathlen + namelen >= bufflen) {
+            res = ERR_BUFF_OVFL;
+            continue;
+        }
+        strcpy((char *)&buff[pathlen], ep->d_name);
+
+        /* only stat the entries readdir cannot classify */
+        switch (ep->d_type) {
+        case DT_REG:
+            dtyp = styp = NCXMOD_IDX_REG;
+            break;
+        case DT_DIR:
+            dtyp = styp = NCXMOD_IDX_DIR;
+            break;
+        case DT_UNKNOWN:
+            dtyp = styp = get_stat_type(buff);
+            break;
+        default:
+            dtyp = NCXMOD_IDX_OTHER;
+            styp = get_stat_type(buff);
+        }
+
+        res = add_index_file(root, dir, &buff[rootlen], seq, dtyp, styp);
+
+        /* same subdir skip rules as search_subdirs */
+        if (res == NO_ERR &&
+            dtyp == NCXMOD_IDX_DIR && 
+            *ep->d_name != '.' &&
+            strcmp(ep->d_name, "CVS")) {
+            subdir = m__getObj(ncxmod_idx_dir_t);
+            if (subdir == NULL) {
+                res = ERR_INTERNAL_MEM;
+            } else {
+                memset(subdir, 0x0, sizeof(ncxmod_idx_dir_t));
+                subdir->parent = dir;
+                subdir->seq = seq;
+                dlq_enque(subdir, &root->dirQ);
+                res = build_index_dir(root, subdir, buff, bufflen, rootlen);
+            }
+        }
+        buff[pathlen] = 0;
+    }
+
+    (void)closedir(dp);
+    return res;
+
+}  /* build_index_dir */
+
+
+/********************************************************************
+* FUNCTION get_index_root
+*
+* Get the module search path index for a directory,
+* reading the directory tree if it is not indexed yet
+*
+* INPUTS:
+*    buff == buffer containing the directory path
+*    bufflen == size of buff in bytes
+*
+* RETURNS:
+*    pointer to index root or NULL if it could not be built
+*********************************************************************/
+static ncxmod_idx_root_t *
+    get_index_root (xmlChar *buff,
+                    uint32 bufflen)
+{
+    ncxmod_idx_root_t  *root;
+    xmlChar            *key, *str;
+    char                cwd[NCXMOD_MAX_FSPEC_LEN+1];
+    uint32              len, i;
+    status_t            res;
+
+    /* relative paths are indexed by the absolute path so 
+     * a change of the current directory is noticed
+     */
+    if (*buff == NCXMOD_PSCHAR) {
+        key = xml_strdup(buff);
+    } else {
+        if (getcwd(cwd, sizeof(cwd)) == NULL) {
+            return NULL;
+        }
+        len = (uint32)strlen(cwd) + xml_strlen(buff) + 2;
+        key = m__getMem(len);
+        if (key != NULL) {
+            str = key;
+            str += xml_strcpy(str, (const xmlChar *)cwd);
+            *str++ = NCXMOD_PSCHAR;
+            xml_strcpy(str, buff);
+        }
+    }
+    if (key == NULL) {
+        return NULL;
+    }
+
+    for (root = (ncxmod_idx_root_t *)dlq_firstEntry(&ncxmod_indexQ);
+         root != NULL;
+         root = (ncxmod_idx_root_t *)dlq_nextEntry(root)) {
+        if (!xml_strcmp(root->path, key)) {
+            m__free(key);
+            return root;
+        }
+    }
+
+    root = m__getObj(ncxmod_idx_root_t);
+    if (root == NULL) {
+        m__free(key);
+        return NULL;
+    }
+    memset(root, 0x0, sizeof(ncxmod_idx_root_t));
+    root->path = key;
+    dlq_createSQue(&root->dirQ);
+    for (i = 0; i < NCXMOD_IDX_HASH_SIZE; i++) {
+        dlq_createSQue(&root->nameQ[i]);
+    }
+
+    res = NO_ERR;
+    root->dir = m__getObj(ncxmod_idx_dir_t);
+    if (root->dir == NULL) {
+        res = ERR_INTERNAL_MEM;
+    } else {
+        memset(root->dir, 0x0, sizeof(ncxmod_idx_dir_t));
+        dlq_enque(root->dir, &root->dirQ);
+        len = xml_strlen(buff);
+        res = build_index_dir(root, root->dir, buff, bufflen, 0);
+        buff[len] = 0;
+    }
+    if (res != NO_ERR) {
+        log_debug("\nncxmod: index of '%s' failed (%s)",
+                  key,
+                  get_error_string(res));
+        free_index_root(root);
+        return NULL;
+    }
+
+    if (LOGDEBUG2) {
+        log_debug2("\nncxmod: indexed module dir '%s'", key);
+    }
+
+    dlq_enque(root, &ncxmod_indexQ);
+    return root;
+
+}  /* get_index_root */
+
+
+/********************************************************************
+* FUNCTION get_index_subdir
+*
+* Get the subdir of an index directory that holds a file
+*
+* INPUTS:
+*    dir == index directory to check
+*    filedir == index directory of the file
+*
+* RETURNS:
+*    pointer to the subdir of dir on the path to filedir
+*    or NULL if the file is not below dir
+*********************************************************************/
+static ncxmod_idx_dir_t *
+    get_index_subdir (const ncxmod_idx_dir_t *dir,
+                      ncxmod_idx_dir_t *filedir)
+{
+    while (filedir != NULL && filedir->parent != dir) {
+        filedir = filedir->parent;
+    }
+    return filedir;
+
+}  /* get_index_subdir */
+
+
+/********************************************************************
+* FUNCTION is_later_index_file
+*
+* Index version of is_later_revision
+*
+* INPUTS:
+*    file1 == file to check
+*    file2 == file to compare it to
+*
+* RETURNS:
+*    TRUE if file1 has no revision in the name or is newer
+*    FALSE if file1 is older
+*********************************************************************/
+static boolean
+    is_later_index_file (const ncxmod_idx_file_t *file1,
+                         const ncxmod_idx_file_t *file2)
+{
+    if (file1->revision == NULL) {
+        return TRUE;
+    }
+    if (file2->revision == NULL) {
+        return FALSE;
+    }
+    return (xml_strcmp(file1->revision, file2->revision) > 0) ? 
+        TRUE : FALSE;
+
+}  /* is_later_index_file */
+
+
+/********************************************************************
+* FUNCTION search_index_files
+*
+* Index version of search_subdirs
+* Only the files of one module name are checked; the files
+* and the subdirs that hold them are visited in the same order
+* and with the same rules as search_subdirs
+*
+* INPUTS:
+*    idxname == files of the module name
+*    dir == index directory to search
+*    revision == module revision string
+*    retfile == address of return file
+*
+* OUTPUTS:
+*   *retfile == file found
+* RETURNS:
+*    TRUE if a file was found; FALSE to keep going
+*********************************************************************/
+static boolean
+    search_index_files (ncxmod_idx_name_t *idxname,
+                        ncxmod_idx_dir_t *dir,
+                        const xmlChar *revision,
+                        ncxmod_idx_file_t **retfile)
+{
+    ncxmod_idx_file_t  *file, *nextfile, *subfile, *best;
+    ncxmod_idx_dir_t   *subdir, *nextdir;
+    uint32              revisionlen, seq, nextseq;
+
+    *retfile = NULL;
+    revisionlen = (revision != NULL) ? xml_strlen(revision) : 0;
+
+    /* check_module_in_dir: the exact file name, YANG first */
+    best = NULL;
+    for (file = (ncxmod_idx_file_t *)dlq_firstEntry(&idxname->fileQ);
+         file != NULL;
+         file = (ncxmod_idx_file_t *)dlq_nextEntry(file)) {
+        if (file->dir != dir || file->styp == NCXMOD_IDX_OTHER) {
+            continue;
+        }
+        if ((revision == NULL) ? (file->revision != NULL) :
+            (file->revision == NULL || file->revisionlen != revisionlen ||
+             xml_strncmp(&file->revision[1], revision, revisionlen))) {
+            continue;
+        }
+        if (file->isyang) {
+            *retfile = file;
+            return TRUE;
+        }
+        if (best == NULL) {
+            best = file;
+        }
+    }
+    if (best != NULL) {
+        *retfile = best;
+        return TRUE;
+    }
+
+    /* then the revision files and the subdirs in readdir order */
+    seq = 0;
+    for (;;) {
+        nextfile = NULL;
+        nextdir = NULL;
+        nextseq = NCX_MAX_UINT;
+
+        for (file = (ncxmod_idx_file_t *)dlq_firstEntry(&idxname->fileQ);
+             file != NULL;
+             file = (ncxmod_idx_file_t *)dlq_nextEntry(file)) {
+            if (file->dir == dir) {
+                if (file->seq < seq || file->seq >= nextseq ||
+                    file->dtyp != NCXMOD_IDX_REG ||
+                    file->revision == NULL || file->revisionlen != 10 ||
+                    (revision != NULL &&
+                     xml_strncmp(&file->revision[1], revision, 
+                                 revisionlen))) {
+                    continue;
+                }
+                nextfile = file;
+                nextdir = NULL;
+                nextseq = file->seq;
+            } else {
+                subdir = get_index_subdir(dir, file->dir);
+                if (subdir == NULL || subdir->seq < seq || 
+                    subdir->seq >= nextseq) {
+                    continue;
+                }
+                nextfile = NULL;
+                nextdir = subdir;
+                nextseq = subdir->seq;
+            }
+        }
+
+        if (nextfile != NULL) {
+            if (revision != NULL) {
+                *retfile = nextfile;
+                return TRUE;
+            }
+            if (best == NULL || is_later_index_file(nextfile, best)) {
+                best = nextfile;
+            }
+        } else if (nextdir != NULL) {
+            if (search_index_files(idxname, nextdir, revision, &subfile)) {
+                if (revision != NULL) {
+                    *retfile = subfile;
+                    return TRUE;
+                }
+                if (best == NULL || is_later_index_file(subfile, best)) {
+                    best = subfile;
+                }
+                break;
+            }
+        } else {
+            break;
+        }
+        seq = nextseq + 1;
+    }
+
+    *retfile = best;
+    return (best != NULL) ? TRUE : FALSE;
+
+}  /* search_index_files */
+
+
+/********************************************************************
+* FUNCTION search_index_root
+*
+* Find a module in a module search path index with one
+* lookup of the module name
+*
+* INPUTS:
+*    root == index root for the path in buff
+*    buff == buffer to use for filespec construction
+*            at the start it contains the path string to use
+*    bufflen == size of buff in bytes
+*    modname == module name
+*    revision == module revision string
+*    done == address of return search done flag
+*
+* OUTPUTS:
+*   *done == TRUE if done processing
+*            FALSE to keep going
+* RETURNS:
+*    NO_ERR if file found okay, full filespec in the 'buff' variable
+*    OR some error if not found or buffer overflow
+*********************************************************************/
+static status_t
+    search_index_root (ncxmod_idx_root_t *root,
+                       xmlChar *buff, 
+                       uint32 bufflen,
+                       const xmlChar *modname,
+                       const xmlChar *revision,
+                       boolean *done)
+{
+    ncxmod_idx_name_t  *idxname;
+    ncxmod_idx_file_t  *file;
+    uint32              pathlen;
+
+    *done = FALSE;
+
+    idxname = find_index_name(root, modname, xml_strlen(modname));
+    if (idxname == NULL ||
+        !search_index_files(idxname, root->dir, revision, &file)) {
+        return NO_ERR;
+    }
+
+    *done = TRUE;
+    pathlen = xml_strlen(buff);
+    if (pathlen == 0 || buff[pathlen-1] != NCXMOD_PSCHAR) {
+        if (pathlen + 1 >= bufflen) {
+            return ERR_BUFF_OVFL;
         }
+        buff[pathlen++] = NCXMOD_PSCHAR;
     }
-    if(best_match) {
-        *done=TRUE;
-        xml_strcpy(buff,best_match);
-        free(best_match);
+    if (pathlen + xml_strlen(file->relpath) >= bufflen) {
+        buff[pathlen] = 0;
+        return ERR_BUFF_OVFL;
     }
+    xml_strcpy(&buff[pathlen], file->relpath);
 
-    (void)closedir(dp);
-
-    return res;
+    return (file->styp == NCXMOD_IDX_REG) ? NO_ERR : ERR_FIL_BAD_FILENAME;
 
-}  /* search_subdirs */
+}  /* search_index_root */
 
 /********************************************************************
 * FUNCTION list_subdirs
@@ -1527,9 +2276,10 @@ static status_t
                        boolean usepath,
                        boolean *done)
 {
-    const xmlChar  *path2;
-    uint32          total;
-    status_t        res, res2;
+    const xmlChar     *path2;
+    ncxmod_idx_root_t *root;
+    uint32            total;
+    status_t          res, res2;
 
     *done = FALSE;
     res = NO_ERR;
@@ -1552,8 +2302,17 @@ static status_t
             return res;
         }
 
-        /* try YANG or YIN file */
-        res = search_subdirs(buff, bufflen, modname, revision, done);
+        /* try YANG or YIN file, using the directory index if enabled;
+         * the alt_path is a temp dir that is not indexed
+         */
+        root = (ncxmod_use_index && path != ncxmod_alt_path) ?
+            get_index_root(buff, bufflen) : NULL;
+        if (root != NULL) {
+            res = search_index_root(root, buff, bufflen, modname, 
+                                    revision, done);
+        } else {
+            res = search_subdirs(buff, bufflen, modname, revision, done);
+        }
         if (*done ) {
         }
         return (res != NO_ERR) ? res : res2;
@@ -2094,7 +2853,7 @@ static status_t
 } /* load_module */
 
 /********************************************************************
-* FUNCTION ncxmod123_find_module_filespec
+* FUNCTION find_module_filespec
 *
 * Determine the location of the specified module
 *
@@ -2115,7 +2874,9 @@ static status_t
 *   containing the path
 *
 *********************************************************************/
-xmlChar* ncxmod123_find_module_filespec(const xmlChar *modname, const xmlChar *revision)
+static xmlChar *
+    find_module_filespec (const xmlChar *modname,
+                          const xmlChar *revision)
 {
     xmlChar        *buff;
     uint32          bufflen = 0;
@@ -2204,6 +2965,46 @@ xmlChar* ncxmod123_find_module_filespec(const xmlChar *modname, const xmlChar *r
         free(buff);
         return NULL;
     }
+} /* find_module_filespec */
+
+
+/********************************************************************
+* FUNCTION ncxmod123_find_module_filespec
+*
+* Determine the location of the specified module
+*
+* Module Search order:
+*   1) current directory
+*   2) YUMA_MODPATH environment var (or set by modpath CLI var)
+*   3) HOME/modules directory
+*   4) YUMA_HOME/modules directory
+*   5) YUMA_INSTALL/modules directory OR
+*   6) default install module location, which is '/usr/share/yuma/modules'
+*
+* The directory index is refreshed and the search repeated
+* once if the module is not found, so files added since the
+* index was built are found
+*
+* INPUTS:
+*   modname == module name with no path prefix or file extension
+*   revision == optional revision date of 'modname' to find
+**
+* RETURNS:
+*   NULL if no match was found or pointer to allocated string
+*   containing the path
+*
+*********************************************************************/
+xmlChar* ncxmod123_find_module_filespec(const xmlChar *modname, const xmlChar *revision)
+{
+    xmlChar  *buff;
+
+    buff = find_module_filespec(modname, revision);
+    if (buff == NULL && !dlq_empty(&ncxmod_indexQ)) {
+        ncxmod_clear_module_index();
+        buff = find_module_filespec(modname, revision);
+    }
+    return buff;
+
 } /* ncxmod123_find_module_filespec */
 
 
@@ -2739,6 +3540,111 @@ static status_t
 }  /* search_subtree_callback */
 
 
+/********************************************************************
+* FUNCTION make_cache_filespec
+*
+* Construct the token cache filespec for a module source file
+* The cache file name is the source file name plus a hash
+* of the complete source filespec, so files with the same
+* name in different directories do not share a cache entry
+*
+* INPUTS:
+*   filespec == complete source filespec
+*
+* RETURNS:
+*   malloced cache filespec or NULL if malloc failed
+*********************************************************************/
+static xmlChar *
+    make_cache_filespec (const xmlChar *filespec)
+{
+    const xmlChar  *fname;
+    xmlChar        *buff;
+    uint32          len, hash;
+
+    len = xml_strlen(filespec);
+    hash = (uint32)bobhash((const ub1 *)filespec, (ub4)len, 0);
+
+    fname = &filespec[ncxmod_get_pathlen_from_filespec(filespec)];
+
+    len = xml_strlen(ncxmod_modcache) + xml_strlen(fname) + 16 +
+        xml_strlen((const xmlChar *)NCXMOD_CACHE_SUFFIX);
+    buff = m__getMem(len);
+    if (buff == NULL) {
+        return NULL;
+    }
+    snprintf((char *)buff, len, "%s%c%s.%08x.%s",
+             (const char *)ncxmod_modcache,
+             NCXMOD_PSCHAR,
+             (const char *)fname,
+             hash,
+             NCXMOD_CACHE_SUFFIX);
+    return buff;
+
+}  /* make_cache_filespec */
+
+
+/********************************************************************
+* FUNCTION make_cache_hdr
+*
+* Fill in a token cache file header for a module source file
+* The source file is mapped to hash its contents, so an
+* entry is never used for a file that changed without
+* a change in its size or modification time
+*
+* INPUTS:
+*   filespec == complete source filespec
+*   hdr == header to fill in
+*
+* RETURNS:
+*   status; ERR_NCX_MISSING_FILE if the source file is not found
+*********************************************************************/
+static status_t
+    make_cache_hdr (const xmlChar *filespec,
+                    ncxmod_cache_hdr_t *hdr)
+{
+    struct stat  statbuf;
+    void        *mapbuff;
+    int          fd;
+
+    fd = open((const char *)filespec, O_RDONLY);
+    if (fd < 0) {
+        return ERR_NCX_MISSING_FILE;
+    }
+
+    memset(&statbuf, 0x0, sizeof(statbuf));
+    if (fstat(fd, &statbuf) != 0 || !S_ISREG(statbuf.st_mode)) {
+        close(fd);
+        return ERR_NCX_MISSING_FILE;
+    }
+
+    memset(hdr, 0x0, sizeof(ncxmod_cache_hdr_t));
+    memcpy(hdr->magic, NCXMOD_CACHE_MAGIC, sizeof(hdr->magic));
+    hdr->version = NCXMOD_CACHE_VERSION;
+    hdr->pathlen = xml_strlen(filespec);
+    hdr->warnlen = ncx_get_warn_linelen();
+    hdr->size = (int64)statbuf.st_size;
+
+    if (statbuf.st_size > 0) {
+        mapbuff = mmap(NULL, (size_t)statbuf.st_size, PROT_READ,
+                       MAP_PRIVATE, fd, 0);
+        if (mapbuff == MAP_FAILED) {
+            close(fd);
+            return ERR_FIL_READ;
+        }
+        hdr->hash[0] = (uint32)bobhash((const ub1 *)mapbuff, 
+                                       (ub4)statbuf.st_size, 0);
+        hdr->hash[1] = (uint32)bobhash((const ub1 *)mapbuff, 
+                                       (ub4)statbuf.st_size, 
+                                       hdr->hash[0]);
+        (void)munmap(mapbuff, (size_t)statbuf.st_size);
+    }
+
+    close(fd);
+    return NO_ERR;
+
+}  /* make_cache_hdr */
+
+
 /**************    E X T E R N A L   F U N C T I O N S **********/
 
 
@@ -2802,6 +3708,19 @@ status_t
 
     ncxmod_subdirs = TRUE;
 
+    /* try to get the YANG token cache directory variable */
+    ncxmod_modcache = (const xmlChar *)getenv(NCXMOD_MODCACHE);
+
+    ncxmod_modcache_cli = NULL;
+
+    ncxmod_modcache_hits = 0;
+
+    ncxmod_modcache_misses = 0;
+
+    ncxmod_use_index = TRUE;
+
+    dlq_createSQue(&ncxmod_indexQ);
+
     ncxmod_init_done = TRUE;
 
     return res;
@@ -2825,6 +3744,8 @@ void
     }
 #endif
      
+    ncxmod_clear_module_index();
+
     ncxmod_yuma_home = NULL;
     ncxmod_env_install = NULL;
     ncxmod_home = NULL;
@@ -2856,6 +3777,19 @@ void
         m__free(ncxmod_run_path_cli);
     }
 
+    if (ncxmod_modcache_hits || ncxmod_modcache_misses) {
+        log_debug("\nncxmod: token cache hits: %u misses: %u",
+                  ncxmod_modcache_hits,
+                  ncxmod_modcache_misses);
+    }
+
+    ncxmod_modcache = NULL;
+
+    if (ncxmod_modcache_cli) {
+        m__free(ncxmod_modcache_cli);
+        ncxmod_modcache_cli = NULL;
+    }
+
     ncxmod_init_done = FALSE;
     
 }  /* ncxmod_cleanup */
@@ -6028,4 +6962,287 @@ uint32
 }  /* ncxmod_get_pathlen_from_filespec */
 
 
+
+/********************************************************************
+* FUNCTION ncxmod_set_modcache
+* 
+*   Override the YUMA_MODCACHE env var with the module-cache CLI var
+*
+* INPUTS:
+*   modcache == directory to store YANG token cache files
+*            == NULL or empty string to disable the cache
+*********************************************************************/
+void
+    ncxmod_set_modcache (const xmlChar *modcache)
+{
+    if (ncxmod_modcache_cli) {
+        m__free(ncxmod_modcache_cli);
+        ncxmod_modcache_cli = NULL;
+    }
+
+    if (modcache && *modcache) {
+        /* ignoring possible malloc failed!! */
+        ncxmod_modcache_cli = xml_strdup(modcache);
+    }
+    ncxmod_modcache = ncxmod_modcache_cli;
+
+}  /* ncxmod_set_modcache */
+
+
+/********************************************************************
+* FUNCTION ncxmod_get_modcache
+* 
+*   Get the YANG token cache directory being used
+*
+* RETURNS:
+*   pointer to the cache dir string or NULL if the cache is disabled
+*********************************************************************/
+const xmlChar *
+    ncxmod_get_modcache (void)
+{
+    return ncxmod_modcache;
+
+}  /* ncxmod_get_modcache */
+
+
+/********************************************************************
+* FUNCTION ncxmod_load_token_cache
+* 
+*   Fill a token chain from the token cache entry for
+*   a YANG source file, instead of tokenizing the file again.
+*   The entry is only used if the source file path, size
+*   and content hash all match the saved values.
+*   The tokenizer warnings saved with the entry are
+*   printed again.
+*
+* INPUTS:
+*   filespec == complete source filespec
+*   tkc == empty token chain to fill
+*   mod == module in progress (used in warning messages only)
+*
+* RETURNS:
+*   NO_ERR if the chain was filled from the cache
+*   ERR_NCX_SKIPPED if the cache is disabled or has no valid entry
+*   some other error if the entry is corrupted
+*********************************************************************/
+status_t
+    ncxmod_load_token_cache (const xmlChar *filespec,
+                             tk_chain_t *tkc,
+                             ncx_module_t *mod)
+{
+    ncxmod_cache_hdr_t  hdr, filehdr;
+    xmlChar            *cachespec, *pathbuff;
+    FILE               *fp;
+    status_t            res;
+
+#ifdef DEBUG
+    if (!filespec || !tkc) {
+        return SET_ERROR(ERR_INTERNAL_PTR);
+    }
+#endif
+
+    if (ncxmod_modcache == NULL || TK_DOCMODE(tkc)) {
+        return ERR_NCX_SKIPPED;
+    }
+
+    res = make_cache_hdr(filespec, &hdr);
+    if (res != NO_ERR) {
+        return ERR_NCX_SKIPPED;
+    }
+
+    cachespec = make_cache_filespec(filespec);
+    if (cachespec == NULL) {
+        return ERR_INTERNAL_MEM;
+    }
+
+    fp = fopen((const char *)cachespec, "r");
+    if (fp == NULL) {
+        ncxmod_modcache_misses++;
+        m__free(cachespec);
+        return ERR_NCX_SKIPPED;
+    }
+
+    res = ERR_NCX_SKIPPED;
+    pathbuff = NULL;
+    if (fread(&filehdr, sizeof(filehdr), 1, fp) == 1 &&
+        !memcmp(&filehdr, &hdr, sizeof(hdr))) {
+        pathbuff = m__getMem(hdr.pathlen+1);
+        if (pathbuff == NULL) {
+            res = ERR_INTERNAL_MEM;
+        } else if (fread(pathbuff, hdr.pathlen, 1, fp) == 1) {
+            pathbuff[hdr.pathlen] = 0;
+            if (!xml_strcmp(pathbuff, filespec)) {
+                res = tk_load_chain(tkc, fp);
+            }
+        }
+    }
+
+    if (res == NO_ERR) {
+        ncxmod_modcache_hits++;
+        if (LOGDEBUG2) {
+            log_debug2("\nncxmod: using token cache '%s'", cachespec);
+        }
+        ncx_print_tk_warnings(tkc, mod);
+    } else {
+        ncxmod_modcache_misses++;
+        if (res != ERR_NCX_SKIPPED) {
+            log_warn("\nWarning: ignoring invalid token cache '%s' (%s)",
+                     cachespec,
+                     get_error_string(res));
+            res = ERR_NCX_SKIPPED;
+        }
+    }
+
+    if (pathbuff != NULL) {
+        m__free(pathbuff);
+    }
+    fclose(fp);
+    m__free(cachespec);
+    return res;
+
+}  /* ncxmod_load_token_cache */
+
+
+/********************************************************************
+* FUNCTION ncxmod_save_token_cache
+* 
+*   Save the token chain for a YANG source file in the token cache
+*   The cache file is written to a temp file first and renamed,
+*   so concurrent readers never see a partial entry.
+*   Errors are not fatal; the module just does not get cached.
+*
+* INPUTS:
+*   filespec == complete source filespec
+*   tkc == token chain filled in from the source file
+*********************************************************************/
+void
+    ncxmod_save_token_cache (const xmlChar *filespec,
+                             const tk_chain_t *tkc)
+{
+    ncxmod_cache_hdr_t  hdr;
+    xmlChar            *cachespec, *tempspec;
+    FILE               *fp;
+    status_t            res;
+    uint32              len;
+
+#ifdef DEBUG
+    if (!filespec || !tkc) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    if (ncxmod_modcache == NULL || TK_DOCMODE(tkc)) {
+        return;
+    }
+
+    if (make_cache_hdr(filespec, &hdr) != NO_ERR) {
+        return;
+    }
+
+    if (mkdir((const char *)ncxmod_modcache, S_IRWXU) != 0 &&
+        errno != EEXIST) {
+        log_warn("\nWarning: cannot create token cache dir '%s' (%s)",
+                 ncxmod_modcache,
+                 strerror(errno));
+        return;
+    }
+
+    cachespec = make_cache_filespec(filespec);
+    if (cachespec == NULL) {
+        return;
+    }
+
+    len = xml_strlen(cachespec) + 16;
+    tempspec = m__getMem(len);
+    if (tempspec == NULL) {
+        m__free(cachespec);
+        return;
+    }
+    snprintf((char *)tempspec, len, "%s.%u", 
+             (const char *)cachespec, 
+             (uint32)getpid());
+
+    res = NO_ERR;
+    fp = fopen((const char *)tempspec, "w");
+    if (fp == NULL) {
+        res = ERR_FIL_OPEN;
+    } else {
+        if (fwrite(&hdr, sizeof(hdr), 1, fp) != 1 ||
+            fwrite(filespec, hdr.pathlen, 1, fp) != 1) {
+            res = ERR_FIL_WRITE;
+        } else {
+            res = tk_save_chain(tkc, fp);
+        }
+        if (fclose(fp) != 0 && res == NO_ERR) {
+            res = ERR_FIL_WRITE;
+        }
+    }
+
+    if (res == NO_ERR &&
+        rename((const char *)tempspec, (const char *)cachespec) != 0) {
+        res = ERR_FIL_WRITE;
+    }
+
+    if (res == NO_ERR) {
+        if (LOGDEBUG2) {
+            log_debug2("\nncxmod: saved token cache '%s'", cachespec);
+        }
+    } else {
+        log_warn("\nWarning: cannot write token cache '%s' (%s)",
+                 cachespec,
+                 get_error_string(res));
+        (void)unlink((const char *)tempspec);
+    }
+
+    m__free(tempspec);
+    m__free(cachespec);
+
+}  /* ncxmod_save_token_cache */
+
+
+/********************************************************************
+* FUNCTION ncxmod_set_module_index
+*
+*  Enable or disable the module search path directory index
+*  Disabling the index also clears it
+*
+* INPUTS:
+*    use_index == TRUE to search the index instead of the
+*                 module directories (default)
+*                 FALSE to read the directories on each search
+*********************************************************************/
+void
+    ncxmod_set_module_index (boolean use_index)
+{
+    ncxmod_use_index = use_index;
+    if (!use_index) {
+        ncxmod_clear_module_index();
+    }
+
+}  /* ncxmod_set_module_index */
+
+
+/********************************************************************
+* FUNCTION ncxmod_clear_module_index
+*
+*  Clear the module search path directory index
+*  The directories are read again on the next module search
+*  Must be called after modules are removed or renamed in
+*  a search path directory while the program is running
+*********************************************************************/
+void
+    ncxmod_clear_module_index (void)
+{
+    ncxmod_idx_root_t  *root;
+
+    while (!dlq_empty(&ncxmod_indexQ)) {
+        root = (ncxmod_idx_root_t *)dlq_deque(&ncxmod_indexQ);
+        free_index_root(root);
+    }
+
+}  /* ncxmod_clear_module_index */
+
+
+
 /* END file ncxmod.c */
@@ -164,6 +164,9 @@ extern "C" {
 /* NCX Environment Variable for SCRIPTS search path */
 #define NCXMOD_RUNPATH      "YUMA_RUNPATH"
 
+/* NCX Environment Variable for the YANG token cache directory */
+#define NCXMOD_MODCACHE      "YUMA_MODCACHE"
+
 /* per user yangcli internal data home when $HOME defined */
 #define NCXMOD_YUMA_DIR (const xmlChar *)"~/.yuma"
 
@@ -1356,6 +1359,100 @@ extern uint32
 extern xmlChar*
     ncxmod123_find_module_filespec(const xmlChar *modname, const xmlChar *revision);
 
+
+/********************************************************************
+* FUNCTION ncxmod_set_modcache
+* 
+*   Override the YUMA_MODCACHE env var with the module-cache CLI var
+*
+* INPUTS:
+*   modcache == directory to store YANG token cache files
+*            == NULL or empty string to disable the cache
+*********************************************************************/
+extern void
+    ncxmod_set_modcache (const xmlChar *modcache);
+
+
+/********************************************************************
+* FUNCTION ncxmod_get_modcache
+* 
+*   Get the YANG token cache directory being used
+*
+* RETURNS:
+*   pointer to the cache dir string or NULL if the cache is disabled
+*********************************************************************/
+extern const xmlChar *
+    ncxmod_get_modcache (void);
+
+
+/********************************************************************
+* FUNCTION ncxmod_load_token_cache
+* 
+*   Fill a token chain from the token cache entry for
+*   a YANG source file, instead of tokenizing the file again.
+*   The entry is only used if the source file path, size
+*   and content hash all match the saved values.
+*   The tokenizer warnings saved with the entry are
+*   printed again.
+*
+* INPUTS:
+*   filespec == complete source filespec
+*   tkc == empty token chain to fill
+*   mod == module in progress (used in warning messages only)
+*
+* RETURNS:
+*   NO_ERR if the chain was filled from the cache
+*   ERR_NCX_SKIPPED if the cache is disabled or has no valid entry
+*   some other error if the entry is corrupted
+*********************************************************************/
+extern status_t
+    ncxmod_load_token_cache (const xmlChar *filespec,
+                             tk_chain_t *tkc,
+                             ncx_module_t *mod);
+
+
+/********************************************************************
+* FUNCTION ncxmod_save_token_cache
+* 
+*   Save the token chain for a YANG source file in the token cache
+*   The cache file is written to a temp file first and renamed,
+*   so concurrent readers never see a partial entry.
+*   Errors are not fatal; the module just does not get cached.
+*
+* INPUTS:
+*   filespec == complete source filespec
+*   tkc == token chain filled in from the source file
+*********************************************************************/
+extern void
+    ncxmod_save_token_cache (const xmlChar *filespec,
+                             const tk_chain_t *tkc);
+
+
+/********************************************************************
+* FUNCTION ncxmod_set_module_index
+*
+*  Enable or disable the module search path directory index
+*  Disabling the index also clears it
+*
+* INPUTS:
+*    use_index == TRUE to search the index instead of the
+*                 module directories (default)
+*                 FALSE to read the directories on each search
+*********************************************************************/
+extern void
+    ncxmod_set_module_index (boolean use_index);
+
+
+/********************************************************************
+* FUNCTION ncxmod_clear_module_index
+*
+*  Clear the module search path directory index
+*  The directories are read again on the next module search
+*********************************************************************/
+extern void
+    ncxmod_clear_module_index (void);
+
+
 #ifdef __cplusplus
 }  /* end extern 'C' */
 #endif
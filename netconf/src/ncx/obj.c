@@ -75,6 +75,11 @@ static obj_template_t* find_template( dlq_hdr_t*que, const xmlChar *modname,
                                       boolean altnames, boolean dataonly, 
                                       uint32 *matchcount );
 
+/* number of cloned objects sharing the descr and ref strings
+ * of their clone source, and the string bytes not copied */
+static uint32 obj_textclone_count;
+static uint64 obj_textclone_bytes;
+
 /********************************************************************
 * FUNCTION find_type_in_grpchain
 * 
@@ -131,6 +136,7 @@ static void init_template (obj_template_t *obj)
     dlq_createSQue(&obj->inherited_whenQ);
     dlq_createSQue(&obj->cbsetQ);
     obj->rpc_cbset=NULL;
+    obj->vcachetime = -1;    /* VAL_VIRTUAL_CACHE_DEFAULT */
 
 }  /* init_template */
 
@@ -376,6 +382,76 @@ static status_t
 }  /* clone_iffeatureQ */
 
 
+/********************************************************************
+* FUNCTION clone_text
+* 
+* Set the description and reference strings in a cloned object.
+* If neither one is refined then the clone points at the
+* strings in the source object instead of copying them.
+* Otherwise both strings are malloced for the clone
+*
+* INPUTS:
+*    newdescr == address of descr field in the new struct
+*    newref == address of ref field in the new struct
+*    textclone == address of textclone field in the new struct
+*    descr == description in the source struct (may be NULL)
+*    ref == reference in the source struct (may be NULL)
+*    mref == obj_refine_t data structure to merge (may be NULL)
+*
+* OUTPUTS:
+*    *newdescr, *newref, *textclone set
+*
+* RETURNS:
+*   status
+*********************************************************************/
+static status_t
+    clone_text (xmlChar **newdescr,
+                xmlChar **newref,
+                boolean *textclone,
+                xmlChar *descr,
+                xmlChar *ref,
+                const obj_refine_t *mref)
+{
+    if (!mref || (!mref->descr && !mref->ref)) {
+        *newdescr = descr;
+        *newref = ref;
+        *textclone = TRUE;
+        if (descr || ref) {
+            obj_textclone_count++;
+            if (descr) {
+                obj_textclone_bytes += xml_strlen(descr) + 1;
+            }
+            if (ref) {
+                obj_textclone_bytes += xml_strlen(ref) + 1;
+            }
+        }
+        return NO_ERR;
+    }
+
+    if (mref->descr) {
+        descr = mref->descr;
+    }
+    if (mref->ref) {
+        ref = mref->ref;
+    }
+
+    if (descr) {
+        *newdescr = xml_strdup(descr);
+        if (!*newdescr) {
+            return ERR_INTERNAL_MEM;
+        }
+    }
+    if (ref) {
+        *newref = xml_strdup(ref);
+        if (!*newref) {
+            return ERR_INTERNAL_MEM;
+        }
+    }
+    return NO_ERR;
+
+}  /* clone_text */
+
+
 /********************************************************************
 * FUNCTION clone_case
 * 
@@ -417,32 +493,11 @@ static obj_case_t *
     newcas->nameclone = TRUE;
     newcas->status = cas->status;
 
-    if (mcas && mcas->descr) {
-        newcas->descr = xml_strdup(mcas->descr);
-        if (!newcas->descr) {
-            free_case(newcas);
-            return NULL;
-        }
-    } else if (cas->descr) {
-        newcas->descr = xml_strdup(cas->descr);
-        if (!newcas->descr) {
-            free_case(newcas);
-            return NULL;
-        }
-    }
-
-    if (mcas && mcas->ref) {
-        newcas->ref = xml_strdup(mcas->ref);
-        if (!newcas->ref) {
-            free_case(newcas);
-            return NULL;
-        }
-    } else if (cas->ref) {
-        newcas->ref = xml_strdup(cas->ref);
-        if (!newcas->ref) {
-            free_case(newcas);
-            return NULL;
-        }
+    res = clone_text(&newcas->descr, &newcas->ref, &newcas->textclone,
+                     cas->descr, cas->ref, mcas);
+    if (res != NO_ERR) {
+        free_case(newcas);
+        return NULL;
     }
 
     res = clone_datadefQ(mod, 
@@ -582,8 +637,10 @@ static void free_container ( obj_container_t *con, uint32 flags )
         m__free(con->name);
     }
 
-    m__free(con->descr);
-    m__free(con->ref);
+    if (!con->textclone) {
+        m__free(con->descr);
+        m__free(con->ref);
+    }
     m__free(con->presence);
 
     if (notclone) {
@@ -646,32 +703,11 @@ static obj_container_t *
     newcon->status = con->status;
 
 
-    if (mcon && mcon->descr) {
-        newcon->descr = xml_strdup(mcon->descr);
-        if (!newcon->descr) {
-            free_container(newcon, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (con->descr) {
-        newcon->descr = xml_strdup(con->descr);
-        if (!newcon->descr) {
-            free_container(newcon, OBJ_FL_CLONE);
-            return NULL;
-        }
-    }
-
-    if (mcon && mcon->ref) {
-        newcon->ref = xml_strdup(mcon->ref);
-        if (!newcon->ref) {
-            free_container(newcon, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (con->ref) {
-        newcon->ref = xml_strdup(con->ref);
-        if (!newcon->ref) {
-            free_container(newcon, OBJ_FL_CLONE);
-            return NULL;
-        }
+    res = clone_text(&newcon->descr, &newcon->ref, &newcon->textclone,
+                     con->descr, con->ref, mcon);
+    if (res != NO_ERR) {
+        free_container(newcon, OBJ_FL_CLONE);
+        return NULL;
     }
 
     if (mcon && mcon->presence) {
@@ -768,8 +804,10 @@ static void free_leaf (obj_leaf_t *leaf, uint32 flags)
     boolean notclone = (flags & OBJ_FL_CLONE) ? FALSE : TRUE;
 
     m__free(leaf->defval);
-    m__free(leaf->descr);
-    m__free(leaf->ref);
+    if (!leaf->textclone) {
+        m__free(leaf->descr);
+        m__free(leaf->ref);
+    }
 
     if (notclone ) {
         m__free(leaf->name);
@@ -833,32 +871,11 @@ static obj_leaf_t *
         }
     }
 
-    if (mleaf && mleaf->descr) {
-        newleaf->descr = xml_strdup(mleaf->descr);
-        if (!newleaf->descr) {
-            free_leaf(newleaf, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (leaf->descr) {
-        newleaf->descr = xml_strdup(leaf->descr);
-        if (!newleaf->descr) {
-            free_leaf(newleaf, OBJ_FL_CLONE);
-            return NULL;
-        }
-    }
-
-    if (mleaf && mleaf->ref) {
-        newleaf->ref = xml_strdup(mleaf->ref);
-        if (!newleaf->ref) {
-            free_leaf(newleaf, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (leaf->ref) {
-        newleaf->ref = xml_strdup(leaf->ref);
-        if (!newleaf->ref) {
-            free_leaf(newleaf, OBJ_FL_CLONE);
-            return NULL;
-        }
+    res = clone_text(&newleaf->descr, &newleaf->ref, &newleaf->textclone,
+                     leaf->descr, leaf->ref, mleaf);
+    if (res != NO_ERR) {
+        free_leaf(newleaf, OBJ_FL_CLONE);
+        return NULL;
     }
 
     res = clone_mustQ(&newleaf->mustQ, 
@@ -1017,8 +1034,10 @@ static void free_leaflist (obj_leaflist_t *leaflist, uint32 flags)
         typ_free_typdef(leaflist->typdef);
     }
 
-    m__free(leaflist->descr);
-    m__free(leaflist->ref);
+    if (!leaflist->textclone) {
+        m__free(leaflist->descr);
+        m__free(leaflist->ref);
+    }
 
     if (leaflist->defvalsQ)
         clean_defvalsQ(leaflist->defvalsQ);
@@ -1064,32 +1083,12 @@ static obj_leaflist_t *
     newleaflist->ordersys = leaflist->ordersys;
     newleaflist->status = leaflist->status;
 
-    if (mleaflist && mleaflist->descr) {
-        newleaflist->descr = xml_strdup(mleaflist->descr);
-        if (!newleaflist->descr) {
-            free_leaflist(newleaflist, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (leaflist->descr) {
-        newleaflist->descr = xml_strdup(leaflist->descr);
-        if (!newleaflist->descr) {
-            free_leaflist(newleaflist, OBJ_FL_CLONE);
-            return NULL;
-        }
-    }
-
-    if (mleaflist && mleaflist->ref) {
-        newleaflist->ref = xml_strdup(mleaflist->ref);
-        if (!newleaflist->ref) {
-            free_leaflist(newleaflist, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (leaflist->ref) {
-        newleaflist->ref = xml_strdup(leaflist->ref);
-        if (!newleaflist->ref) {
-            free_leaflist(newleaflist, OBJ_FL_CLONE);
-            return NULL;
-        }
+    res = clone_text(&newleaflist->descr, &newleaflist->ref,
+                     &newleaflist->textclone,
+                     leaflist->descr, leaflist->ref, mleaflist);
+    if (res != NO_ERR) {
+        free_leaflist(newleaflist, OBJ_FL_CLONE);
+        return NULL;
     }
 
     res = clone_mustQ(&newleaflist->mustQ, &leaflist->mustQ,
@@ -1176,8 +1175,10 @@ static void free_list( obj_list_t *list, uint32 flags)
 
     boolean notclone = (flags & OBJ_FL_CLONE) ? FALSE : TRUE;
 
-    m__free(list->descr);
-    m__free(list->ref);
+    if (!list->textclone) {
+        m__free(list->descr);
+        m__free(list->ref);
+    }
     free_keyQ( &list->keyQ );
     free_uniqueQ( &list->uniqueQ );
 
@@ -1304,32 +1305,11 @@ static obj_list_t *
     newlist->ordersys = list->ordersys;
     newlist->status = list->status;
 
-    if (mlist && mlist->descr) {
-        newlist->descr = xml_strdup(mlist->descr);
-        if (!newlist->descr) {
-            free_list(newlist, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (list->descr) {
-        newlist->descr = xml_strdup(list->descr);
-        if (!newlist->descr) {
-            free_list(newlist, OBJ_FL_CLONE);
-            return NULL;
-        }
-    }
-
-    if (mlist && mlist->ref) {
-        newlist->ref = xml_strdup(mlist->ref);
-        if (!newlist->ref) {
-            free_list(newlist, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (list->ref) {
-        newlist->ref = xml_strdup(list->ref);
-        if (!newlist->ref) {
-            free_list(newlist, OBJ_FL_CLONE);
-            return NULL;
-        }
+    res = clone_text(&newlist->descr, &newlist->ref, &newlist->textclone,
+                     list->descr, list->ref, mlist);
+    if (res != NO_ERR) {
+        free_list(newlist, OBJ_FL_CLONE);
+        return NULL;
     }
 
     res = clone_mustQ(&newlist->mustQ, 
@@ -1429,8 +1409,10 @@ static void free_case (obj_case_t *cas)
         m__free(cas->name);
     }
 
-    m__free(cas->descr);
-    m__free(cas->ref);
+    if (!cas->textclone) {
+        m__free(cas->descr);
+        m__free(cas->ref);
+    }
 
     if (!cas->datadefclone) {
         obj_clean_datadefQ(cas->datadefQ);
@@ -1499,8 +1481,10 @@ static void free_choice (obj_choice_t *choic, uint32 flags)
     }
 
     m__free(choic->defval);
-    m__free(choic->descr);
-    m__free(choic->ref);
+    if (!choic->textclone) {
+        m__free(choic->descr);
+        m__free(choic->ref);
+    }
 
     if ( !choic->caseQclone ) {
         obj_clean_datadefQ(choic->caseQ);
@@ -1563,32 +1547,11 @@ static obj_choice_t *
         }
     }
 
-    if (mchoic && mchoic->descr) {
-        newchoic->descr = xml_strdup(mchoic->descr);
-        if (!newchoic->descr) {
-            free_choice(newchoic, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (choic->descr) {
-        newchoic->descr = xml_strdup(choic->descr);
-        if (!newchoic->descr) {
-            free_choice(newchoic, OBJ_FL_CLONE);
-            return NULL;
-        }
-    }
-
-    if (mchoic && mchoic->ref) {
-        newchoic->ref = xml_strdup(mchoic->ref);
-        if (!newchoic->ref) {
-            free_choice(newchoic, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (choic->ref) {
-        newchoic->ref = xml_strdup(choic->ref);
-        if (!newchoic->ref) {
-            free_choice(newchoic, OBJ_FL_CLONE);
-            return NULL;
-        }
+    res = clone_text(&newchoic->descr, &newchoic->ref, &newchoic->textclone,
+                     choic->descr, choic->ref, mchoic);
+    if (res != NO_ERR) {
+        free_choice(newchoic, OBJ_FL_CLONE);
+        return NULL;
     }
 
     res = clone_datadefQ(mod, 
@@ -1832,8 +1795,10 @@ static void free_rpc (obj_rpc_t *rpc, uint32 flags)
     }
 
     m__free(rpc->name);
-    m__free(rpc->descr);
-    m__free(rpc->ref);
+    if (!rpc->textclone) {
+        m__free(rpc->descr);
+        m__free(rpc->ref);
+    }
 
     if (!(flags & OBJ_FL_CLONE)) {
         typ_clean_typeQ(&rpc->typedefQ);
@@ -1882,32 +1847,11 @@ static obj_rpc_t *
     newrpc->supported = rpc->supported;
 
 
-    if (mrpc && mrpc->descr) {
-        newrpc->descr = xml_strdup(mrpc->descr);
-        if (!newrpc->descr) {
-            free_rpc(newrpc, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (rpc->descr) {
-        newrpc->descr = xml_strdup(rpc->descr);
-        if (!newrpc->descr) {
-            free_rpc(newrpc, OBJ_FL_CLONE);
-            return NULL;
-        }
-    }
-
-    if (mrpc && mrpc->ref) {
-        newrpc->ref = xml_strdup(mrpc->ref);
-        if (!newrpc->ref) {
-            free_rpc(newrpc, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (rpc->ref) {
-        newrpc->ref = xml_strdup(rpc->ref);
-        if (!newrpc->ref) {
-            free_rpc(newrpc, OBJ_FL_CLONE);
-            return NULL;
-        }
+    res = clone_text(&newrpc->descr, &newrpc->ref, &newrpc->textclone,
+                     rpc->descr, rpc->ref, mrpc);
+    if (res != NO_ERR) {
+        free_rpc(newrpc, OBJ_FL_CLONE);
+        return NULL;
     }
 
     res = clone_datadefQ(mod,
@@ -2062,8 +2006,10 @@ static void free_notif (obj_notif_t *notif, uint32 flags)
     }
 
     m__free(notif->name);
-    m__free(notif->descr);
-    m__free(notif->ref);
+    if (!notif->textclone) {
+        m__free(notif->descr);
+        m__free(notif->ref);
+    }
 
     if (!(flags & OBJ_FL_CLONE)) {
         typ_clean_typeQ(&notif->typedefQ);
@@ -2108,32 +2054,11 @@ static obj_notif_t *
     newnot->typedefQ = not->typedefQ;
     newnot->groupingQ = not->groupingQ;
 
-    if (mnot && mnot->descr) {
-        newnot->descr = xml_strdup(mnot->descr);
-        if (!newnot->descr) {
-            free_notif(newnot, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (not->descr) {
-        newnot->descr = xml_strdup(not->descr);
-        if (!newnot->descr) {
-            free_notif(newnot, OBJ_FL_CLONE);
-            return NULL;
-        }
-    }
-
-    if (mnot && mnot->ref) {
-        newnot->ref = xml_strdup(mnot->ref);
-        if (!newnot->ref) {
-            free_notif(newnot, OBJ_FL_CLONE);
-            return NULL;
-        }
-    } else if (not->ref) {
-        newnot->ref = xml_strdup(not->ref);
-        if (!newnot->ref) {
-            free_notif(newnot, OBJ_FL_CLONE);
-            return NULL;
-        }
+    res = clone_text(&newnot->descr, &newnot->ref, &newnot->textclone,
+                     not->descr, not->ref, mnot);
+    if (res != NO_ERR) {
+        free_notif(newnot, OBJ_FL_CLONE);
+        return NULL;
     }
 
     res = clone_datadefQ(mod,
@@ -7032,6 +6957,27 @@ obj_template_t *
 }   /* obj_clone_template_case */
 
 
+/********************************************************************
+* FUNCTION obj_get_textclone_stats
+*
+* Get the number of cloned objects that share the description
+* and reference strings of their clone source instead of
+* keeping a malloced copy
+*
+* OUTPUTS:
+*   *count == number of cloned objects sharing the strings
+*   *bytes == number of string bytes not copied
+*********************************************************************/
+void
+    obj_get_textclone_stats (uint32 *count,
+                             uint64 *bytes)
+{
+    *count = obj_textclone_count;
+    *bytes = obj_textclone_bytes;
+
+}   /* obj_get_textclone_stats */
+
+
 /********************************************************************
 * FUNCTION obj_new_unique
 * 
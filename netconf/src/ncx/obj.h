@@ -33,6 +33,8 @@ date	     init     comment
 
 */
 
+#include <time.h>
+
 #include <libxml/xmlstring.h>
 #include <libxml/xmlregexp.h>
 
@@ -248,6 +250,7 @@ typedef struct obj_container_t_ {
     dlq_hdr_t     *groupingQ;      /* Q of grp_template_t */
     dlq_hdr_t     *datadefQ;       /* Q of obj_template_t */
     boolean        datadefclone;
+    boolean        textclone;   /* descr, ref owned by clone source */
     ncx_status_t   status;
     dlq_hdr_t      mustQ;             /* Q of xpath_pcb_t */
     struct obj_template_t_ *defaultparm;
@@ -262,6 +265,7 @@ typedef struct obj_leaf_t_ {
     xmlChar       *descr;
     xmlChar       *ref;
     typ_def_t     *typdef;
+    boolean        textclone;   /* descr, ref owned by clone source */
     ncx_status_t   status;
     dlq_hdr_t      mustQ;              /* Q of xpath_pcb_t */
     struct obj_template_t_ *leafrefobj;
@@ -281,6 +285,7 @@ typedef struct obj_leaflist_t_ {
     uint32         minelems;
     boolean        maxset;
     uint32         maxelems;
+    boolean        textclone;   /* descr, ref owned by clone source */
     ncx_status_t   status;
     dlq_hdr_t      mustQ;              /* Q of xpath_pcb_t */
     struct obj_template_t_ *leafrefobj;
@@ -299,6 +304,7 @@ typedef struct obj_list_t_ {
     dlq_hdr_t      keyQ;                 /* Q of obj_key_t */
     dlq_hdr_t      uniqueQ;           /* Q of obj_unique_t */
     boolean        datadefclone;
+    boolean        textclone;   /* descr, ref owned by clone source */
     boolean        ordersys;   /* ordered-by system or user */
     boolean        minset;
     uint32         minelems;
@@ -318,6 +324,7 @@ typedef struct obj_choice_t_ {
     xmlChar       *ref;
     dlq_hdr_t     *caseQ;             /* Q of obj_template_t */
     boolean        caseQclone;
+    boolean        textclone;   /* descr, ref owned by clone source */
     ncx_status_t   status;
 } obj_choice_t;
 
@@ -330,6 +337,7 @@ typedef struct obj_case_t_ {
     dlq_hdr_t      *datadefQ;         /* Q of obj_template_t */
     boolean         nameclone;
     boolean         datadefclone;
+    boolean         textclone;  /* descr, ref owned by clone source */
     ncx_status_t    status;
 } obj_case_t;
 
@@ -393,6 +401,7 @@ typedef struct obj_rpc_t_ {
     xmlChar           *name;
     xmlChar           *descr;
     xmlChar           *ref;
+    boolean            textclone; /* descr, ref owned by clone source */
     ncx_status_t       status;
     dlq_hdr_t          typedefQ;         /* Q of typ_template_t */
     dlq_hdr_t          groupingQ;        /* Q of gtp_template_t */
@@ -426,6 +435,7 @@ typedef struct obj_notif_t_ {
     xmlChar          *name;
     xmlChar          *descr;
     xmlChar          *ref;
+    boolean           textclone;  /* descr, ref owned by clone source */
     ncx_status_t      status;
     dlq_hdr_t         typedefQ;         /* Q of typ_template_t */
     dlq_hdr_t         groupingQ;        /* Q of gtp_template_t */
@@ -473,6 +483,21 @@ typedef struct obj_template_t_ {
     /* ...or agt_cb_fnset_node_t queue for data OBJ */
     dlq_hdr_t                   cbsetQ;
 
+    /* virtual value cache control for data OBJ
+     * vcachetime: seconds to keep a virtual value, set by the SIL
+     *   with val_set_virtual_cache_time; VAL_VIRTUAL_CACHE_DEFAULT
+     *   to use the session or server cache timeout
+     * vflushtime: cached values retrieved at or before this
+     *   uptime are stale; 0 if never invalidated
+     */
+    int32                       vcachetime;
+    time_t                      vflushtime;
+
+    /* getcb_start_fn_t to start asynchronous gets for
+     * the virtual nodes of this object; NULL if not used
+     */
+    void                       *getcb_start;
+
     /* object module and namespace ID 
      * assigned at runtime
      * this can be changed over and over as a
@@ -1462,6 +1487,22 @@ extern obj_template_t *
 			     dlq_hdr_t *mobjQ);
 
 
+/********************************************************************
+* FUNCTION obj_get_textclone_stats
+*
+* Get the number of cloned objects that share the description
+* and reference strings of their clone source instead of
+* keeping a malloced copy
+*
+* OUTPUTS:
+*   *count == number of cloned objects sharing the strings
+*   *bytes == number of string bytes not copied
+*********************************************************************/
+extern void
+    obj_get_textclone_stats (uint32 *count,
+			     uint64 *bytes);
+
+
 /********************    obj_unique_t   ********************/
 
 
@@ -113,10 +113,12 @@ static status_t
     ses_msg_t      *msg;
     ses_msg_buff_t *buff;
     const char     *endmatch;
+    const xmlChar  *eomstart;
     status_t        res;
     boolean         done;
     xmlChar         ch;
     uint32          count;
+    size_t          span;
 
 #ifdef SES_DEBUG
     if (LOGDEBUG3 && scb->state != SES_ST_INIT) {
@@ -149,7 +151,7 @@ static status_t
 
     /* make sure there is a current buffer to use */
     buff = (ses_msg_buff_t *)dlq_lastEntry(&msg->buffQ);
-    if (buff == NULL || buff->bufflen == SES_MSG_BUFFSIZE) {
+    if (buff == NULL || buff->bufflen == buff->buffsize) {
         /* need a new buffer */
         res = ses_msg_new_buff(scb,
                                FALSE,  /* outbuff */
@@ -196,10 +198,10 @@ static status_t
                 return res;
             }
             dlq_enque(buff, &msg->buffQ);
-        } else if (buff->buffpos == SES_MSG_BUFFSIZE) {
+        } else if (buff->buffpos == buff->buffsize) {
             /* current buffer is full; get a new one */
             buff->buffpos = 0;
-            buff->bufflen = SES_MSG_BUFFSIZE;
+            buff->bufflen = buff->buffsize;
             res = ses_msg_new_buff(scb,
                                    FALSE,  /* outbuff */
                                    &buff);
@@ -209,6 +211,27 @@ static status_t
             dlq_enque(buff, &msg->buffQ);
         }
 
+        /* copy the bytes up to the next char that can start the
+         * EOM string with 1 scan, instead of checking each char;
+         * the EOM string is matched 1 char at a time below
+         */
+        if (scb->instate != SES_INST_INEND) {
+            span = min(len - count, buff->buffsize - buff->buffpos);
+            eomstart = memchr(&scb->readbuff[count], *endmatch, span);
+            if (eomstart != NULL) {
+                span = (size_t)(eomstart - &scb->readbuff[count]);
+            }
+            if (span > 0) {
+                memcpy(&buff->buff[buff->buffpos], 
+                       &scb->readbuff[count], 
+                       span);
+                buff->buffpos += span;
+                count += span;
+                scb->instate = SES_INST_INMSG;
+                continue;
+            }
+        }
+
         /* get the next char in the input buffer and advance the pointer */
         ch = scb->readbuff[count++];
         buff->buff[buff->buffpos++] = ch;
@@ -270,6 +293,9 @@ static status_t
                     msg->curbuff = NULL;
                     msg->ready = TRUE;
                     ses_msg_make_inready(scb);
+                    scb->stats.in_msgs++;
+                    totals.stats.in_msgs++;
+                    scb->inmsgbuffs = 0;
 
                     /* reset reader state */
                     scb->instate = SES_INST_IDLE;
@@ -418,7 +444,7 @@ static status_t
 
     /* make sure there is a current buffer to use */
     buff = (ses_msg_buff_t *)dlq_lastEntry(&msg->buffQ);
-    if (buff == NULL || buff->bufflen == SES_MSG_BUFFSIZE) {
+    if (buff == NULL || buff->bufflen == buff->buffsize) {
         /* need a new buffer */
         res = ses_msg_new_buff(scb,
                                FALSE,  /* outbuff */
@@ -450,10 +476,10 @@ static status_t
                 return res;
             }
             dlq_enque(buff, &msg->buffQ);
-        } else if (buff->buffpos == SES_MSG_BUFFSIZE) {
+        } else if (buff->buffpos == buff->buffsize) {
             /* current buffer is full; get a new one */
             buff->buffpos = 0;
-            buff->bufflen = SES_MSG_BUFFSIZE;
+            buff->bufflen = buff->buffsize;
             res = ses_msg_new_buff(scb,
                                    FALSE,  /* outbuff */
                                    &buff);
@@ -542,6 +568,8 @@ static status_t
                         msg->expchunksize = num.u;
                         msg->curchunksize = 0;
                         scb->instate = SES_INST_INMSG;
+                        scb->stats.in_chunks++;
+                        totals.stats.in_chunks++;
                     } else {
                         if (LOGDEBUG) {
                             log_debug("\nses: invalid base:1;1 framing "
@@ -571,7 +599,7 @@ static status_t
             count--;   /* back up count */
             chunkleft = msg->expchunksize - msg->curchunksize;
             inbuffleft = len - count;
-            outbuffleft = SES_MSG_BUFFSIZE - buff->buffpos;
+            outbuffleft = buff->buffsize - buff->buffpos;
             copylen = min(inbuffleft, chunkleft);
 
             /* account for the amount copied above */
@@ -599,7 +627,7 @@ static status_t
                             &scb->readbuff[count],
                             outbuffleft);
                 buff->buffpos = 0;
-                buff->bufflen = SES_MSG_BUFFSIZE;
+                buff->bufflen = buff->buffsize;
                 copylen -= outbuffleft;
                 count += outbuffleft;
 
@@ -618,7 +646,7 @@ static status_t
                     }
                     dlq_enque(buff, &msg->buffQ);
 
-                    copy2len = min(SES_MSG_BUFFSIZE, copylen);
+                    copy2len = min(buff->buffsize, copylen);
                     xml_strncpy(&buff->buff[buff->buffpos],
                                 &scb->readbuff[count],
                                 copy2len);
@@ -693,6 +721,9 @@ static status_t
                     msg->curbuff = NULL;
                     msg->ready = TRUE;
                     ses_msg_make_inready(scb);
+                    scb->stats.in_msgs++;
+                    totals.stats.in_msgs++;
+                    scb->inmsgbuffs = 0;
                     
                     /* reset reader state */
                     scb->instate = SES_INST_IDLE;
@@ -964,7 +995,6 @@ ses_cb_t *
 
     scb->start_time = now;
     dlq_createSQue(&scb->msgQ);
-    dlq_createSQue(&scb->freeQ);
     dlq_createSQue(&scb->outQ);
     scb->linesize = SES_DEF_LINESIZE;
     scb->withdef = NCX_DEF_WITHDEF;
@@ -1061,15 +1091,6 @@ void ses_free_scb (ses_cb_t *scb)
         ses_msg_free_buff(scb, buff);
     }
 
-    /* the freeQ must be cleared after the outQ because
-     * the normal free buffer action is to move it to
-     * the scb->freeQ
-     */
-    while (!dlq_empty(&scb->freeQ)) {
-        buff = (ses_msg_buff_t *)dlq_deque(&scb->freeQ);
-        ses_msg_free_buff(scb, buff);
-    }
-
     if (scb->readbuff != NULL) {
         m__free(scb->readbuff);
     }
@@ -1167,13 +1188,85 @@ void
     ses_putstr (ses_cb_t *scb,
                 const xmlChar *str)
 {
-    while (*str) {
-        ses_putchar(scb, *str++);
-    }
+    ses_putbuff(scb, str, xml_strlen(str));
 
 }  /* ses_putstr */
 
 
+/********************************************************************
+* FUNCTION ses_putbuff
+*
+* Write a block of chars to the session, without any translation
+* The block is copied into the output buffers in as few
+* pieces as possible instead of one char at a time
+*
+* THIS FUNCTION DOES NOT CHECK ANY PARAMETERS TO SAVE TIME
+*
+* INPUTS:
+*   scb == session control block to start msg 
+*   buff == chars to write; does not need to be zero-terminated
+*   len == number of chars to write
+*
+*********************************************************************/
+void
+    ses_putbuff (ses_cb_t *scb,
+                 const xmlChar *buff,
+                 uint32 len)
+{
+    uint32          i, count;
+    status_t        res;
+
+    if (len == 0) {
+        return;
+    }
+
+    if (scb->fd) {
+        /* Normal NETCONF session mode: */
+        i = 0;
+        res = NO_ERR;
+        while (i < len && res == NO_ERR) {
+            if (scb->outbuff == NULL) {
+                res = ses_msg_new_buff(scb, TRUE, &scb->outbuff);
+                if (scb->outbuff == NULL) {
+                    break;
+                }
+            }
+            count = ses_msg_write_buffstr(scb, scb->outbuff,
+                                          &buff[i], len - i);
+            if (count == 0) {
+                res = ses_msg_new_output_buff(scb);
+            } else {
+                i += count;
+                scb->stats.out_bytes += count;
+                totals.stats.out_bytes += count;
+            }
+        }
+    } else if (scb->fp) {
+        /* debug session, sending output to a file */
+        if (fwrite(buff, 1, len, scb->fp) != len) {
+            log_debug("\nses: write to file failed");
+        }
+    } else {
+        /* debug session, sending output to the screen */
+        if (fwrite(buff, 1, len, stdout) != len) {
+            log_debug("\nses: write to stdout failed");
+        }
+    }
+
+    /* count the chars after the last newline, if any */
+    i = len;
+    while (i > 0 && buff[i - 1] != '\n') {
+        i--;
+    }
+    if (i > 0) {
+        scb->stats.out_line = len - i;
+    } else {
+        scb->stats.out_line += len;
+    }
+
+}  /* ses_putbuff */
+
+
 /********************************************************************
 * FUNCTION ses_putstr_indent
 *
@@ -1679,6 +1772,7 @@ int
     ses_msg_t        *msg;
     ses_msg_buff_t   *buff;
     int               retlen;
+    size_t            copylen;
     boolean           done;
 
     if (len == 0) {
@@ -1755,7 +1849,11 @@ int
             continue; /* an empty buffer! */
         }
 
-        buffer[retlen++] = (char)buff->buff[buff->buffpos++];
+        /* copy the rest of the buffer or as much as fits */
+        copylen = min(buff->bufflen - buff->buffpos, (size_t)(len - retlen));
+        memcpy(&buffer[retlen], &buff->buff[buff->buffpos], copylen);
+        retlen += (int)copylen;
+        buff->buffpos += copylen;
 
         /* check xmlreader buffer full */
         if (retlen == len) {
@@ -81,21 +81,53 @@ extern "C" {
 
 #define SES_NULL_SID  0
 
-/* controls the size of each buffer chuck */
+/* default size of each buffer chuck; 
+ * see ses_msg_set_buff_limits for the runtime value
+ */
 #define SES_MSG_BUFFSIZE  2000   // 1024
 
+/* default max size of the buffers of a session doing bulk transfers */
+#define SES_MSG_MAX_BUFFSIZE  32000
+
+/* each buffer size class is this many times bigger than the last */
+#define SES_BUFF_CLASS_FACTOR  4
+
+/* max number of buffer size classes */
+#define SES_MAX_BUFF_CLASSES  8
+
+/* number of buffers used for 1 message at which the session
+ * starts using buffers of the next size class
+ */
+#define SES_BUFF_GROW_COUNT  8
+
+/* max number of bytes of free buffers kept in the buffer pool
+ * for each size class
+ */
+#define SES_BUFF_POOL_BYTES  (1024 * 1024)
+
 /* max number of buffer chunks a session can have allocated at once  */
 #define SES_MAX_BUFFERS  4096
 
-/* max number of buffers a session is allowed to cache in its freeQ */
-#define SES_MAX_FREE_BUFFERS  32
-
-/* max number of buffers to try to send in one call to the write fn */
+/* default max number of buffers to try to send in one call 
+ * to the write fn
+ */
 #define SES_MAX_BUFFSEND   32
 
-/* max number of bytes to try to send in one call to the write_fn */
+/* upper limit for the max number of buffers to send at once */
+#define SES_MAX_BUFFSEND_LIMIT  1024
+
+/* default max number of bytes to try to send in one call 
+ * to the write_fn
+ */
 #define SES_MAX_BYTESEND   0xffff
 
+/* number of buffers in the outQ of a session with buffered output
+ * at which the reply in progress is suspended until the outQ
+ * is sent down to SES_OUTQ_LOW_WATER buffers
+ */
+#define SES_OUTQ_HIGH_WATER  128
+#define SES_OUTQ_LOW_WATER   32
+
 /* max desired lines size; not a hard limit */
 #define SES_DEF_LINESIZE   72
 
@@ -214,6 +246,10 @@ typedef struct ses_stats_t_ {
     uint32            in_bytes;
     uint32            out_bytes;
 
+    /* input framing counters */
+    uint32            in_msgs;      /* complete messages framed */
+    uint32            in_chunks;    /* base:1.1 chunks framed */
+
     /* hack: bytes since '\n', pretty-print */
     uint32            out_line;    
 
@@ -244,8 +280,10 @@ typedef struct ses_msg_buff_t_ {
     size_t           buffstart;        /* buff start pos */
     size_t           bufflen;        /* buff actual size */
     size_t           buffpos;       /* buff cur position */
+    size_t           buffsize;        /* size of buff */
+    uint32           buffclass;    /* buffer pool size class */
     boolean          islast;      /* T: last buff in msg */
-    xmlChar          buff[SES_MSG_BUFFSIZE];   
+    xmlChar          buff[];   
 } ses_msg_buff_t;
 
 
@@ -298,6 +336,7 @@ typedef struct ses_cb_t_ {
     boolean          active;            /* <hello> completed ok */
     boolean          notif_active;       /* subscription active */
     boolean          stream_output;        /* buffer/stream svr */
+    boolean          outq_dropped;   /* output failed, discard */
     boolean          noxmlns;          /* xml-nons display-mode */
     boolean          framing11;     /* T: base:1.1, F: base:1.0 */
     xmlTextReaderPtr reader;             /* input stream reader */
@@ -308,10 +347,13 @@ typedef struct ses_cb_t_ {
     uint32           inendpos;      /* inside framing directive */
     ses_instate_t    instate;               /* input state enum */
     uint32           buffcnt;           /* current buffer count */
-    uint32           freecnt;            /* current freeQ count */
+    uint32           inbuffclass;    /* size class of in buffers */
+    uint32           outbuffclass;  /* size class of out buffers */
+    uint32           inmsgbuffs;     /* in buffers of cur msg */
+    uint32           outmsgbuffs;   /* out buffers of cur msg */
     dlq_hdr_t        msgQ;              /* Q of ses_msg_t input */
-    dlq_hdr_t        freeQ;              /* Q of ses_msg_buff_t */
     dlq_hdr_t        outQ;               /* Q of ses_msg_buff_t */
+    uint32           outqcnt;          /* number of buffs in outQ */
     ses_msg_buff_t  *outbuff;          /* current output buffer */
     ses_ready_t      inready;            /* header for inreadyQ */
     ses_ready_t      outready;          /* header for outreadyQ */
@@ -442,6 +484,27 @@ extern void
 		const xmlChar *str);
 
 
+/********************************************************************
+* FUNCTION ses_putbuff
+*
+* Write a block of chars to the session, without any translation
+* The block is copied into the output buffers in as few
+* pieces as possible instead of one char at a time
+*
+* THIS FUNCTION DOES NOT CHECK ANY PARAMETERS TO SAVE TIME
+*
+* INPUTS:
+*   scb == session control block to start msg 
+*   buff == chars to write; does not need to be zero-terminated
+*   len == number of chars to write
+*
+*********************************************************************/
+extern void
+    ses_putbuff (ses_cb_t *scb,
+		 const xmlChar *buff,
+		 uint32 len);
+
+
 /********************************************************************
 * FUNCTION ses_putstr_indent
 *
@@ -37,6 +37,8 @@ date         init     comment
 #include  <errno.h>
 #include  <assert.h>
 #include  <sys/uio.h>
+#include  <poll.h>
+#include  <stddef.h>
 
 #include  "procdefs.h"
 #include  "log.h"
@@ -66,7 +68,15 @@ date         init     comment
 *                           T Y P E S                               *
 *                                                                   *
 *********************************************************************/
-    
+
+/* free buffers of 1 size class, shared by all sessions */
+typedef struct buff_pool_t_ {
+    dlq_hdr_t        freeQ;              /* Q of ses_msg_buff_t */
+    uint32           freecnt;
+    uint32           maxfree;
+    size_t           buffsize;
+} buff_pool_t;
+
 
 /********************************************************************
 *                                                                   *
@@ -79,6 +89,17 @@ static dlq_hdr_t freeQ;
 static dlq_hdr_t inreadyQ;
 static dlq_hdr_t outreadyQ;
 
+/* buffer pool for each size class, smallest first */
+static buff_pool_t buffpool[SES_MAX_BUFF_CLASSES];
+static uint32    numbuffclasses;
+
+/* limits for 1 call to the write fn */
+static uint32    maxbuffsend = SES_MAX_BUFFSEND;
+static uint32    maxbytesend = SES_MAX_BYTESEND;
+
+/* suspends a reply while its outQ is at the high water mark */
+static ses_msg_outq_wait_fn_t outqwaitfn;
+
 
 /********************************************************************
 * FUNCTION trace_buff
@@ -168,6 +189,295 @@ static status_t
 }  /* do_send_buff */
 
 
+/********************************************************************
+* FUNCTION drop_outq
+*
+* Drop the output of a session that cannot be written anymore
+* and request that the session be closed.  The rest of the
+* current reply is discarded as it is generated.
+*
+* INPUTS:
+*   scb == session control block to close
+*   res == status of the failed write
+*
+* OUTPUTS:
+*   scb->outq_dropped is set
+*   scb->state is set to SES_ST_SHUTDOWN_REQ
+*********************************************************************/
+static void
+    drop_outq (ses_cb_t *scb,
+               status_t res)
+{
+    ses_msg_buff_t  *buff;
+
+    log_info("\nses_msg: output failed on session %u (%s); "
+             "%u output buffers dropped, closing session",
+             scb->sid, get_error_string(res), scb->outqcnt);
+
+    while (!dlq_empty(&scb->outQ)) {
+        buff = (ses_msg_buff_t *)dlq_deque(&scb->outQ);
+        ses_msg_free_buff(scb, buff);
+    }
+    scb->outqcnt = 0;
+    scb->outq_dropped = TRUE;
+
+    if (scb->state < SES_ST_SHUTDOWN_REQ) {
+        scb->killedbysid = 0;
+        scb->termreason = SES_TR_DROPPED;
+        scb->state = SES_ST_SHUTDOWN_REQ;
+    }
+    ses_msg_make_outready(scb);
+
+}  /* drop_outq */
+
+
+/********************************************************************
+* FUNCTION drain_outq
+*
+* Suspend the reply in progress until the outQ of the session
+* is sent down to SES_OUTQ_LOW_WATER buffers.  The reply keeps
+* its state on the stack while it waits, so a peer that reads
+* slowly gets all of it, SES_OUTQ_HIGH_WATER buffers at a time.
+* The server I/O loop waits with outqwaitfn so the output of the
+* other sessions is sent in the meantime; without it the socket
+* of this session is polled.  The rest of the reply is dropped
+* if the output cannot be written.
+*
+* INPUTS:
+*   scb == session control block to drain
+*
+* RETURNS:
+*   status
+*********************************************************************/
+static status_t
+    drain_outq (ses_cb_t *scb)
+{
+    struct pollfd  pfd;
+    int            ret;
+    status_t       res;
+
+    if (LOGDEBUG3) {
+        log_debug3("\nses_msg: wait for outQ of session %u (%u buffers)",
+                   scb->sid, scb->outqcnt);
+    }
+
+    res = NO_ERR;
+    if (scb->wrfn == NULL && outqwaitfn != NULL) {
+        res = (*outqwaitfn)(scb);
+    } else {
+        while (res == NO_ERR && scb->outqcnt > SES_OUTQ_LOW_WATER) {
+            if (scb->wrfn == NULL) {
+                pfd.fd = scb->fd;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                ret = poll(&pfd, 1, -1);
+                if (ret < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    res = errno_to_status();
+                    continue;
+                }
+            }
+            res = ses_msg_send_buffs(scb);
+        }
+    }
+
+    if (res != NO_ERR) {
+        drop_outq(scb, res);
+    }
+    return res;
+
+}  /* drain_outq */
+
+
+/********************************************************************
+* FUNCTION flush_buff_pool
+*
+* Free all the buffers in the buffer pool
+*
+*********************************************************************/
+static void
+    flush_buff_pool (void)
+{
+    ses_msg_buff_t  *buff;
+    uint32           i;
+
+    for (i = 0; i < numbuffclasses; i++) {
+        while (!dlq_empty(&buffpool[i].freeQ)) {
+            buff = (ses_msg_buff_t *)dlq_deque(&buffpool[i].freeQ);
+            m__free(buff);
+        }
+        buffpool[i].freecnt = 0;
+    }
+
+}  /* flush_buff_pool */
+
+
+/********************************************************************
+* FUNCTION set_buff_classes
+*
+* Setup the buffer size classes; each class is
+* SES_BUFF_CLASS_FACTOR times bigger than the last one
+* The last class is cut to maxsize
+*
+* INPUTS:
+*   minsize == size of the smallest buffers
+*   maxsize == size of the biggest buffers
+*********************************************************************/
+static void
+    set_buff_classes (uint32 minsize,
+                      uint32 maxsize)
+{
+    buff_pool_t  *pool;
+    size_t        buffsize;
+
+    flush_buff_pool();
+
+    numbuffclasses = 0;
+    buffsize = minsize;
+    for (;;) {
+        pool = &buffpool[numbuffclasses++];
+        dlq_createSQue(&pool->freeQ);
+        pool->freecnt = 0;
+        pool->buffsize = (buffsize < maxsize) ? buffsize : maxsize;
+        pool->maxfree = SES_BUFF_POOL_BYTES / pool->buffsize;
+        if (pool->maxfree == 0) {
+            pool->maxfree = 1;
+        }
+        if (pool->buffsize == maxsize ||
+            numbuffclasses == SES_MAX_BUFF_CLASSES) {
+            break;
+        }
+        buffsize *= SES_BUFF_CLASS_FACTOR;
+    }
+
+}  /* set_buff_classes */
+
+
+/********************************************************************
+* FUNCTION count_msg_buff
+*
+* Count a buffer used for the current message of a session
+* A session that needs more than SES_BUFF_GROW_COUNT buffers
+* for a message starts using buffers of the next size class
+*
+* INPUTS:
+*   scb == session control block
+*   outbuff == TRUE for output buffers, FALSE for input buffers
+*
+* RETURNS:
+*   TRUE if the size class of the session buffers was changed
+*********************************************************************/
+static boolean
+    count_msg_buff (ses_cb_t *scb,
+                    boolean outbuff)
+{
+    uint32  *buffclass, *msgbuffs;
+
+    buffclass = (outbuff) ? &scb->outbuffclass : &scb->inbuffclass;
+    msgbuffs = (outbuff) ? &scb->outmsgbuffs : &scb->inmsgbuffs;
+
+    if (++(*msgbuffs) <= SES_BUFF_GROW_COUNT ||
+        *buffclass + 1 >= numbuffclasses) {
+        return FALSE;
+    }
+
+    (*buffclass)++;
+    *msgbuffs = 1;
+
+    if (LOGDEBUG3) {
+        log_debug3("\nses_msg: using %u byte %s buffs for s %u",
+                   (uint32)buffpool[*buffclass].buffsize,
+                   (outbuff) ? "out" : "in",
+                   scb->sid);
+    }
+    return TRUE;
+
+}  /* count_msg_buff */
+
+
+/********************************************************************
+* FUNCTION get_buff
+*
+* Get a buffer of the current size class of the session
+* from the buffer pool or malloc a new one
+*
+* INPUTS:
+*   scb == session control block to get a buffer for
+*   outbuff == TRUE if this is for outgoing message
+*              FALSE if this is for incoming message
+*   buff == address of ses_msg_buff_t pointer that will be set
+*
+* OUTPUTS:
+*   *buff == session buffer chunk (if NO_ERR return)
+*
+* RETURNS:
+*   status
+*********************************************************************/
+static status_t
+    get_buff (ses_cb_t *scb,
+              boolean outbuff,
+              ses_msg_buff_t **buff)
+{
+    ses_msg_buff_t *newbuff;
+    buff_pool_t    *pool;
+    uint32          buffclass;
+
+    /* check buffers exceeded error */
+    if (scb->buffcnt+1 >= SES_MAX_BUFFERS) {
+        return ERR_NCX_RESOURCE_DENIED;
+    }
+
+    buffclass = (outbuff) ? scb->outbuffclass : scb->inbuffclass;
+    if (buffclass >= numbuffclasses) {
+        buffclass = numbuffclasses - 1;
+    }
+    pool = &buffpool[buffclass];
+
+    newbuff = (ses_msg_buff_t *)dlq_deque(&pool->freeQ);
+    if (newbuff) {
+        /* use buffer from the pool */
+        pool->freecnt--;
+
+        if (LOGDEBUG4) {
+            log_debug4("\nses_msg: reused %s buff %p for s %u", 
+                       (outbuff) ? "out" : "in",
+                       newbuff,
+                       scb->sid);
+        }
+    } else {
+        /* malloc the buffer */
+        newbuff = m__getMem(offsetof(ses_msg_buff_t, buff) + 
+                            pool->buffsize);
+        if (newbuff == NULL) {
+            return ERR_INTERNAL_MEM;
+        }
+        newbuff->buffsize = pool->buffsize;
+        newbuff->buffclass = buffclass;
+
+        if (LOGDEBUG4) {
+            log_debug4("\nses_msg: new %s buff %p for s %u", 
+                       (outbuff) ? "out" : "in",
+                       newbuff,
+                       scb->sid);
+        }
+    }
+
+    /* set the fields and exit */
+    ses_msg_init_buff(scb, outbuff, newbuff);
+
+#ifdef SES_MSG_CLEAR_INIT_BUFFERS
+    memset(newbuff->buff, 0x0, newbuff->buffsize);
+#endif
+
+    *buff = newbuff;
+    scb->buffcnt++;
+    return NO_ERR;
+
+}  /* get_buff */
+
+
 /********************************************************************
 * FUNCTION ses_msg_init
 *
@@ -186,6 +496,8 @@ void
         dlq_createSQue(&freeQ);
         dlq_createSQue(&inreadyQ);
         dlq_createSQue(&outreadyQ);
+        numbuffclasses = 0;
+        set_buff_classes(SES_MSG_BUFFSIZE, SES_MSG_MAX_BUFFSIZE);
         ses_msg_init_done = TRUE;
     }
 
@@ -217,6 +529,9 @@ void
             m__free(msg);
         }
 
+        flush_buff_pool();
+        numbuffclasses = 0;
+
         /* nothing malloced in these Qs now */
         memset(&freeQ, 0x0, sizeof(dlq_hdr_t));
         memset(&inreadyQ, 0x0, sizeof(dlq_hdr_t));
@@ -228,6 +543,67 @@ void
 }  /* ses_msg_cleanup */
 
 
+/********************************************************************
+* FUNCTION ses_msg_set_buff_limits
+*
+* Set the buffer sizes and the limits for sending buffers
+* Called after the CLI parameters are processed; the free
+* buffers of the old sizes are dropped
+*
+* INPUTS:
+*   buffsize == size of the first buffers of each session
+*   maxbuffsize == max size of the buffers of a session
+*                  doing bulk transfers; no growth if the
+*                  same as buffsize
+*   buffsend == max number of buffers to send in 1 call
+*               (1 .. SES_MAX_BUFFSEND_LIMIT)
+*   bytesend == max number of bytes to send in 1 call;
+*               1 buffer is always sent
+*********************************************************************/
+void
+    ses_msg_set_buff_limits (uint32 buffsize,
+                             uint32 maxbuffsize,
+                             uint32 buffsend,
+                             uint32 bytesend)
+{
+    if (buffsize <= SES_STARTCHUNK_PAD + SES_ENDCHUNK_PAD) {
+        SET_ERROR(ERR_INTERNAL_VAL);
+        buffsize = SES_MSG_BUFFSIZE;
+    }
+    if (maxbuffsize < buffsize) {
+        maxbuffsize = buffsize;
+    }
+    set_buff_classes(buffsize, maxbuffsize);
+
+    if (buffsend == 0) {
+        buffsend = 1;
+    } else if (buffsend > SES_MAX_BUFFSEND_LIMIT) {
+        buffsend = SES_MAX_BUFFSEND_LIMIT;
+    }
+    maxbuffsend = buffsend;
+    maxbytesend = bytesend;
+
+}  /* ses_msg_set_buff_limits */
+
+
+/********************************************************************
+* FUNCTION ses_msg_set_outq_wait_fn
+*
+* Set the function a reply in progress calls when the outQ
+* of its session reaches SES_OUTQ_HIGH_WATER buffers
+*
+* INPUTS:
+*   waitfn == function to wait for the outQ to be sent;
+*             NULL to poll the session socket instead
+*********************************************************************/
+void
+    ses_msg_set_outq_wait_fn (ses_msg_outq_wait_fn_t waitfn)
+{
+    outqwaitfn = waitfn;
+
+}  /* ses_msg_set_outq_wait_fn */
+
+
 /********************************************************************
 * FUNCTION ses_msg_new_msg
 *
@@ -304,7 +680,11 @@ void ses_msg_free_msg (ses_cb_t *scb, ses_msg_t *msg)
 /********************************************************************
 * FUNCTION ses_msg_new_buff
 *
-* Malloc a new session buffer chuck
+* Get a new session buffer chuck from the buffer pool
+* or malloc a new one
+*
+* The size of the buffer depends on the number of buffers the
+* session has used for the current message; see count_msg_buff
 *
 * Note that the buffer memory is not cleared after each use
 * since this is not needed for byte stream IO
@@ -325,68 +705,11 @@ status_t ses_msg_new_buff( ses_cb_t *scb,
                            boolean outbuff,
                            ses_msg_buff_t **buff)
 {
-    ses_msg_buff_t *newbuff;
-
     assert( scb && "scb == NULL" );
     assert( buff && "buff == NULL" );
 
-    /* handle the session freeQ separately */
-    if (scb->freecnt) {
-        newbuff = (ses_msg_buff_t *)dlq_deque(&scb->freeQ);
-        if (newbuff) {
-            /* use buffer from freeQ */
-            ses_msg_init_buff(scb, outbuff, newbuff);
-
-#ifdef SES_MSG_CLEAR_INIT_BUFFERS
-            memset(newbuff->buff, 0x0, SES_MSG_BUFFSIZE);
-#endif
-
-            *buff = newbuff;
-            scb->freecnt--;
-
-            if (LOGDEBUG4) {
-                log_debug4("\nses_msg: reused %s buff %p for s %u", 
-                           (outbuff) ? "out" : "in",
-                           newbuff,
-                           scb->sid);
-            }
-
-            return NO_ERR;
-        } else {
-            SET_ERROR(ERR_INTERNAL_VAL);
-            scb->freecnt = 0;
-        }
-    }
-
-    /* check buffers exceeded error */
-    if (scb->buffcnt+1 >= SES_MAX_BUFFERS) {
-        return ERR_NCX_RESOURCE_DENIED;
-    }
-
-    /* malloc the buffer */
-    newbuff = m__getObj(ses_msg_buff_t);
-    if (newbuff == NULL) {
-        return ERR_INTERNAL_MEM;
-    }
-
-    /* set the fields and exit */
-    ses_msg_init_buff(scb, outbuff, newbuff);
-
-#ifdef DEBUG
-    memset(newbuff->buff, 0x0, SES_MSG_BUFFSIZE);
-#endif
-
-    *buff = newbuff;
-    scb->buffcnt++;
-
-    if (LOGDEBUG4) {
-        log_debug4("\nses_msg: new %s buff %p for s %u", 
-                   (outbuff) ? "out" : "in",
-                   newbuff,
-                   scb->sid);
-    }
-
-    return NO_ERR;
+    (void)count_msg_buff(scb, outbuff);
+    return get_buff(scb, outbuff, buff);
 
 } /* ses_msg_new_buff */
 
@@ -395,6 +718,8 @@ status_t ses_msg_new_buff( ses_cb_t *scb,
 * FUNCTION ses_msg_free_buff
 *
 * Free the session buffer chunk
+* The buffer is put in the buffer pool of its size class
+* if the pool is not full
 *
 * INPUTS:
 *   scb == session control block owning the message
@@ -407,12 +732,27 @@ void
     ses_msg_free_buff (ses_cb_t *scb,
                        ses_msg_buff_t *buff)
 {
+    buff_pool_t  *pool;
+
     assert( scb && "scb == NULL" );
 
-    if (scb->state < SES_ST_SHUTDOWN_REQ &&
-        scb->freecnt < SES_MAX_FREE_BUFFERS) {
-        dlq_enque(buff, &scb->freeQ);
-        scb->freecnt++;
+    scb->buffcnt--;
+
+    /* the size classes may have been changed since the
+     * buffer was allocated
+     */
+    pool = NULL;
+    if (ses_msg_init_done && buff->buffclass < numbuffclasses) {
+        pool = &buffpool[buff->buffclass];
+        if (pool->buffsize != buff->buffsize || 
+            pool->freecnt >= pool->maxfree) {
+            pool = NULL;
+        }
+    }
+
+    if (pool != NULL) {
+        dlq_enque(buff, &pool->freeQ);
+        pool->freecnt++;
 
 #ifdef SES_MSG_DEBUG_CACHE
         if (LOGDEBUG4) {
@@ -430,7 +770,6 @@ void
         }
 #endif
         m__free(buff);
-        scb->buffcnt--;
     }
 
 } /* ses_msg_free_buff */
@@ -466,13 +805,13 @@ status_t
 
     res = NO_ERR;
     if (scb->framing11) {
-        if (buff->bufflen < (SES_MSG_BUFFSIZE - SES_ENDCHUNK_PAD)) {
+        if (buff->bufflen < (buff->buffsize - SES_ENDCHUNK_PAD)) {
             buff->buff[buff->bufflen++] = (xmlChar)ch;
         } else {
             res = ERR_BUFF_OVFL;
         }
     } else {
-        if (buff->bufflen < SES_MSG_BUFFSIZE) {
+        if (buff->bufflen < buff->buffsize) {
             buff->buff[buff->bufflen++] = (xmlChar)ch;
         } else {
             res = ERR_BUFF_OVFL;
@@ -483,6 +822,47 @@ status_t
 } /* ses_msg_write_buff */
 
 
+/********************************************************************
+* FUNCTION ses_msg_write_buffstr
+*
+* Add as much of a text block to the message buffer as fits
+*
+* INPUTS:
+*   scb == session control block to use
+*   buff == buffer to write to
+*   str == text to write
+*   len == number of bytes in str
+*
+* RETURNS:
+*   number of bytes written; less than len if the buffer is full
+*
+*********************************************************************/
+uint32
+    ses_msg_write_buffstr (ses_cb_t *scb,
+                           ses_msg_buff_t *buff,
+                           const xmlChar *str,
+                           uint32 len)
+{
+    size_t   maxlen;
+
+    assert( scb && "scb == NULL" );
+    assert( buff && "buff == NULL" );
+
+    maxlen = (scb->framing11) ? 
+        (buff->buffsize - SES_ENDCHUNK_PAD) : buff->buffsize;
+    if (buff->bufflen >= maxlen) {
+        return 0;
+    }
+    if (len > maxlen - buff->bufflen) {
+        len = (uint32)(maxlen - buff->bufflen);
+    }
+    memcpy(&buff->buff[buff->bufflen], str, len);
+    buff->bufflen += len;
+    return len;
+
+} /* ses_msg_write_buffstr */
+
+
 /********************************************************************
 * FUNCTION ses_msg_send_buffs
 *
@@ -504,7 +884,7 @@ status_t
     int              i, cnt;
     boolean          done;
     status_t         res;
-    struct iovec     iovs[SES_MAX_BUFFSEND];
+    struct iovec     iovs[SES_MAX_BUFFSEND_LIMIT];
 
     assert( scb && "scb == NULL" );
 
@@ -537,16 +917,16 @@ status_t
         return (*scb->wrfn)(scb);
     }
 
-    memset(iovs, 0x0, sizeof(iovs));
+    memset(iovs, 0x0, maxbuffsend * sizeof(struct iovec));
     total = 0;
     cnt = 0;
     done = FALSE;
     buff = (ses_msg_buff_t *)dlq_firstEntry(&scb->outQ);
 
     /* setup the writev call */
-    for (i=0; i<SES_MAX_BUFFSEND && !done && buff; i++) {
+    for (i=0; i<(int)maxbuffsend && !done && buff; i++) {
         buffleft = buff->bufflen - buff->buffpos;
-        if ((total+buffleft) > SES_MAX_BYTESEND) {
+        if (i > 0 && (total+buffleft) > maxbytesend) {
             done = TRUE;
         } else {
             total += buffleft;
@@ -582,6 +962,7 @@ status_t
             if (buff == NULL) {
                 return SET_ERROR(ERR_INTERNAL_VAL);
             }
+            scb->outqcnt--;
             res = do_send_buff(scb, buff);
             ses_msg_free_buff(scb, buff);            
             if (res != NO_ERR) {
@@ -622,6 +1003,7 @@ status_t
          */
         if ((uint32)retcnt >= buffleft) {
             dlq_remove(buff);
+            scb->outqcnt--;
             ses_msg_free_buff(scb, buff);
             retcnt -= (ssize_t)buffleft;
             buff = (ses_msg_buff_t *)dlq_firstEntry(&scb->outQ);            
@@ -649,6 +1031,9 @@ status_t
 * OUTPUTS:
 *   scb->outbuff, scb->outready, and scb->outQ will be changed
 *   !!! buffer will be sent if stream output mode, then buffer reused
+*   !!! the reply is suspended until the outQ is sent down to
+*   !!! SES_OUTQ_LOW_WATER buffers if it reaches SES_OUTQ_HIGH_WATER
+*   !!! buffers; the rest of the reply is dropped if the output fails
 *   
 * RETURNS:
 *   status, could return malloc or buffers exceeded error
@@ -678,14 +1063,34 @@ status_t ses_msg_new_output_buff (ses_cb_t *scb)
             res = SET_ERROR(ERR_INTERNAL_VAL);
         }
 
-        /* reuse the same outbuff again */
+        /* reuse the same outbuff again, unless the message
+         * is big enough to switch to bigger buffers
+         */
+        if (res == NO_ERR && count_msg_buff(scb, TRUE)) {
+            ses_msg_free_buff(scb, buff);
+            scb->outbuff = NULL;
+            res = get_buff(scb, TRUE, &scb->outbuff);
+        }
+    } else if (scb->outq_dropped) {
+        /* the session is being closed; discard the output */
+        ses_msg_init_buff(scb, TRUE, buff);
+        res = NO_ERR;
     } else {
         /* save the buffer in the message loop do be sent when
          * the main loop checks if any output pending
          */
         dlq_enque(scb->outbuff, &scb->outQ);
+        scb->outqcnt++;
         ses_msg_make_outready(scb);
         scb->outbuff = NULL;
+
+        /* send the reply so far instead of buffering all of it;
+         * the sent buffers are reused and the rest of the reply
+         * is discarded if the output fails
+         */
+        if (scb->outqcnt >= SES_OUTQ_HIGH_WATER) {
+            (void)drain_outq(scb);
+        }
         res = ses_msg_new_buff(scb, TRUE, &scb->outbuff);
     }
     return res;
@@ -720,7 +1125,7 @@ void ses_msg_unmake_inready (ses_cb_t *scb)
     assert( scb && "scb is NULL" );
 
     if (scb->inready.inq) {
-        dlq_deque(&scb->inready.hdr);
+        dlq_remove(&scb->inready);
         scb->inready.inq = FALSE;
     }
 
@@ -753,7 +1158,7 @@ void ses_msg_unmake_outready (ses_cb_t *scb)
     assert( scb && "scb is NULL" );
 
     if (scb->outready.inq) {
-        dlq_deque(&scb->outready.hdr);
+        dlq_remove(&scb->outready);
         scb->outready.inq = FALSE;
     }
 
@@ -778,21 +1183,37 @@ void ses_msg_finish_outmsg (ses_cb_t *scb)
     assert( scb && "scb is NULL" );
     assert( scb->outbuff && "scb->outbuff is NULL" );
 
+    /* the next message starts counting its buffers again */
+    scb->outmsgbuffs = 0;
+
     if (scb->stream_output) {
         res = do_send_buff(scb, scb->outbuff);
         ses_msg_init_buff(scb, TRUE, scb->outbuff);
+        scb->outmsgbuffs = 1;
         if (res != NO_ERR) {
             log_error("\nError: IO failed on session '%d' (%s)", 
                       scb->sid,
                       get_error_string(res));
         }
+    } else if (scb->outq_dropped) {
+        /* the session is closed from the main loop */
+        ses_msg_init_buff(scb, TRUE, scb->outbuff);
+        ses_msg_make_outready(scb);
     } else {
         scb->outbuff->buffpos = scb->outbuff->buffstart;
         dlq_enque(scb->outbuff, &scb->outQ);
+        scb->outqcnt++;
         scb->outbuff = NULL;
         (void)ses_msg_new_buff(scb, TRUE, &scb->outbuff);
 
         ses_msg_make_outready(scb);
+
+        /* many short messages, such as notifications, are
+         * not queued past the high water mark either
+         */
+        if (scb->outqcnt >= SES_OUTQ_HIGH_WATER) {
+            (void)drain_outq(scb);
+        }
     }
 
 } /* ses_msg_finish_outmsg */
@@ -59,6 +59,12 @@ extern "C" {
 *                                                                   *
 *********************************************************************/
 
+/* wait until the outQ of the session is sent down to
+ * SES_OUTQ_LOW_WATER buffers; set by the server I/O loop
+ * with ses_msg_set_outq_wait_fn
+ */
+typedef status_t (*ses_msg_outq_wait_fn_t) (ses_cb_t *scb);
+
 
 /********************************************************************
 *                                                                   *
@@ -96,6 +102,46 @@ extern void
     ses_msg_cleanup (void);
 
 
+/********************************************************************
+* FUNCTION ses_msg_set_buff_limits
+*
+* Set the buffer sizes and the limits for sending buffers
+* Called after the CLI parameters are processed
+*
+* INPUTS:
+*   buffsize == size of the first buffers of each session
+*   maxbuffsize == max size of the buffers of a session
+*                  doing bulk transfers
+*   buffsend == max number of buffers to send in 1 call
+*   bytesend == max number of bytes to send in 1 call
+*
+* RETURNS:
+*   none
+*********************************************************************/
+extern void
+    ses_msg_set_buff_limits (uint32 buffsize,
+                             uint32 maxbuffsize,
+                             uint32 buffsend,
+                             uint32 bytesend);
+
+
+/********************************************************************
+* FUNCTION ses_msg_set_outq_wait_fn
+*
+* Set the function a reply in progress calls when the outQ
+* of its session reaches SES_OUTQ_HIGH_WATER buffers
+*
+* INPUTS:
+*   waitfn == function to wait for the outQ to be sent;
+*             NULL to poll the session socket instead
+*
+* RETURNS:
+*   none
+*********************************************************************/
+extern void
+    ses_msg_set_outq_wait_fn (ses_msg_outq_wait_fn_t waitfn);
+
+
 /********************************************************************
 * FUNCTION ses_msg_new_msg
 *
@@ -192,6 +238,28 @@ extern status_t
                         uint32 ch);
 
 
+/********************************************************************
+* FUNCTION ses_msg_write_buffstr
+*
+* Add as much of a text block to the message buffer as fits
+*
+* INPUTS:
+*   scb == session control block to use
+*   buff == buffer to write to
+*   str == text to write
+*   len == number of bytes in str
+*
+* RETURNS:
+*   number of bytes written; less than len if the buffer is full
+*
+*********************************************************************/
+extern uint32
+    ses_msg_write_buffstr (ses_cb_t *scb,
+                           ses_msg_buff_t *buff,
+                           const xmlChar *str,
+                           uint32 len);
+
+
 /********************************************************************
 * FUNCTION ses_msg_send_buffs
 *
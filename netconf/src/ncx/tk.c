@@ -37,6 +37,9 @@ date         init     comment
 #include <memory.h>
 #include <ctype.h>
 #include <assert.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <libxml/xmlstring.h>
 
@@ -68,6 +71,10 @@ date         init     comment
 
 #define FL_ALL    (FL_YANG|FL_CONF|FL_XPATH|FL_REDO)
 
+/* bits for the tk_cache_rec_t flags field */
+#define TK_CACHE_FL_VAL   bit0         /* tk->val string follows */
+#define TK_CACHE_FL_MOD   bit1         /* tk->mod string follows */
+
 /********************************************************************
 *                                                                   *
 *                            T Y P E S                              *
@@ -83,6 +90,26 @@ typedef struct tk_ent_t_ {
     uint32          flags;
 } tk_ent_t;
 
+/* fixed part of one token saved by tk_save_chain;
+ * the 'val' and 'mod' strings (not Z-terminated) follow it
+ */
+typedef struct tk_cache_rec_t_ {
+    uint32          typ;
+    uint32          linenum;
+    uint32          linepos;
+    uint32          len;
+    uint32          modlen;
+    uint32          flags;
+} tk_cache_rec_t;
+
+/* one warning saved by tk_save_chain after the tokens */
+typedef struct tk_cache_warn_t_ {
+    uint32          res;
+    uint32          linenum;
+    uint32          linepos;
+    uint32          val;
+} tk_cache_warn_t;
+
 /* One quick entry built-in type name lookup */
 typedef struct tk_btyp_t_ {
     ncx_btype_t     btyp;
@@ -374,6 +401,96 @@ static tk_token_t *
 } /* new_token */
 
 
+/********************************************************************
+* FUNCTION next_mmap_line
+* 
+* Start a new line in a mapped source file
+* Does the line accounting that reading the next
+* line with fgets does in file input mode
+*
+* INPUTS:
+*   tkc == token chain 
+*********************************************************************/
+static void
+    next_mmap_line (tk_chain_t *tkc)
+{
+    if (tkc->flags & TK_FL_MMAP) {
+        tkc->linenum++;
+        tkc->linepos = 1;
+    }
+
+}  /* next_mmap_line */
+
+
+/********************************************************************
+* FUNCTION map_input
+* 
+* Map a YANG source file as one zero-terminated read-only buffer,
+* so the tokenizer can run over the file without copying it
+* into the line buffer first.
+*
+* The file is mapped over an anonymous mapping 1 page longer
+* than the file, so the byte after the file contents is always 0.
+*
+* INPUTS:
+*   tkc == token chain with the open source file
+*   maplen == address of return mapping length
+*
+* OUTPUTS:
+*   *maplen == length to pass to munmap
+*
+* RETURNS:
+*   pointer to the mapped file or NULL if the file
+*   cannot be mapped and must be read with fgets
+*********************************************************************/
+static xmlChar *
+    map_input (tk_chain_t *tkc,
+               size_t *maplen)
+{
+    struct stat  statbuf;
+    void        *base;
+    size_t       filelen, pagelen, total;
+    long         pagesize;
+    int          fd;
+
+    fd = fileno(tkc->fp);
+    if (fd < 0 || ftell(tkc->fp) != 0 || fstat(fd, &statbuf) != 0 ||
+        !S_ISREG(statbuf.st_mode) || statbuf.st_size <= 0) {
+        return NULL;
+    }
+
+    pagesize = sysconf(_SC_PAGESIZE);
+    if (pagesize <= 0) {
+        return NULL;
+    }
+    pagelen = (size_t)pagesize;
+    filelen = (size_t)statbuf.st_size;
+    total = ((filelen / pagelen) + 1) * pagelen;
+
+    base = mmap(NULL, total, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+    if (mmap(base, filelen, PROT_READ, MAP_PRIVATE | MAP_FIXED, 
+             fd, 0) == MAP_FAILED) {
+        (void)munmap(base, total);
+        return NULL;
+    }
+
+    /* the line reader skips over 0 bytes; the buffer mode stops */
+    if (memchr(base, 0, filelen) != NULL) {
+        (void)munmap(base, total);
+        return NULL;
+    }
+
+    (void)madvise(base, filelen, MADV_SEQUENTIAL);
+
+    *maplen = total;
+    return (xmlChar *)base;
+
+}  /* map_input */
+
+
 /********************************************************************
 * FUNCTION new_mtoken
 * 
@@ -1080,12 +1197,15 @@ static status_t
                     tkc->linepos = 1;
                 } else if (*str =='t') {
                     tkc->linepos += NCX_TABSIZE;
+                } else if (*str == '\n' && (tkc->flags & TK_FL_MMAP)) {
+                    next_mmap_line(tkc);
                 } else {
                     tkc->linepos++;
                 }
             } else {
                 if (*str == '\n') {
                     tkc->linepos = 1;
+                    next_mmap_line(tkc);
                 } else if (*str =='\t') {
                     tkc->linepos += NCX_TABSIZE;
                 } else {
@@ -1221,7 +1341,7 @@ static status_t
 static status_t 
     tokenize_sqstring (tk_chain_t *tkc)
 {
-    xmlChar      *str, *tempbuff, *outstr;
+    xmlChar      *str, *tempbuff, *outstr, *linestart;
     uint32        total, startline, startpos, linelen;
     status_t      res;
     boolean       done;
@@ -1236,18 +1356,30 @@ static status_t
      * as part of the content, and doesn't count againt maxlen
      */
     str = ++tkc->bptr;
+    linestart = NULL;
     while (*str && (*str != NCX_SQSTRING_CH)) {
+        if (*str == '\n' && (tkc->flags & TK_FL_MMAP)) {
+            next_mmap_line(tkc);
+            linestart = str+1;
+        }
         str++;
     }
 
     total = (uint32)(str - tkc->bptr);
 
     if (*str == NCX_SQSTRING_CH) {
-        /* easy case, a quoted string on 1 line; */
-        res = add_new_token(tkc, TK_TT_SQSTRING, str, startpos);
+        /* easy case, a quoted string on 1 line;
+         * or the whole string is in the mapped file */
+        if (linestart != NULL) {
+            res = add_new_qtoken(tkc, FALSE, tkc->bptr, str,
+                                 startline, startpos);
+            tkc->linepos = (uint32)(str - linestart) + 1;
+        } else {
+            res = add_new_token(tkc, TK_TT_SQSTRING, str, startpos);
+            tkc->linepos += total+2;
+        }
         tkc->bptr = str+1;
-        tkc->linepos += total+2;
-        return NO_ERR;
+        return res;
     }
 
     /* else we reached the end of the buffer without
@@ -1363,6 +1495,8 @@ static status_t
     while (*str && !(*str=='*' && str[1]=='/')) {
         if (*str == '\t') {
             tkc->linepos += NCX_TABSIZE;
+        } else if (*str == '\n' && (tkc->flags & TK_FL_MMAP)) {
+            next_mmap_line(tkc);
         } else {
             tkc->linepos++;
         }
@@ -2146,6 +2280,7 @@ tk_chain_t *
     dlq_createSQue(&tkc->tkQ);
     tkc->cur = (tk_token_t *)&tkc->tkQ;
     dlq_createSQue(&tkc->tkptrQ);
+    dlq_createSQue(&tkc->warnQ);
     return tkc;
            
 } /* tk_new_chain */
@@ -2275,6 +2410,7 @@ void
 {
     tk_token_t      *tk;
     tk_token_ptr_t  *tkptr;
+    tk_warn_t       *warn;
 
 #ifdef DEBUG
     if (!tkc) {
@@ -2295,6 +2431,10 @@ void
         tkptr = (tk_token_ptr_t *)dlq_deque(&tkc->tkptrQ);
         free_token_ptr(tkptr);
     }
+    while (!dlq_empty(&tkc->warnQ)) {
+        warn = (tk_warn_t *)dlq_deque(&tkc->warnQ);
+        m__free(warn);
+    }
     if ((tkc->flags & TK_FL_MALLOC) && tkc->buff) {
         m__free(tkc->buff);
     }
@@ -2686,6 +2826,8 @@ status_t
     boolean       done;
     tk_token_t   *tk;
     tk_type_t     ttyp;
+    xmlChar      *mapbuff;
+    size_t        maplen;
 
 #ifdef DEBUG
     if (!tkc) {
@@ -2693,8 +2835,26 @@ status_t
     }
 #endif
 
+    /* map a YANG source file if possible, 
+     * otherwise read it one line at a time */
+    mapbuff = NULL;
+    maplen = 0;
+    if ((tkc->flags & TK_FL_MALLOC) && 
+        tkc->filename && 
+        tkc->fp &&
+        tkc->source == TK_SOURCE_YANG) {
+        mapbuff = map_input(tkc, &maplen);
+    }
+
     /* check if a temp buffer is needed */
-    if (tkc->flags & TK_FL_MALLOC) {
+    if (mapbuff != NULL) {
+        tkc->flags &= ~TK_FL_MALLOC;
+        tkc->flags |= TK_FL_MMAP;
+        tkc->buff = mapbuff;
+        tkc->linenum++;
+        tkc->linepos = 1;
+        ncx_check_warn_linelen(tkc, mod, tkc->buff);
+    } else if (tkc->flags & TK_FL_MALLOC) {
         tkc->buff = m__getMem(TK_BUFF_SIZE);
         if (!tkc->buff) {
             res = ERR_INTERNAL_MEM;
@@ -2720,7 +2880,7 @@ status_t
         /* get one line of input if parsing from FILE in buffer,
          * or already have the buffer if parsing from memory
          */
-        if (tkc->filename) {
+        if (tkc->filename && !(tkc->flags & TK_FL_MMAP)) {
             if (!fgets((char *)tkc->buff, TK_BUFF_SIZE, tkc->fp)) {
                 /* read line failed, treating as not an error */
                 res = NO_ERR;
@@ -2790,6 +2950,10 @@ status_t
                     dlq_enque(tk, &tkc->tkQ);
                 }
                 tkc->bptr++;
+                if (tkc->flags & TK_FL_MMAP) {
+                    next_mmap_line(tkc);
+                    ncx_check_warn_linelen(tkc, mod, tkc->bptr);
+                }
             } else if ((tkc->source == TK_SOURCE_CONF &&
                         *tkc->bptr == NCX_COMMENT_CH) ||
                        (tkc->source == TK_SOURCE_YANG &&
@@ -2883,6 +3047,14 @@ status_t
         ncx_print_errormsg(tkc, mod, res);
     }
 
+    if (mapbuff != NULL) {
+        (void)munmap(mapbuff, maplen);
+        tkc->buff = NULL;
+        tkc->bptr = NULL;
+        tkc->flags &= ~TK_FL_MMAP;
+        tkc->flags |= TK_FL_MALLOC;
+    }
+
     return res;
 
 }  /* tk_tokenize_input */
@@ -3179,6 +3351,272 @@ tk_chain_t *
 } /* tk_clone_chain */
 
 
+/********************************************************************
+* FUNCTION tk_add_warning
+* 
+* Record a warning for the current line of a token chain
+* so it can be saved with the chain by tk_save_chain
+* The warning itself is printed by the caller
+*
+* INPUTS:
+*   tkc == token chain to use
+*   res == warning status code
+*   val == res-specific value to save with the warning
+*
+* RETURNS:
+*    status
+*********************************************************************/
+status_t
+    tk_add_warning (tk_chain_t *tkc,
+                    status_t res,
+                    uint32 val)
+{
+    tk_warn_t  *warn;
+
+#ifdef DEBUG
+    if (!tkc) {
+        return SET_ERROR(ERR_INTERNAL_PTR);
+    }
+#endif
+
+    warn = m__getObj(tk_warn_t);
+    if (!warn) {
+        return ERR_INTERNAL_MEM;
+    }
+    memset(warn, 0x0, sizeof(tk_warn_t));
+    warn->res = res;
+    warn->linenum = tkc->linenum;
+    warn->linepos = tkc->linepos;
+    warn->val = val;
+    dlq_enque(warn, &tkc->warnQ);
+    return NO_ERR;
+
+} /* tk_add_warning */
+
+
+/********************************************************************
+* FUNCTION tk_save_chain
+* 
+* Write the tokens and recorded warnings in a token chain
+* to a binary file so the chain can be restored later with
+* tk_load_chain instead of tokenizing the source again
+*
+* DOCMODE chains are not supported since the original
+* token strings are not saved
+*
+* INPUTS:
+*   tkc == token chain to save
+*   fp == open file to write
+*
+* RETURNS:
+*    status
+*********************************************************************/
+status_t
+    tk_save_chain (const tk_chain_t *tkc,
+                   FILE *fp)
+{
+    const tk_token_t  *tk;
+    const tk_warn_t   *warn;
+    tk_cache_rec_t     rec;
+    tk_cache_warn_t    warnrec;
+    uint32             count;
+
+#ifdef DEBUG
+    if (!tkc || !fp) {
+        return SET_ERROR(ERR_INTERNAL_PTR);
+    }
+#endif
+
+    if (TK_DOCMODE(tkc)) {
+        return ERR_NCX_OPERATION_NOT_SUPPORTED;
+    }
+
+    count = dlq_count(&tkc->tkQ);
+    if (fwrite(&count, sizeof(count), 1, fp) != 1) {
+        return ERR_FIL_WRITE;
+    }
+
+    for (tk = (const tk_token_t *)dlq_firstEntry(&tkc->tkQ);
+         tk != NULL;
+         tk = (const tk_token_t *)dlq_nextEntry(tk)) {
+
+        memset(&rec, 0x0, sizeof(rec));
+        rec.typ = (uint32)tk->typ;
+        rec.linenum = tk->linenum;
+        rec.linepos = tk->linepos;
+        if (tk->val) {
+            rec.flags |= TK_CACHE_FL_VAL;
+            rec.len = tk->len;
+        }
+        if (tk->mod) {
+            rec.flags |= TK_CACHE_FL_MOD;
+            rec.modlen = tk->modlen;
+        }
+
+        if (fwrite(&rec, sizeof(rec), 1, fp) != 1) {
+            return ERR_FIL_WRITE;
+        }
+        if (rec.len && fwrite(tk->val, rec.len, 1, fp) != 1) {
+            return ERR_FIL_WRITE;
+        }
+        if (rec.modlen && fwrite(tk->mod, rec.modlen, 1, fp) != 1) {
+            return ERR_FIL_WRITE;
+        }
+    }
+
+    count = dlq_count(&tkc->warnQ);
+    if (fwrite(&count, sizeof(count), 1, fp) != 1) {
+        return ERR_FIL_WRITE;
+    }
+
+    for (warn = (const tk_warn_t *)dlq_firstEntry(&tkc->warnQ);
+         warn != NULL;
+         warn = (const tk_warn_t *)dlq_nextEntry(warn)) {
+
+        warnrec.res = (uint32)warn->res;
+        warnrec.linenum = warn->linenum;
+        warnrec.linepos = warn->linepos;
+        warnrec.val = warn->val;
+        if (fwrite(&warnrec, sizeof(warnrec), 1, fp) != 1) {
+            return ERR_FIL_WRITE;
+        }
+    }
+
+    return NO_ERR;
+
+} /* tk_save_chain */
+
+
+/********************************************************************
+* FUNCTION tk_load_chain
+* 
+* Fill an empty token chain with the tokens
+* saved by tk_save_chain
+*
+* INPUTS:
+*   tkc == empty token chain to fill
+*   fp == open file to read, positioned at the start
+*         of the data written by tk_save_chain
+*
+* OUTPUTS:
+*   tkc->tkQ is filled with the saved tokens
+*   tkc->warnQ is filled with the saved warnings
+*   tkc->cur is reset to the start of the chain
+*
+* RETURNS:
+*    status; the chain is emptied if any error is returned
+*********************************************************************/
+status_t
+    tk_load_chain (tk_chain_t *tkc,
+                   FILE *fp)
+{
+    tk_token_t      *tk;
+    tk_warn_t       *warn;
+    tk_cache_rec_t   rec;
+    tk_cache_warn_t  warnrec;
+    uint32           count, i;
+    status_t         res;
+
+#ifdef DEBUG
+    if (!tkc || !fp) {
+        return SET_ERROR(ERR_INTERNAL_PTR);
+    }
+#endif
+
+    if (fread(&count, sizeof(count), 1, fp) != 1) {
+        return ERR_FIL_READ;
+    }
+
+    res = NO_ERR;
+    for (i = 0; i < count && res == NO_ERR; i++) {
+        if (fread(&rec, sizeof(rec), 1, fp) != 1) {
+            res = ERR_FIL_READ;
+            continue;
+        }
+        if (rec.typ > TK_TT_NEWLINE ||
+            rec.len > NCX_MAX_STRLEN ||
+            rec.modlen > NCX_MAX_STRLEN) {
+            res = ERR_NCX_INVALID_VALUE;
+            continue;
+        }
+
+        tk = new_token((tk_type_t)rec.typ, NULL, 0);
+        if (!tk) {
+            res = ERR_INTERNAL_MEM;
+            continue;
+        }
+        tk->linenum = rec.linenum;
+        tk->linepos = rec.linepos;
+        dlq_enque(tk, &tkc->tkQ);
+
+        if (rec.flags & TK_CACHE_FL_VAL) {
+            tk->val = m__getMem(rec.len+1);
+            if (!tk->val) {
+                res = ERR_INTERNAL_MEM;
+                continue;
+            }
+            if (rec.len && fread(tk->val, rec.len, 1, fp) != 1) {
+                res = ERR_FIL_READ;
+                continue;
+            }
+            tk->val[rec.len] = 0;
+            tk->len = rec.len;
+        }
+
+        if (rec.flags & TK_CACHE_FL_MOD) {
+            tk->mod = m__getMem(rec.modlen+1);
+            if (!tk->mod) {
+                res = ERR_INTERNAL_MEM;
+                continue;
+            }
+            if (rec.modlen && fread(tk->mod, rec.modlen, 1, fp) != 1) {
+                res = ERR_FIL_READ;
+                continue;
+            }
+            tk->mod[rec.modlen] = 0;
+            tk->modlen = rec.modlen;
+        }
+    }
+
+    if (res == NO_ERR && fread(&count, sizeof(count), 1, fp) != 1) {
+        res = ERR_FIL_READ;
+    }
+
+    for (i = 0; i < count && res == NO_ERR; i++) {
+        if (fread(&warnrec, sizeof(warnrec), 1, fp) != 1) {
+            res = ERR_FIL_READ;
+            continue;
+        }
+        warn = m__getObj(tk_warn_t);
+        if (!warn) {
+            res = ERR_INTERNAL_MEM;
+            continue;
+        }
+        memset(warn, 0x0, sizeof(tk_warn_t));
+        warn->res = (status_t)warnrec.res;
+        warn->linenum = warnrec.linenum;
+        warn->linepos = warnrec.linepos;
+        warn->val = warnrec.val;
+        dlq_enque(warn, &tkc->warnQ);
+    }
+
+    if (res != NO_ERR) {
+        while (!dlq_empty(&tkc->tkQ)) {
+            tk = (tk_token_t *)dlq_deque(&tkc->tkQ);
+            free_token(tk);
+        }
+        while (!dlq_empty(&tkc->warnQ)) {
+            warn = (tk_warn_t *)dlq_deque(&tkc->warnQ);
+            m__free(warn);
+        }
+    }
+
+    tkc->cur = (tk_token_t *)&tkc->tkQ;
+    return res;
+
+} /* tk_load_chain */
+
+
 /********************************************************************
 * FUNCTION tk_add_id_token
 * 
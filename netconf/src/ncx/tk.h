@@ -180,6 +180,13 @@ extern "C" {
  */
 #define TK_FL_DOCMODE     bit2
 
+/* == 1: the YANG source file is mapped into tkc->buff
+ *       as one buffer by tk_tokenize_input, instead of
+ *       being read one line at a time
+ * == 0: tkc->buff holds the current line or string
+ */
+#define TK_FL_MMAP        bit3
+
 
 
 
@@ -301,11 +308,25 @@ typedef struct tk_token_ptr_t_ {
 } tk_token_ptr_t;
 
 
+/* warning reported while a chain was tokenized, kept so
+ * it can be saved with the chain and reported again when
+ * the chain is restored by tk_load_chain
+ */
+typedef struct tk_warn_t_ {
+    dlq_hdr_t       qhdr;
+    status_t        res;
+    uint32          linenum;
+    uint32          linepos;
+    uint32          val;              /* res-specific value */
+} tk_warn_t;
+
+
 /* token parsing chain */
 typedef struct tk_chain_t_ {
     dlq_hdr_t      qhdr;
     dlq_hdr_t      tkQ;            /* Q of tk_token_t */
     dlq_hdr_t      tkptrQ;     /* Q of tk_token_ptr_t */
+    dlq_hdr_t      warnQ;         /* Q of tk_warn_t */
     tk_token_t    *cur;
     ncx_error_t   *curerr;
     const xmlChar *filename;
@@ -708,6 +729,73 @@ extern tk_chain_t *
     tk_clone_chain (tk_chain_t *oldtkc);
 
 
+/********************************************************************
+* FUNCTION tk_add_warning
+* 
+* Record a warning for the current line of a token chain
+* so it can be saved with the chain by tk_save_chain
+* The warning itself is printed by the caller
+*
+* INPUTS:
+*   tkc == token chain to use
+*   res == warning status code
+*   val == res-specific value to save with the warning
+*
+* RETURNS:
+*    status
+*********************************************************************/
+extern status_t
+    tk_add_warning (tk_chain_t *tkc,
+                    status_t res,
+                    uint32 val);
+
+
+/********************************************************************
+* FUNCTION tk_save_chain
+* 
+* Write the tokens and recorded warnings in a token chain
+* to a binary file so the chain can be restored later with
+* tk_load_chain instead of tokenizing the source again
+*
+* DOCMODE chains are not supported since the original
+* token strings are not saved
+*
+* INPUTS:
+*   tkc == token chain to save
+*   fp == open file to write
+*
+* RETURNS:
+*    status
+*********************************************************************/
+extern status_t
+    tk_save_chain (const tk_chain_t *tkc,
+                   FILE *fp);
+
+
+/********************************************************************
+* FUNCTION tk_load_chain
+* 
+* Fill an empty token chain with the tokens
+* saved by tk_save_chain
+*
+* INPUTS:
+*   tkc == empty token chain to fill
+*   fp == open file to read, positioned at the start
+*         of the data written by tk_save_chain
+*
+* OUTPUTS:
+*   tkc->tkQ is filled with the saved tokens
+*   tkc->warnQ is filled with the saved warnings
+*   tkc->cur is reset to the start of the chain
+*
+* RETURNS:
+*    status; the chain is emptied if any error is returned
+*********************************************************************/
+extern status_t
+    tk_load_chain (tk_chain_t *tkc,
+                   FILE *fp);
+
+
 /********************************************************************
 * FUNCTION tk_add_id_token
 * 
@@ -418,4 +418,24 @@ void
 } /* tstamp_datetime_dirname */
 
 
+/********************************************************************
+* FUNCTION tstamp_monotonic_usec
+*
+* Get the monotonic clock time in microseconds,
+* for measuring elapsed times
+*
+* RETURNS:
+*   current monotonic time in usec
+*********************************************************************/
+uint64
+    tstamp_monotonic_usec (void)
+{
+    struct timespec  tp;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &tp);
+    return (uint64)tp.tv_sec * 1000000 + (uint64)(tp.tv_nsec / 1000);
+
+} /* tstamp_monotonic_usec */
+
+
 /* END file tstamp.c */
@@ -131,6 +131,19 @@ extern xmlChar *
 extern void 
     tstamp_datetime_dirname (xmlChar *buff);
 
+
+/********************************************************************
+* FUNCTION tstamp_monotonic_usec
+*
+* Get the monotonic clock time in microseconds,
+* for measuring elapsed times
+*
+* RETURNS:
+*   current monotonic time in usec
+*********************************************************************/
+extern uint64
+    tstamp_monotonic_usec (void);
+
 #ifdef __cplusplus
 }  /* end extern 'C' */
 #endif
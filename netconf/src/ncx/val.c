@@ -106,6 +106,15 @@ static uint32 editvars_malloc = 0;
 static uint32 editvars_free = 0;
 #endif
 
+/* virtual value cache counters */
+static uint32 vcache_hits = 0;
+static uint32 vcache_misses = 0;
+
+/* all cached virtual values retrieved at or before
+ * this uptime are stale; 0 if never invalidated
+ */
+static time_t vcache_flushtime = 0;
+
 
 /********************************************************************
 * FUNCTION stdout_num
@@ -1155,6 +1164,80 @@ static status_t
 }  /* copy_editvars */
 
 
+/********************************************************************
+* FUNCTION virtual_value_fresh
+* 
+* Check if the cached value of a virtual value node
+* can still be used
+*
+* INPUTS:
+*   scb == session control block getting the virtual value
+*          the scb->cache_timeout value will be used
+*          id scb is not NULL
+*   val == virtual value with a cached value to check
+*
+* The cache time set for val->obj with val_set_virtual_cache_time
+* replaces the session or server timeout.  A value that was
+* invalidated is never fresh.  A value fetched for the reply
+* in progress is always fresh.
+*
+* RETURNS:
+*   TRUE if val->virtualval can be used
+*   FALSE if it needs a refresh
+*********************************************************************/
+static boolean
+    virtual_value_fresh (const ses_cb_t *scb,
+                         const val_value_t *val)
+{
+    time_t       timenow;
+    double       timediff, timerval;
+    uint32       deftimeout;
+
+    /* check if the value was invalidated after it was cached */
+    if (val->flags & VAL_FL_VIRTUAL_STALE) {
+        return FALSE;
+    }
+
+    /* the value was fetched for the reply in progress */
+    if (val->flags & VAL_FL_VIRTUAL_FETCHED) {
+        return TRUE;
+    }
+
+    (void)uptime(&timenow);
+    timediff = difftime(timenow, val->cachetime);
+
+    if (val->obj && val->obj->vcachetime != VAL_VIRTUAL_CACHE_DEFAULT) {
+        if (val->obj->vcachetime == 0) {
+            return FALSE;
+        }
+        timerval = (double)val->obj->vcachetime;
+    } else if (scb != NULL) {
+        if (scb->cache_timeout == 0) {
+            return FALSE;
+        }
+        timerval = (double)scb->cache_timeout;
+    } else {
+        deftimeout = ncx_get_vtimeout_value();
+        timerval = (double)deftimeout;
+    }
+
+    if (vcache_flushtime && val->cachetime <= vcache_flushtime) {
+        return FALSE;
+    }
+    if (val->obj && val->obj->vflushtime &&
+        val->cachetime <= val->obj->vflushtime) {
+        return FALSE;
+    }
+
+    if (LOGDEBUG4) {
+        log_debug4("\nval: virtual val timer %e", timediff);
+    }
+
+    return (timediff >= timerval) ? FALSE : TRUE;
+
+}  /* virtual_value_fresh */
+
+
 /********************************************************************
 * FUNCTION cache_virtual_value
 * 
@@ -1193,10 +1276,6 @@ static val_value_t *
 {
     val_value_t *retval;
     getcb_fn_t   getcb;
-    time_t       timenow;
-    double       timediff, timerval;
-    uint32       deftimeout;
-    boolean      disable_cache;
     val_virt_getcb_node_t * getcb_node;
 
     *res = NO_ERR;
@@ -1206,29 +1285,19 @@ static val_value_t *
         return NULL;
     }
 
+    /* the asynchronous get missed the deadline for this reply;
+     * a virtual list has no single value node
+     */
+    if (val->flags & (VAL_FL_VIRTUAL_TIMEOUT | VAL_FL_VIRTUAL_LIST)) {
+        *res = ERR_NCX_SKIPPED;
+        return NULL;
+    }
+
     getcb = (getcb_fn_t)val->getcb;
 
     if (val->virtualval != NULL) {
         /* already have a value; check if it is fresh enough */
-        (void)uptime(&timenow);
-        timediff = difftime(timenow, val->cachetime);
-
-        disable_cache = FALSE;
-        if (scb != NULL) {
-            timerval = (double)scb->cache_timeout;
-            if (scb->cache_timeout == 0) {
-                disable_cache = TRUE;
-            }
-        } else {
-            deftimeout = ncx_get_vtimeout_value();
-            timerval = (double)deftimeout;
-        }
-
-        if (LOGDEBUG4) {
-            log_debug4("\nval: virtual val timer %e", timediff);
-        }
-
-        if (disable_cache || (timediff >= timerval)) {
+        if (!virtual_value_fresh(scb, val)) {
             if (LOGDEBUG4) {
                 log_debug4("\nval: refresh virtual val %s",
                            val->name);
@@ -1236,10 +1305,14 @@ static val_value_t *
             val_free_value(val->virtualval);
             val->virtualval = NULL;
         } else {
+            vcache_hits++;
             return val->virtualval;
         }
     }
 
+    vcache_misses++;
+    val->flags &= ~VAL_FL_VIRTUAL_STALE;
+
     /* first get or stale and need a refresh */
     retval = val_new_value();
     if (!retval) {
@@ -1633,6 +1706,37 @@ void
 }  /* val_init_virtual */
 
 
+/********************************************************************
+* FUNCTION val_init_virtual_list
+* 
+* Special function to initialize a virtual list node
+* that stands for all the entries of a list
+*
+* MUST CALL val_new_value FIRST
+*
+* INPUTS:
+*   val == pointer to the malloced struct to initialize
+*   bulkfn == getcb_bulk_fn_t callback function to use
+*   obj == list object template to use
+*********************************************************************/
+void
+    val_init_virtual_list (val_value_t *val,
+                           void  *bulkfn,
+                           obj_template_t *obj)
+{
+#ifdef DEBUG
+    if (!val || !bulkfn || !obj) {
+        SET_ERROR(ERR_INTERNAL_PTR);
+        return;
+    }
+#endif
+
+    val_init_virtual(val, bulkfn, obj);
+    val->flags |= VAL_FL_VIRTUAL_LIST;
+
+}  /* val_init_virtual_list */
+
+
 /********************************************************************
 * FUNCTION val_init_from_template
 * 
@@ -8891,6 +8995,31 @@ boolean
 }  /* val_is_virtual */
 
 
+/********************************************************************
+* FUNCTION val_is_virtual_list
+* 
+* Check if the specified value is a virtual list node
+* such that a getcb_bulk_fn_t callback function is required
+* to access the list entries
+* 
+* INPUTS:
+*   val == value to check
+*   
+* RETURNS:
+*   TRUE if the val is a virtual list node
+*   FALSE otherwise
+*********************************************************************/
+boolean
+    val_is_virtual_list (const val_value_t *val)
+{
+    assert( val && "val is NULL!" );
+
+    return (val->getcb && (val->flags & VAL_FL_VIRTUAL_LIST)) ?
+        TRUE : FALSE;
+
+}  /* val_is_virtual_list */
+
+
 /********************************************************************
 * FUNCTION val_get_virtual_value
 * 
@@ -8952,6 +9081,137 @@ val_value_t *
 }  /* val_get_virtual_value */
 
 
+/********************************************************************
+* FUNCTION val_virtual_value_cached
+* 
+* Check if a virtual value node has a cached value that
+* val_get_virtual_value would return without calling
+* the get callback
+*
+* INPUTS:
+*   session == session CB ptr cast as void *
+*              that is getting the virtual value
+*   val == virtual value node to check
+*
+* RETURNS:
+*   TRUE if the cached value is still fresh
+*   FALSE if the get callback would be called
+*********************************************************************/
+boolean
+    val_virtual_value_cached (void *session,
+                              const val_value_t *val)
+{
+    assert( val && "val is NULL!" );
+
+    if (val->virtualval == NULL) {
+        return FALSE;
+    }
+    return virtual_value_fresh((const ses_cb_t *)session, val);
+
+}  /* val_virtual_value_cached */
+
+
+/********************************************************************
+* FUNCTION val_set_virtual_cache_time
+* 
+* Set the virtual value cache time for all the virtual
+* value nodes of an object.  This replaces the session or
+* server cache timeout for these nodes, so slowly changing data
+* can be kept longer and fast changing data is always retrieved
+*
+* INPUTS:
+*   obj == object template for the virtual nodes
+*   seconds == number of seconds to keep a retrieved value
+*              0 to call the get callback every time
+*              VAL_VIRTUAL_CACHE_DEFAULT to use the session
+*              or server cache timeout
+*********************************************************************/
+void
+    val_set_virtual_cache_time (obj_template_t *obj,
+                                int32 seconds)
+{
+    assert( obj && "obj is NULL!" );
+
+    if (seconds < 0) {
+        seconds = VAL_VIRTUAL_CACHE_DEFAULT;
+    }
+    obj->vcachetime = seconds;
+
+}  /* val_set_virtual_cache_time */
+
+
+/********************************************************************
+* FUNCTION val_invalidate_virtual_value
+* 
+* Mark the cached value of a virtual value node as stale
+* The get callback will be called the next time it is used
+*
+* INPUTS:
+*   val == virtual value node to invalidate
+*********************************************************************/
+void
+    val_invalidate_virtual_value (val_value_t *val)
+{
+    assert( val && "val is NULL!" );
+
+    /* the cached value may still be in use by a reply
+     * in progress, so it is replaced on the next get
+     */
+    if (val->virtualval) {
+        val->flags |= VAL_FL_VIRTUAL_STALE;
+    }
+
+}  /* val_invalidate_virtual_value */
+
+
+/********************************************************************
+* FUNCTION val_invalidate_virtual_cache
+* 
+* Mark the cached values of all the virtual value nodes of
+* an object as stale, without searching for the value nodes
+* The get callbacks will be called the next time they are used
+*
+* INPUTS:
+*   obj == object template for the virtual nodes
+*       == NULL to invalidate the cached values of all objects
+*********************************************************************/
+void
+    val_invalidate_virtual_cache (obj_template_t *obj)
+{
+    time_t  timenow;
+
+    (void)uptime(&timenow);
+    if (obj) {
+        obj->vflushtime = timenow;
+    } else {
+        vcache_flushtime = timenow;
+    }
+
+}  /* val_invalidate_virtual_cache */
+
+
+/********************************************************************
+* FUNCTION val_get_virtual_cache_stats
+* 
+* Get the virtual value cache counters
+*
+* OUTPUTS:
+*   *hits == number of times a cached virtual value was used
+*   *misses == number of times a get callback was called
+*********************************************************************/
+void
+    val_get_virtual_cache_stats (uint32 *hits,
+                                 uint32 *misses)
+{
+    assert( hits && "hits is NULL!" );
+    assert( misses && "misses is NULL!" );
+
+    *hits = vcache_hits;
+    *misses = vcache_misses;
+
+}  /* val_get_virtual_cache_stats */
+
+
 /********************************************************************
 * FUNCTION val_is_default
 * 
@@ -179,9 +179,32 @@ extern "C" {
  */
 #define VAL_FL_SUBTREE_DIRTY bit10
 
+/* if set, the cached virtualval has been invalidated
+ * and will be replaced the next time it is used
+ */
+#define VAL_FL_VIRTUAL_STALE bit11
+
+/* if set, the asynchronous get for this virtual node missed
+ * the deadline and the node is skipped in the reply in progress
+ */
+#define VAL_FL_VIRTUAL_TIMEOUT bit12
+
+/* if set, the virtual value was fetched for the reply in progress
+ * and is used without checking the cache time
+ */
+#define VAL_FL_VIRTUAL_FETCHED bit13
+
+/* if set, the virtual node is a place-holder for all the
+ * entries of a list and the getcb field is a getcb_bulk_fn_t
+ */
+#define VAL_FL_VIRTUAL_LIST bit14
+
 /* set the virtualval lifetime to 3 seconds */
 #define VAL_VIRTUAL_CACHE_TIME   3
 
+/* obj->vcachetime value to use the session cache timeout */
+#define VAL_VIRTUAL_CACHE_DEFAULT  -1
+
 
 /* macros to access simple value types */
 #define VAL_BOOL(V)    ((V)->v.boo)
@@ -529,6 +552,25 @@ extern void
 		      struct obj_template_t_ *obj);
 
 
+/********************************************************************
+* FUNCTION val_init_virtual_list
+* 
+* Special function to initialize a virtual list node
+* that stands for all the entries of a list
+*
+* MUST CALL val_new_value FIRST
+*
+* INPUTS:
+*   val == pointer to the malloced struct to initialize
+*   bulkfn == getcb_bulk_fn_t callback function to use
+*   obj == list object template to use
+*********************************************************************/
+extern void
+    val_init_virtual_list (val_value_t *val,
+			   void *bulkfn,
+			   struct obj_template_t_ *obj);
+
+
 /********************************************************************
 * FUNCTION val_init_from_template
 * 
@@ -2950,6 +2992,24 @@ extern boolean
     val_is_virtual (const val_value_t *val);
 
 
+/********************************************************************
+* FUNCTION val_is_virtual_list
+* 
+* Check if the specified value is a virtual list node
+* such that a getcb_bulk_fn_t callback function is required
+* to access the list entries
+* 
+* INPUTS:
+*   val == value to check
+*   
+* RETURNS:
+*   TRUE if the val is a virtual list node
+*   FALSE otherwise
+*********************************************************************/
+extern boolean
+    val_is_virtual_list (const val_value_t *val);
+
+
 /********************************************************************
 * FUNCTION val_get_virtual_value
 * 
@@ -2991,6 +3051,89 @@ extern val_value_t *
 			   status_t *res);
 
 
+/********************************************************************
+* FUNCTION val_virtual_value_cached
+* 
+* Check if a virtual value node has a cached value that
+* val_get_virtual_value would return without calling
+* the get callback
+*
+* INPUTS:
+*   session == session CB ptr cast as void *
+*              that is getting the virtual value
+*   val == virtual value node to check
+*
+* RETURNS:
+*   TRUE if the cached value is still fresh
+*   FALSE if the get callback would be called
+*********************************************************************/
+extern boolean
+    val_virtual_value_cached (void *session,  /* really ses_cb_t *   */
+			      const val_value_t *val);
+
+
+/********************************************************************
+* FUNCTION val_set_virtual_cache_time
+* 
+* Set the virtual value cache time for all the virtual
+* value nodes of an object.  This replaces the session or
+* server cache timeout for these nodes, so slowly changing data
+* can be kept longer and fast changing data is always retrieved
+*
+* INPUTS:
+*   obj == object template for the virtual nodes
+*   seconds == number of seconds to keep a retrieved value
+*              0 to call the get callback every time
+*              VAL_VIRTUAL_CACHE_DEFAULT to use the session
+*              or server cache timeout
+*********************************************************************/
+extern void
+    val_set_virtual_cache_time (struct obj_template_t_ *obj,
+                                int32 seconds);
+
+
+/********************************************************************
+* FUNCTION val_invalidate_virtual_value
+* 
+* Mark the cached value of a virtual value node as stale
+* The get callback will be called the next time it is used
+*
+* INPUTS:
+*   val == virtual value node to invalidate
+*********************************************************************/
+extern void
+    val_invalidate_virtual_value (val_value_t *val);
+
+
+/********************************************************************
+* FUNCTION val_invalidate_virtual_cache
+* 
+* Mark the cached values of all the virtual value nodes of
+* an object as stale, without searching for the value nodes
+* The get callbacks will be called the next time they are used
+*
+* INPUTS:
+*   obj == object template for the virtual nodes
+*       == NULL to invalidate the cached values of all objects
+*********************************************************************/
+extern void
+    val_invalidate_virtual_cache (struct obj_template_t_ *obj);
+
+
+/********************************************************************
+* FUNCTION val_get_virtual_cache_stats
+* 
+* Get the virtual value cache counters
+*
+* OUTPUTS:
+*   *hits == number of times a cached virtual value was used
+*   *misses == number of times a get callback was called
+*********************************************************************/
+extern void
+    val_get_virtual_cache_stats (uint32 *hits,
+                                 uint32 *misses);
+
+
 /********************************************************************
 * FUNCTION val_is_default
 * 
@@ -64,6 +64,20 @@ date         init     comment
 *********************************************************************/
 /* #define VAL_UTIL_DEBUG_CANONICAL 1 */
 
+
+/********************************************************************
+*                                                                   *
+*                            T Y P E S                              *
+*                                                                   *
+*********************************************************************/
+
+/* list entry and its original position, for a stable sort */
+typedef struct val_sort_entry_t_ {
+    val_value_t  *val;
+    uint32        pos;
+} val_sort_entry_t;
+
+
 /********************************************************************
 * FUNCTION new_index
 * 
@@ -854,6 +868,144 @@ static status_t
 } /* check_when_stmt */
 
 
+/********************************************************************
+* FUNCTION compare_sort_entries
+*
+* qsort compare function to sort list entries by key,
+* keeping entries with the same key in the original order
+*
+* INPUTS:
+*    p1 == pointer to the 1st sort entry
+*    p2 == pointer to the 2nd sort entry
+* RETURNS:
+*    -1, 0 or 1
+*********************************************************************/
+static int
+    compare_sort_entries (const void *p1,
+                          const void *p2)
+{
+    const val_sort_entry_t *ent1 = (const val_sort_entry_t *)p1;
+    const val_sort_entry_t *ent2 = (const val_sort_entry_t *)p2;
+    int32 ret;
+
+    ret = val_index_compare(ent1->val, ent2->val);
+    if (ret < 0) {
+        return -1;
+    } else if (ret > 0) {
+        return 1;
+    }
+    return (ent1->pos < ent2->pos) ? -1 : 1;
+
+} /* compare_sort_entries */
+
+
+/********************************************************************
+* FUNCTION sort_list_entries
+*
+* Sort the entries of a system ordered list by key
+* The entries are left in place if any of them
+* does not have all the keys
+*
+* INPUTS:
+*    entryQ == Q of list entries to sort
+*
+* OUTPUTS:
+*    entryQ is sorted
+*********************************************************************/
+static void
+    sort_list_entries (dlq_hdr_t *entryQ)
+{
+    val_sort_entry_t *sortA;
+    val_value_t      *chval;
+    uint32            count, keycnt, i;
+
+    count = dlq_count(entryQ);
+    chval = (val_value_t *)dlq_firstEntry(entryQ);
+    keycnt = obj_key_count(chval->obj);
+    if (keycnt == 0) {
+        return;
+    }
+
+    for (; chval != NULL; chval = (val_value_t *)dlq_nextEntry(chval)) {
+        if (dlq_count(&chval->indexQ) != keycnt) {
+            return;
+        }
+    }
+
+    sortA = m__getMem(count * sizeof(val_sort_entry_t));
+    if (sortA == NULL) {
+        return;
+    }
+
+    for (i = 0; i < count; i++) {
+        sortA[i].val = (val_value_t *)dlq_deque(entryQ);
+        sortA[i].pos = i;
+    }
+    qsort(sortA, count, sizeof(val_sort_entry_t), compare_sort_entries);
+    for (i = 0; i < count; i++) {
+        dlq_enque(sortA[i].val, entryQ);
+    }
+    m__free(sortA);
+
+} /* sort_list_entries */
+
+
+/********************************************************************
+* FUNCTION add_list_entries
+*
+* Move all the entries of one list from the tempQ to the
+* parent node in canonical order
+*
+* The entries are sorted once if the list is system ordered
+* and kept sorted, instead of adding each one in its sorted
+* place among the entries added before it
+*
+* INPUTS:
+*    val == parent value node
+*    tempQ == Q of child nodes not added to val yet
+*    chobj == list object of the entries to move
+*
+* OUTPUTS:
+*    list entries moved from the tempQ to val
+*********************************************************************/
+static void
+    add_list_entries (val_value_t *val,
+                      dlq_hdr_t *tempQ,
+                      obj_template_t *chobj)
+{
+    dlq_hdr_t     entryQ;
+    val_value_t  *chval, *lastval = NULL;
+
+    dlq_createSQue(&entryQ);
+
+    chval = val_find_child_que(tempQ, obj_get_mod_name(chobj),
+                               obj_get_name(chobj));
+    while (chval) {
+        dlq_remove(chval);
+        dlq_enque(chval, &entryQ);
+        chval = val_find_child_que(tempQ, obj_get_mod_name(chobj),
+                                   obj_get_name(chobj));
+    }
+
+    if (dlq_count(&entryQ) > 1 && obj_is_system_ordered(chobj) &&
+        ncx_get_system_sorted()) {
+        sort_list_entries(&entryQ);
+    }
+
+    while (!dlq_empty(&entryQ)) {
+        chval = (val_value_t *)dlq_deque(&entryQ);
+        if (lastval == NULL) {
+            val_add_child_sorted(chval, val);
+        } else {
+            val_insert_child(chval, lastval, val);
+        }
+        lastval = chval;
+        val_set_canonical_order(chval);
+    }
+
+} /* add_list_entries */
+
+
 /*************** E X T E R N A L    F U N C T I O N S  *************/
 
 
@@ -1004,6 +1156,11 @@ void
                 continue;
             }
 
+            if (chobj->objtype == OBJ_TYP_LIST) {
+                add_list_entries(val, &tempQ, chobj);
+                continue;
+            }
+
             chval = val_find_child_que(&tempQ, obj_get_mod_name(chobj),
                                        obj_get_name(chobj));
             while (chval) {
@@ -3381,7 +3538,10 @@ val_value_t *
         }
     }
 
-    if (acmcheck && msg->acm_cbfn) {
+    /* acm_skip is set if an ancestor already passed the
+     * read check for its entire subtree
+     */
+    if (acmcheck && msg->acm_cbfn && !msg->acm_skip) {
         xml_msg_authfn_t cbfn = (xml_msg_authfn_t)msg->acm_cbfn;
         boolean acmtest = (*cbfn)(msg, scb->username, val);
         if (!acmtest) {
@@ -97,6 +97,12 @@ static void
               xmlns_pmap_t *newpmap)
 {
     xmlns_pmap_t  *pmap;
+    uint32         hash;
+
+    /* add the new prefix mapping to the hash bucket */
+    hash = newpmap->nm_id % XML_MSG_PMAP_HASH_SIZE;
+    newpmap->nm_hashnext = msg->pmaphash[hash];
+    msg->pmaphash[hash] = newpmap;
 
     /* add the new prefix mapping */
     for (pmap = (xmlns_pmap_t *)dlq_firstEntry(&msg->prefixQ);
@@ -130,14 +136,12 @@ static xmlns_pmap_t *
 {
     xmlns_pmap_t  *pmap;
 
-    for (pmap = (xmlns_pmap_t *)dlq_firstEntry(&msg->prefixQ);
+    for (pmap = msg->pmaphash[nsid % XML_MSG_PMAP_HASH_SIZE];
          pmap != NULL;
-         pmap = (xmlns_pmap_t *)dlq_nextEntry(pmap)) {
+         pmap = pmap->nm_hashnext) {
 
         if (pmap->nm_id == nsid) {
             return pmap;
-        } else if (pmap->nm_id > nsid) {
-            return NULL;
         }
     }
     return NULL;
@@ -163,15 +167,9 @@ static const xmlChar *
 {
     const xmlns_pmap_t  *pmap;
 
-    for (pmap = (const xmlns_pmap_t *)dlq_firstEntry(&msg->prefixQ);
-         pmap != NULL;
-         pmap = (const xmlns_pmap_t *)dlq_nextEntry(pmap)) {
-
-        if (pmap->nm_id == nsid) {
-            return (const xmlChar *)pmap->nm_pfix;
-        } else if (pmap->nm_id > nsid) {
-            return NULL;
-        }
+    pmap = find_pmap(msg, nsid);
+    if (pmap) {
+        return (const xmlChar *)pmap->nm_pfix;
     }
     return NULL;
 
@@ -414,6 +412,7 @@ void
     xml_msg_clean_hdr (xml_msg_hdr_t *msg)
 {
     xmlns_pmap_t   *pmap;
+    uint32          i;
 
 #ifdef DEBUG
     if (!msg) {
@@ -422,11 +421,23 @@ void
     }
 #endif
 
+    /* clean tag cache; the tags use the prefixes being freed */
+    if (msg->tagcache) {
+        for (i = 0; i < XML_MSG_TAG_CACHE_SIZE; i++) {
+            if (msg->tagcache[i].starttag) {
+                m__free(msg->tagcache[i].starttag);
+            }
+        }
+        m__free(msg->tagcache);
+        msg->tagcache = NULL;
+    }
+
     /* clean prefix queue */
     while (!dlq_empty(&msg->prefixQ)) {
         pmap = (xmlns_pmap_t *)dlq_deque(&msg->prefixQ);
         xmlns_free_pmap(pmap);
     }
+    memset(msg->pmaphash, 0x0, sizeof(msg->pmaphash));
 
     /* clean error queue */
     rpc_err_clean_errQ(&msg->errQ);
@@ -655,6 +666,101 @@ const xmlChar *
 }  /* xml_msg_get_prefix_start_tag */
 
 
+/********************************************************************
+* FUNCTION xml_msg_get_tag
+*
+* Get the start and end tags of an object element, rendered
+* with the prefix the message uses for the namespace ID.
+* The tags are cached in the message until xml_msg_clean_hdr
+* so each element is written with one copy per tag
+*
+* INPUTS:
+*    msg  == message in progress
+*    obj == object template of the element
+*    nsid == namespace ID of the element
+*    elname == element name; must be the name stored in obj
+*    pfix == prefix returned by xml_msg_get_prefix for nsid,
+*            or NULL if no prefix is used in element tags
+*
+* RETURNS:
+*   pointer to the cached tags; NULL if malloc failed
+*********************************************************************/
+const xml_msg_tag_t *
+    xml_msg_get_tag (xml_msg_hdr_t *msg,
+                     const obj_template_t *obj,
+                     xmlns_id_t nsid,
+                     const xmlChar *elname,
+                     const xmlChar *pfix)
+{
+    xml_msg_tag_t  *tag;
+    xmlChar        *buff, *str;
+    uint32          hash, namelen, pfixlen;
+
+    assert( msg && "msg is NULL" );
+    assert( obj && "obj is NULL" );
+    assert( elname && "elname is NULL" );
+
+    if (msg->tagcache == NULL) {
+        msg->tagcache = m__getMem(XML_MSG_TAG_CACHE_SIZE *
+                                  sizeof(xml_msg_tag_t));
+        if (msg->tagcache == NULL) {
+            return NULL;
+        }
+        memset(msg->tagcache, 0x0,
+               XML_MSG_TAG_CACHE_SIZE * sizeof(xml_msg_tag_t));
+    }
+
+    hash = (uint32)(((size_t)obj >> 4) ^ ((size_t)obj >> 12));
+    tag = &msg->tagcache[hash % XML_MSG_TAG_CACHE_SIZE];
+    if (tag->obj == obj && tag->elname == elname &&
+        tag->nsid == nsid && tag->pfix == pfix) {
+        return tag;
+    }
+
+    /* render the tags again and replace the slot entry */
+    namelen = xml_strlen(elname);
+    pfixlen = (pfix) ? xml_strlen(pfix) + 1 : 0;
+    buff = m__getMem(2 * (namelen + pfixlen) + 6);
+    if (buff == NULL) {
+        return NULL;
+    }
+    if (tag->starttag) {
+        m__free(tag->starttag);
+    }
+
+    tag->obj = obj;
+    tag->elname = elname;
+    tag->nsid = nsid;
+    tag->pfix = pfix;
+
+    str = buff;
+    tag->starttag = str;
+    *str++ = '<';
+    if (pfix) {
+        str += xml_strcpy(str, pfix);
+        *str++ = ':';
+    }
+    str += xml_strcpy(str, elname);
+    tag->startlen = (uint32)(str - tag->starttag);
+    *str++ = 0;
+
+    tag->endtag = str;
+    *str++ = '<';
+    *str++ = '/';
+    if (pfix) {
+        str += xml_strcpy(str, pfix);
+        *str++ = ':';
+    }
+    str += xml_strcpy(str, elname);
+    *str++ = '>';
+    *str = 0;
+    tag->endlen = (uint32)(str - tag->endtag);
+
+    return tag;
+
+}  /* xml_msg_get_tag */
+
+
 /********************************************************************
 * FUNCTION xml_msg_gen_new_prefix
 *
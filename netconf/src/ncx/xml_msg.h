@@ -69,6 +69,12 @@ extern "C" {
 *                                                                   *
 *********************************************************************/
 
+/* number of buckets in the prefixQ hash, indexed by namespace ID */
+#define XML_MSG_PMAP_HASH_SIZE   64
+
+/* number of slots in the start and end tag cache */
+#define XML_MSG_TAG_CACHE_SIZE   256
+
 
 /********************************************************************
 *                                                                   *
@@ -76,6 +82,21 @@ extern "C" {
 *                                                                   *
 *********************************************************************/
 
+/* Start and end tags of one object, rendered with the
+ * prefix that the message prefix map uses for its namespace
+ */
+typedef struct xml_msg_tag_t_ {
+    const struct obj_template_t_ *obj;
+    const xmlChar   *elname;          /* backptr to obj name */
+    xmlns_id_t       nsid;
+    const xmlChar   *pfix;      /* backptr to pmap prefix or NULL */
+    xmlChar         *starttag;              /* '<' pfix ':' name */
+    uint32           startlen;
+    xmlChar         *endtag;            /* '</' pfix ':' name '>' */
+    uint32           endlen;
+} xml_msg_tag_t;
+
+
 /* Common XML Message Header */
 typedef struct xml_msg_hdr_t_ {
     /* incoming: 
@@ -94,6 +115,12 @@ typedef struct xml_msg_hdr_t_ {
     dlq_hdr_t       prefixQ;             /* Q of xmlns_pmap_t */
     dlq_hdr_t       errQ;               /* Q of rpc_err_rec_t */
 
+    /* hash of the prefixQ entries, chained by nm_hashnext */
+    xmlns_pmap_t   *pmaphash[XML_MSG_PMAP_HASH_SIZE];
+
+    /* malloced on first use; XML_MSG_TAG_CACHE_SIZE entries */
+    xml_msg_tag_t  *tagcache;
+
     /* agent access control for database reads and writes;
      * !!! shadow pointer to per-session cache, not malloced
      */
@@ -104,6 +131,16 @@ typedef struct xml_msg_hdr_t_ {
      */
     void                    *acm_cbfn;
 
+    /* set by the read authorization callback if the node just
+     * checked is readable together with all its descendants
+     */
+    boolean                  acm_subtree;
+
+    /* TRUE while writing the descendants of a node that passed
+     * the ACM read check with acm_subtree set
+     */
+    boolean                  acm_skip;
+
 } xml_msg_hdr_t;
 
 
@@ -222,6 +259,33 @@ extern const xmlChar *
 				  xmlns_id_t nsid);
 
 
+/********************************************************************
+* FUNCTION xml_msg_get_tag
+*
+* Get the start and end tags of an object element, rendered
+* with the prefix the message uses for the namespace ID.
+* The tags are cached in the message until xml_msg_clean_hdr
+* so each element is written with one copy per tag
+*
+* INPUTS:
+*    msg  == message in progress
+*    obj == object template of the element
+*    nsid == namespace ID of the element
+*    elname == element name; must be the name stored in obj
+*    pfix == prefix returned by xml_msg_get_prefix for nsid,
+*            or NULL if no prefix is used in element tags
+*
+* RETURNS:
+*   pointer to the cached tags; NULL if malloc failed
+*********************************************************************/
+extern const xml_msg_tag_t *
+    xml_msg_get_tag (xml_msg_hdr_t *msg,
+		     const struct obj_template_t_ *obj,
+		     xmlns_id_t nsid,
+		     const xmlChar *elname,
+		     const xmlChar *pfix);
+
+
 /********************************************************************
 * FUNCTION xml_msg_gen_new_prefix
 *
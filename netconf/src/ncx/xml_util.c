@@ -1733,7 +1733,11 @@ xmlChar *
     }
 #endif
 
-    len = min(maxlen, xml_strlen(copyFrom));
+    /* do not scan past maxlen; copyFrom may be a slice 
+     * of a much longer buffer such as a mapped file */
+    for (len = 0; len < maxlen && copyFrom[len]; len++) {
+        ;
+    }
 
     /* get a string buffer */
     str = (xmlChar *)m__getMem(len+1);
@@ -35,6 +35,8 @@ date         init     comment
 
 #include "procdefs.h"
 #include "dlq.h"
+#include "getcb.h"
+#include "log.h"
 #include "ncx.h"
 #include "ncx_num.h"
 #include "ncxconst.h"
@@ -455,6 +457,7 @@ static void
     const xmlChar       *pfix,  *elname;
     const dlq_hdr_t     *attrQ;
     const xpath_pcb_t   *xpathpcb;
+    const xml_msg_tag_t *tag;
     boolean              xneeded, xmlcontent, isdefault;
     xmlns_id_t           nsid, parent_nsid;
     status_t             res;
@@ -492,16 +495,28 @@ static void
 
     ses_indent(scb, indent);
 
-    /* start the element and write the prefix, if any */
-    ses_putchar(scb, '<');
+    /* start the element and write the prefix, if any;
+     * the tag of a node named after its object is written
+     * from the message tag cache in one piece
+     */
     pfix = xml_msg_get_prefix(msg, parent_nsid, nsid, val, &xneeded);
-    if (pfix && msg->useprefix) {
-        ses_putstr(scb, pfix);
-        ses_putchar(scb, ':');
+    tag = NULL;
+    if (val->obj && val->dname == NULL) {
+        tag = xml_msg_get_tag(msg, val->obj, nsid, elname,
+                              (msg->useprefix) ? pfix : NULL);
     }
+    if (tag) {
+        ses_putbuff(scb, tag->starttag, tag->startlen);
+    } else {
+        ses_putchar(scb, '<');
+        if (pfix && msg->useprefix) {
+            ses_putstr(scb, pfix);
+            ses_putchar(scb, ':');
+        }
 
-    /* write the element name */
-    ses_putstr(scb, elname);
+        /* write the element name */
+        ses_putstr(scb, elname);
+    }
 
     /* write the wda:default element if needed
      * hack: bypass usual checking for xmlns needed because the
@@ -572,6 +587,52 @@ static void
 
 }  /* begin_elem_val */
 
+
+/********************************************************************
+* FUNCTION end_elem_val
+*
+* Write an end tag for the specified value node
+*
+* INPUTS:
+*   scb == session control block
+*   msg == top header from message in progress
+*   val  == value node to use
+*   indent == number of chars to indent after a newline
+*           == -1 means no newline or indent
+*           == 0 means just newline
+* RETURNS:
+*   none
+*********************************************************************/
+static void
+    end_elem_val (ses_cb_t *scb,
+                  xml_msg_hdr_t *msg,
+                  val_value_t *val,
+                  int32 indent)
+{
+    const xmlChar       *pfix;
+    const xml_msg_tag_t *tag;
+    boolean              xneeded;
+
+    if (val->obj == NULL || val->dname != NULL) {
+        xml_wr_end_elem(scb, msg, val->nsid, val->name, indent);
+        return;
+    }
+
+    pfix = NULL;
+    if (val->nsid && msg->useprefix) {
+        pfix = xml_msg_get_prefix(msg, 0, val->nsid, NULL, &xneeded);
+    }
+    tag = xml_msg_get_tag(msg, val->obj, val->nsid, val->name, pfix);
+    if (tag == NULL) {
+        xml_wr_end_elem(scb, msg, val->nsid, val->name, indent);
+        return;
+    }
+
+    ses_indent(scb, indent);
+    ses_putbuff(scb, tag->endtag, tag->endlen);
+
+}  /* end_elem_val */
+
 /******************************************************************************/
 /**
  * Write out an NCX Enum value.
@@ -823,6 +884,78 @@ static void write_slist_bits_val( ses_cb_t *scb,
     }
 }
 
+/* state of the virtual list in progress in write_virtual_list */
+typedef struct write_list_parms_t_ {
+    ses_cb_t          *scb;
+    xml_msg_hdr_t     *msg;
+    val_value_t       *listval;
+    int32              indent;
+    val_nodetest_fn_t  testfn;
+} write_list_parms_t;
+
+
+/******************************************************************************/
+/**
+ * Write out one list entry emitted by a getcb_bulk_fn_t.
+ * The entry is written as a child of the virtual list parent.
+ *
+ * \param cookie the write_list_parms_t in progress.
+ * \param entry the list entry to write.
+ * \return status
+ */
+static status_t write_list_entry( void *cookie,
+                                  val_value_t *entry )
+{
+    write_list_parms_t *parms = (write_list_parms_t *)cookie;
+    val_value_t        *saveparent = entry->parent;
+
+    entry->parent = parms->listval->parent;
+    xml_wr_full_check_val( parms->scb, parms->msg, entry, parms->indent,
+                           parms->testfn );
+    entry->parent = saveparent;
+    return NO_ERR;
+}
+
+/******************************************************************************/
+/**
+ * Write out all the entries of a virtual list node.
+ * The entries are written one at a time as the
+ * getcb_bulk_fn_t emits them.
+ * 
+ * \param scb the session control block.
+ * \param msg the message (xml_msg_hdr_t) being processed.
+ * \param listval the virtual list node to write.
+ * \param indent the start indent amount if indent is enabled.
+*  \param testfn callback function to use, NULL if not used
+ */
+static void write_virtual_list( ses_cb_t *scb,
+                                xml_msg_hdr_t *msg,
+                                val_value_t *listval,
+                                int32 indent,
+                                val_nodetest_fn_t testfn )
+{
+    getcb_bulk_fn_t     bulkfn = (getcb_bulk_fn_t)listval->getcb;
+    write_list_parms_t  parms;
+    status_t            res;
+
+    /* the list is skipped as a whole if the object is filtered out */
+    if (testfn && !(*testfn)(msg->withdef, TRUE, listval)) {
+        return;
+    }
+
+    parms.scb = scb;
+    parms.msg = msg;
+    parms.listval = listval;
+    parms.indent = indent;
+    parms.testfn = testfn;
+
+    res = (*bulkfn)(scb, listval, NULL, write_list_entry, &parms);
+    if (res != NO_ERR) {
+        log_error("\nError: get of virtual list '%s' failed (%s)",
+                  listval->name, get_error_string(res));
+    }
+}
+
 /******************************************************************************/
 /**
  * Write out an NCX String from a list or InstanceID value.
@@ -844,7 +977,11 @@ static void write_child_values( ses_cb_t *scb,
     for (chval = val_get_first_child(out);
          chval != NULL;
          chval = val_get_next_child(chval)) {
-        xml_wr_full_check_val( scb, msg, chval, indent, testfn );
+        if (val_is_virtual_list(chval)) {
+            write_virtual_list( scb, msg, chval, indent, testfn );
+        } else {
+            xml_wr_full_check_val( scb, msg, chval, indent, testfn );
+        }
     } 
 }
 
@@ -1120,8 +1257,10 @@ static void write_check_val ( ses_cb_t *scb,
     val_value_t *out;
     status_t res = NO_ERR;
     boolean malloced = FALSE;
+    boolean saveskip = msg->acm_skip;
 
     // Handle virtual values and check access control
+    msg->acm_subtree = FALSE;
     out = val_get_value(scb, msg, val, testfn, acmcheck, &malloced, &res);
     if ( !out || res != NO_ERR) {
         if (out && malloced) {
@@ -1131,6 +1270,11 @@ static void write_check_val ( ses_cb_t *scb,
         return;
     } 
 
+    /* the whole subtree passed the ACM read check */
+    if (msg->acm_subtree) {
+        msg->acm_skip = TRUE;
+    }
+
     switch (out->btyp) {
     case NCX_BT_EXTERN:
         val_write_extern(scb, out);
@@ -1201,6 +1345,8 @@ static void write_check_val ( ses_cb_t *scb,
         SET_ERROR(ERR_INTERNAL_VAL);
     }
 
+    msg->acm_skip = saveskip;
+
     if (malloced && out) {
         val_free_value(out);
     }
@@ -1757,7 +1903,7 @@ void
 {
     val_value_t       *out;
     status_t           res;
-    boolean            isdefault, malloced;
+    boolean            isdefault, malloced, saveskip;
 
     assert( scb && "scb is NULL" );
     assert( msg && "msg is NULL" );
@@ -1765,6 +1911,8 @@ void
 
     malloced = FALSE;
     res = NO_ERR;
+    saveskip = msg->acm_skip;
+    msg->acm_subtree = FALSE;
     out = val_get_value(scb, msg, val, testfn, TRUE, &malloced, &res);
     if (!out)
         return;
@@ -1797,13 +1945,20 @@ void
         /* write the top-level start node */
         begin_elem_val(scb, msg, out, indent, FALSE);
 
+        /* the descendants are not checked again if the
+         * ACM read check covered the whole subtree
+         */
+        if (msg->acm_subtree) {
+            msg->acm_skip = TRUE;
+        }
+
         /* write the value node contents; skip ACM on this node */
         write_check_val(scb, msg, out, indent+ses_indent_count(scb), testfn,
                         FALSE);
+        msg->acm_skip = saveskip;
 
         /* write the top-level end node */
-        xml_wr_end_elem(scb, msg, out->nsid, out->name, 
-                        fit_on_line(scb, out) ? -1 : indent);
+        end_elem_val(scb, msg, out, fit_on_line(scb, out) ? -1 : indent);
     } else {
         /* write the top-level empty node */
         begin_elem_val(scb, msg, out, indent, TRUE);
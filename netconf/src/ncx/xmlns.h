@@ -98,6 +98,7 @@ typedef struct xmlns_pmap_t_ {
     xmlns_id_t     nm_id;
     xmlChar       *nm_pfix;
     boolean        nm_topattr;
+    struct xmlns_pmap_t_ *nm_hashnext;   /* xml_msg prefix map hash */
 } xmlns_pmap_t;
 
 
@@ -465,6 +465,16 @@ typedef struct xpath_walkerparms_t_ {
 } xpath_walkerparms_t;
 
 
+/* Value node child axis walker fn callback parameters */
+typedef struct xpath_childwalkerparms_t_ {
+    dlq_hdr_t         *resnodeQ;
+    val_value_t       *lastval;     /* last node added */
+    int64              lastpos;     /* position of lastval */
+    int64              callcount;
+    status_t           res;
+} xpath_childwalkerparms_t;
+
+
 /* Value node compare walker fn callback parameters */
 typedef struct xpath_compwalkerparms_t_ {
     xpath_result_t    *result2;
@@ -5542,6 +5542,77 @@ static boolean
 }  /* value_walker_fn */
 
 
+/********************************************************************
+* FUNCTION child_walker_fn
+* 
+* Add the current found child node to the result
+* Used instead of value_walker_fn for the child axis when
+* no context node can select the same child twice
+*
+* The children of one parent are found in order, so the
+* position is counted from the last child that was added
+* instead of the first child of the parent
+*
+* Matches val_walker_fn_t template in val.h
+*
+* INPUTS:
+*    val == value node found in the search
+*    cookie1 == xpath_pcb_t * : parser control block to use
+*    cookie2 == xpath_childwalkerparms_t *: walker parms to use
+*
+* OUTPUTS:
+*    result->nodeQ contents adjusted or replaced
+*
+* RETURNS:
+*    TRUE to keep walk going
+*    FALSE to terminate walk
+*********************************************************************/
+static boolean
+    child_walker_fn (val_value_t *val,
+                     void *cookie1,
+                     void *cookie2)
+{
+    xpath_pcb_t               *pcb;
+    xpath_childwalkerparms_t  *parms;
+    xpath_resnode_t           *newresnode;
+    val_value_t               *child;
+    int64                      position;
+
+    pcb = (xpath_pcb_t *)cookie1;
+    parms = (xpath_childwalkerparms_t *)cookie2;
+
+    if (parms->lastval != NULL &&
+        parms->lastval->parent == val->parent) {
+        position = parms->lastpos;
+        child = parms->lastval;
+    } else {
+        position = 1;
+        child = val_get_first_child(val->parent);
+    }
+    while (child != NULL && child != val) {
+        position++;
+        child = val_get_next_child(child);
+    }
+
+    parms->lastval = val;
+    parms->lastpos = position;
+    ++parms->callcount;
+
+    newresnode = new_val_resnode(pcb, 
+                                 position,
+                                 FALSE,
+                                 val);
+    if (!newresnode) {
+        parms->res = ERR_INTERNAL_MEM;
+        return FALSE;
+    }
+
+    dlq_enque(newresnode, parms->resnodeQ);
+    return TRUE;
+
+}  /* child_walker_fn */
+
+
 /********************************************************************
 * FUNCTION object_walker_fn
 * 
@@ -6151,8 +6222,10 @@ static status_t
     status_t              res;
     boolean               fnresult, fncalled, cfgonly;
     boolean               orself, myorself, useroot;
+    boolean               fastchild;
     dlq_hdr_t             resnodeQ;
     xpath_walkerparms_t   walkerparms;
+    xpath_childwalkerparms_t childparms;
 
     if (!pcb->val && !pcb->obj) {
         return NO_ERR;
@@ -6168,6 +6241,24 @@ static status_t
     orself = (axis == XP_AX_DESCENDANT_OR_SELF) ? TRUE : FALSE;
     useroot = (pcb->flags & XP_FL_USEROOT) ? TRUE : FALSE;
 
+    /* the children of different nodes are different, so the
+     * duplicate check is skipped if no node selects descendants
+     */
+    fastchild = (pcb->val && axis == XP_AX_CHILD) ? TRUE : FALSE;
+    for (resnode = (xpath_resnode_t *)dlq_firstEntry(&result->r.nodeQ);
+         resnode != NULL && fastchild;
+         resnode = (xpath_resnode_t *)dlq_nextEntry(resnode)) {
+        if (resnode->dblslash) {
+            fastchild = FALSE;
+        }
+    }
+
+    childparms.resnodeQ = &resnodeQ;
+    childparms.lastval = NULL;
+    childparms.lastpos = 0;
+    childparms.callcount = 0;
+    childparms.res = NO_ERR;
+
     if (childnsid) {
         modname = xmlns_get_module(childnsid);
     } else {
@@ -6210,6 +6301,19 @@ static status_t
                 if (!fnresult || walkerparms.res != NO_ERR) {
                     res = walkerparms.res;
                 }
+            } else if (fastchild) {
+                fnresult = 
+                    val_find_all_children(child_walker_fn,
+                                          pcb, 
+                                          &childparms,
+                                          testval, 
+                                          modname,
+                                          childname,
+                                          cfgonly,
+                                          textmode);
+                if (!fnresult || childparms.res != NO_ERR) {
+                    res = childparms.res;
+                }
             } else {
                 fnresult = 
                     val_find_all_children(value_walker_fn,
@@ -6305,7 +6409,8 @@ static status_t
         }
     }
 
-    result->last = walkerparms.callcount;
+    result->last = (fastchild) ? childparms.callcount
+        : walkerparms.callcount;
 
     return res;
 
@@ -756,6 +756,17 @@ status_t
             continue;
         }
 
+        if (ncx_get_lazy_groupings()) {
+            /* expand_uses expands the grouping when it is first used */
+#ifdef YANG_GRP_USES_DEBUG
+            if (LOGDEBUG4) {
+                log_debug4("\n   defer expand of group %s",
+                           grp->name);
+            }
+#endif
+            continue;
+        }
+
         /* check any local objects for uses clauses */
         res = yang_obj_resolve_uses(pcb,
                                     tkc, 
@@ -831,13 +842,17 @@ status_t
                                      &grp->groupingQ);
         CHK_EXIT(res, retres);
 
-        /* final check on all objects within groupings */
-        res = yang_obj_resolve_final(pcb,
-                                     tkc, 
-                                     mod, 
-                                     &grp->datadefQ,
-                                     TRUE);
-        CHK_EXIT(res, retres);
+        /* final check on all objects within groupings;
+         * skip a lazy grouping that has not been used yet
+         */
+        if (grp->expand_done || !ncx_get_lazy_groupings()) {
+            res = yang_obj_resolve_final(pcb,
+                                         tkc, 
+                                         mod, 
+                                         &grp->datadefQ,
+                                         TRUE);
+            CHK_EXIT(res, retres);
+        }
 
         yang_check_obj_used(tkc, 
                             mod, 
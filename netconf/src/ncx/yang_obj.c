@@ -81,6 +81,8 @@
     In pass 4, groupings are completed with yang_grp_resolve_complete.
     Then all the uses-based data is cloned and placed into
     the tree, via yang_obj_resolve_uses
+    If ncx_get_lazy_groupings is set, a grouping is completed
+    only when a uses-stmt first needs it, via expand_grouping
 
     In pass 5, all the augment-based data is cloned and placed into
     the tree, via yang_obj_resolve_augments
@@ -7208,6 +7210,53 @@ static status_t resolve_uses_combine_duplicate_refines(
     return res;
 }
 
+/********************************************************************
+* FUNCTION expand_grouping
+* 
+* Expand all the nested uses-stmts within a grouping,
+* if not already done
+*
+* A grouping is expanded in the context of its own module,
+* the same way it would be expanded when that module is loaded
+*
+* Error messages are printed by this function!!
+* Do not duplicate error messages upon error return
+*
+* INPUTS:
+*   pcb == parser control block
+*   tkc == token chain
+*   mod == module in progress
+*   grp == grouping to expand
+*
+* RETURNS:
+*   status of the operation
+*********************************************************************/
+static status_t 
+    expand_grouping (yang_pcb_t *pcb,
+                     tk_chain_t *tkc,
+                     ncx_module_t *mod,
+                     grp_template_t *grp)
+{
+    status_t  res;
+
+    if (grp->expand_done) {
+        return NO_ERR;
+    }
+
+    YANG_OBJ_DEBUG_USES4(
+        "\nexpand_grouping: need expand of grouping %s", grp->name);
+
+    if (grp->tkerr.mod) {
+        mod = grp->tkerr.mod;
+    }
+
+    res = yang_obj_resolve_uses(pcb, tkc, mod, &grp->datadefQ);
+    grp->expand_done = TRUE;
+    return res;
+
+}  /* expand_grouping */
+
+
 /********************************************************************
 * FUNCTION resolve_uses
 * 
@@ -7247,6 +7296,18 @@ static status_t resolve_uses( yang_pcb_t *pcb,
     }
     status_t firsterr = res;
 
+    /* a lazy grouping from another module has not been expanded
+     * yet; the refine targets may be in its nested uses-stmts
+     */
+    if (uses->grp && uses->grp->tkerr.mod != mod &&
+        ncx_get_lazy_groupings()) {
+        res = expand_grouping(pcb, tkc, mod, uses->grp);
+        if ( terminate_parse( res ) ) {
+            return res;
+        }
+        firsterr = ( firsterr == NO_ERR ? res : firsterr );
+    }
+
     /* resolve all the grouping augments, skip the refines */
     res = yang_obj_resolve_datadefs(pcb, tkc, mod, uses->datadefQ);
     if (res != NO_ERR) {
@@ -7362,18 +7423,11 @@ static status_t
 
     status_t res = NO_ERR, retres = NO_ERR;
 
-    if (!uses->grp->expand_done) {
-        /* go through the grouping and make sure all the
-         * nested uses-stmts are expanded first
-         */
-
-        YANG_OBJ_DEBUG_USES4(
-            "\nexpand_uses: need expand of grouping %s", uses->grp->name);
-
-        res = yang_obj_resolve_uses(pcb, tkc, mod, &uses->grp->datadefQ);
-        CHK_EXIT(res, retres);
-        uses->grp->expand_done = TRUE;
-    }
+    /* go through the grouping and make sure all the
+     * nested uses-stmts are expanded first
+     */
+    res = expand_grouping(pcb, tkc, mod, uses->grp);
+    CHK_EXIT(res, retres);
 
     /* go through each node in the grouping
      * make sure it is not already in the same datadefQ
@@ -46,6 +46,7 @@ date         init     comment
 #include <memory.h>
 #include <ctype.h>
 #include <assert.h>
+#include <time.h>
 #include <libxml/xmlstring.h>
 
 #include "procdefs.h"
@@ -92,6 +93,18 @@ static status_t
                            xmlChar **revstring);
 
 
+/********************************************************************
+*                                                                   *
+*                       V A R I A B L E S                           *
+*                                                                   *
+*********************************************************************/
+
+/* time spent in nested import and include parses of the
+ * module currently being parsed, for the per-module timing
+ */
+static uint64 yang_parse_nested_usec;
+
+
 /********************************************************************
 * FUNCTION resolve_mod_appinfo
 * 
@@ -3116,10 +3129,13 @@ static boolean
 *   pcb == YANG parser control block
 *   ptyp == yang parse type
 *   wasadded == pointer to return registry-added flag
+*   resolvestart == pointer to return resolve phase start time
 *
 * OUTPUTS:
 *   *wasadded == TRUE if the module was addeed to the NCX moduleQ
 *             == FALSE if error-exit, not added
+*   *resolvestart == time in usec the module validation started
+*                 == 0 if the module body was not parsed
 *
 * RETURNS:
 *   status of the operation
@@ -3129,7 +3145,8 @@ static status_t
                        ncx_module_t *mod,
                        yang_pcb_t *pcb,
                        yang_parsetype_t ptyp,
-                       boolean *wasadded)
+                       boolean *wasadded,
+                       uint64 *resolvestart)
 {
     yang_node_t    *node;
     ncx_feature_t  *feature;
@@ -3156,6 +3173,7 @@ static status_t
     ismain = TRUE;
     retres = NO_ERR;
     *wasadded = FALSE;
+    *resolvestart = 0;
 
     /* could be module or submodule -- get the first keyword */
     res = TK_ADV(tkc);
@@ -3421,6 +3439,8 @@ while(!done) {
 
     /**************** Module Validation *************************/
 
+    *resolvestart = tstamp_monotonic_usec();
+
     if (pcb->deviationmode) {
         /* Check any deviations, record the module name
          * and save the deviation in the global
@@ -3958,6 +3978,10 @@ status_t
     status_t        res = NO_ERR ;
     boolean         wasadd = FALSE;
     boolean         keepmod = FALSE;
+    boolean         cached = FALSE;
+    uint64          tkstart, parsestart, resolvestart, endtime;
+    uint64          savenested, parseusec, textbytes;
+    uint32          textcount;
 
 #ifdef DEBUG
     if (!filespec || !pcb) {
@@ -3977,6 +4001,8 @@ status_t
         return res;
     }
 
+    tkstart = tstamp_monotonic_usec();
+
     res = (isyang) ? load_yang_module( filespec, str, &tkc )
                    : load_yin_module( filespec, str, &tkc );
 
@@ -4005,10 +4031,20 @@ status_t
     }
 
     if (isyang) {
-        /* serialize the file into language tokens
+        /* use the saved token chain if the source file contents
+         * have not changed since it was cached, otherwise serialize the
+         * file into language tokens and cache the result
          * !!! need to change this later because it may use too
          * !!! much memory in embedded parsers */
-        res = tk_tokenize_input(tkc, mod);
+        res = ncxmod_load_token_cache(str, tkc, mod);
+        if (res == NO_ERR) {
+            cached = TRUE;
+        } else {
+            res = tk_tokenize_input(tkc, mod);
+            if (res == NO_ERR) {
+                ncxmod_save_token_cache(str, tkc);
+            }
+        }
         if ( NO_ERR != res ) {
             ncx_free_module(mod);
 
@@ -4039,7 +4075,42 @@ status_t
         }
     }
 
-    res = parse_yang_module( tkc, mod, pcb, ptyp, &wasadd );
+    /* the nested import and include parses add their own time
+     * to yang_parse_nested_usec, so it is not counted twice */
+    savenested = yang_parse_nested_usec;
+    yang_parse_nested_usec = 0;
+    parsestart = tstamp_monotonic_usec();
+
+    res = parse_yang_module( tkc, mod, pcb, ptyp, &wasadd, &resolvestart );
+
+    endtime = tstamp_monotonic_usec();
+    if (LOGDEBUG) {
+        if (resolvestart == 0) {
+            resolvestart = endtime;
+        }
+        /* imports and includes are parsed before the resolve phase */
+        parseusec = resolvestart - parsestart;
+        parseusec -= (parseusec > yang_parse_nested_usec) ?
+            yang_parse_nested_usec : parseusec;
+        log_debug("\nyang_parse: '%s' tokenize %llu usec%s, "
+                  "parse %llu usec, resolve %llu usec",
+                  (mod->name) ? mod->name : str,
+                  (unsigned long long)(parsestart - tkstart),
+                  (cached) ? " (cached)" : "",
+                  (unsigned long long)parseusec,
+                  (unsigned long long)(endtime - resolvestart));
+        if (ptyp == YANG_PT_TOP) {
+            /* totals for all modules loaded so far */
+            obj_get_textclone_stats(&textcount, &textbytes);
+            if (textcount) {
+                log_debug("\nyang_parse: %u cloned objects share grouping "
+                          "text, %llu bytes not copied",
+                          textcount,
+                          (unsigned long long)textbytes);
+            }
+        }
+    }
+    yang_parse_nested_usec = savenested + (endtime - tkstart);
 
     if (pcb->top == mod) {
         pcb->topadded = wasadd;
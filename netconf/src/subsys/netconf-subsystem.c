@@ -22,12 +22,14 @@ date         init     comment
 14-jan-07    abb      begun;
 03-mar-11    abb      get rid of usleeps and replace with
                       design that checks for EAGAIN
+19-oct-26             relay with splice() through pipes
 
 *********************************************************************
 *                                                                   *
 *                     I N C L U D E    F I L E S                    *
 *                                                                   *
 *********************************************************************/
+#define _GNU_SOURCE
 #include <sys/types.h>
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -47,6 +49,7 @@ date         init     comment
 #include <string.h>
 #include <pwd.h>
 #include <stdarg.h>
+#include <poll.h>
 
 #define _C_main 1
 
@@ -86,6 +89,39 @@ date         init     comment
 
 #define MAX_READ_TRIES 1000
 
+/* max bytes moved by 1 read or splice call of the relay */
+#define RELAY_BUFFLEN  65536
+
+/* default send and receive buffer size of the ncxserver socket;
+ * changed with --socket-buffer-size; 0 keeps the system default
+ */
+#define SOCK_BUFFSIZE  (256 * 1024)
+
+/* splice() is only used if the system has it */
+#ifdef SPLICE_F_MOVE
+#define USE_SPLICE 1
+#endif
+
+
+/********************************************************************
+*                                                                   *
+*                             T Y P E S                             *
+*                                                                   *
+*********************************************************************/
+
+/* 1 direction of the relay between sshd and the ncxserver
+ * The bytes are moved with splice() through a pipe, so they
+ * are not copied to user space; if the pipe is not set up
+ * they are moved with read() and write()
+ */
+typedef struct relay_t_ {
+    const char *name;
+    int         infd;
+    int         outfd;
+    int         pipefd[2];         /* [0] read end, -1 if not used */
+    size_t      pipecnt;           /* bytes waiting in the pipe */
+} relay_t;
+
 /********************************************************************
 *                                                                   *
 *                       V A R I A B L E S                           *
@@ -98,6 +134,7 @@ static struct sockaddr_un ncxname_unix;
 static struct sockaddr_in ncxname_inet;
 static int    ncxport_inet;
 static int    ncxsock;
+static int    sockbuffsize;
 static char *user;
 static char *port;
 
@@ -124,6 +161,7 @@ static FILE *errfile;
 
 static boolean ncxconnect;
 static char msgbuff[BUFFLEN];
+static char relaybuff[RELAY_BUFFLEN];
 
 /******************************************************************
  * FUNCTION configure_logging
@@ -199,11 +237,15 @@ static status_t
     ncxsock = -1;
     ncxconnect = FALSE;
     ncxport_inet = -1;
+    sockbuffsize = SOCK_BUFFSIZE;
 
     for(i=1;i<argc;i++) {
     	if(strlen(argv[i])>strlen("--tcp-direct-port=") && 0==memcmp(argv[i],"--tcp-direct-port=",strlen("--tcp-direct-port="))) {
             ncxport_inet = atoi(argv[i]+strlen("--tcp-direct-port=")); 
         }
+        if(strlen(argv[i])>strlen("--socket-buffer-size=") && 0==memcmp(argv[i],"--socket-buffer-size=",strlen("--socket-buffer-size="))) {
+            sockbuffsize = atoi(argv[i]+strlen("--socket-buffer-size="));
+        }
     }    
 
     /* get the client address */
@@ -293,6 +335,20 @@ static status_t
         ncxname = (struct sockaddr *)&ncxname_unix;
     }
 
+    /* bigger socket buffers let 1 relay call move more bytes;
+     * the system may limit the size, so errors are not fatal
+     */
+    if (sockbuffsize > 0) {
+        if (setsockopt(ncxsock, SOL_SOCKET, SO_SNDBUF,
+                       &sockbuffsize, sizeof(sockbuffsize)) < 0 ||
+            setsockopt(ncxsock, SOL_SOCKET, SO_RCVBUF,
+                       &sockbuffsize, sizeof(sockbuffsize)) < 0) {
+            SUBSYS_TRACE1( "WARNING: init_subsys(): set socket buffer "
+                           "size failed with error: %s\n", 
+                           strerror( errno ) );
+        }
+    }
+
     /* try to connect to the NCX server */
     ret = connect(ncxsock,
                   ncxname,
@@ -419,6 +475,209 @@ static ssize_t
 }  /* do_read */
 
 
+/********************************************************************
+* FUNCTION init_relay
+*
+* Setup 1 direction of the relay
+* The splice pipe is created if splice() is available
+* 
+* INPUTS:
+*   relay == relay to setup
+*   name == name of the direction for the trace messages
+*   infd == FD to read from
+*   outfd == FD to write to
+*********************************************************************/
+static void
+    init_relay (relay_t *relay,
+                const char *name,
+                int infd,
+                int outfd)
+{
+    relay->name = name;
+    relay->infd = infd;
+    relay->outfd = outfd;
+    relay->pipefd[0] = -1;
+    relay->pipefd[1] = -1;
+    relay->pipecnt = 0;
+
+#ifdef USE_SPLICE
+    if (pipe(relay->pipefd) != 0) {
+        SUBSYS_TRACE1( "WARNING: init_relay(): %s pipe() failed "
+                       "with error: %s\n", name, strerror( errno ) );
+        relay->pipefd[0] = -1;
+        relay->pipefd[1] = -1;
+        return;
+    }
+
+#ifdef F_SETPIPE_SZ
+    /* let the pipe hold 1 full read */
+    (void)fcntl(relay->pipefd[1], F_SETPIPE_SZ, RELAY_BUFFLEN);
+#endif
+#endif
+
+} /* init_relay */
+
+
+/********************************************************************
+* FUNCTION stop_splice
+*
+* Close the splice pipe of a relay; the relay uses
+* read() and write() after this
+* 
+* INPUTS:
+*   relay == relay to change
+*********************************************************************/
+static void
+    stop_splice (relay_t *relay)
+{
+    if (relay->pipefd[0] != -1) {
+        close(relay->pipefd[0]);
+        close(relay->pipefd[1]);
+        relay->pipefd[0] = -1;
+        relay->pipefd[1] = -1;
+    }
+    relay->pipecnt = 0;
+
+} /* stop_splice */
+
+
+#ifdef USE_SPLICE
+/********************************************************************
+* FUNCTION drain_pipe
+*
+* Move all the bytes in the splice pipe of a relay to its output FD
+* If the output FD cannot be spliced to, the bytes are read
+* from the pipe and written, and the splice pipe is closed
+* 
+* INPUTS:
+*   relay == relay with relay->pipecnt bytes in its pipe
+*
+* RETURNS:
+*   status
+*********************************************************************/
+static status_t
+    drain_pipe (relay_t *relay)
+{
+    struct pollfd  pfd;
+    ssize_t        retcnt;
+    status_t       res;
+    int            ret;
+
+    res = NO_ERR;
+    while (relay->pipecnt > 0 && res == NO_ERR) {
+        retcnt = splice(relay->pipefd[0], NULL, relay->outfd, NULL,
+                        relay->pipecnt, SPLICE_F_MOVE);
+        if (retcnt > 0) {
+            relay->pipecnt -= (size_t)retcnt;
+            continue;
+        }
+
+        switch (errno) {
+        case EINTR:
+            break;
+        case EAGAIN:
+            /* wait for the peer to read; this process only
+             * relays one session, so no other session waits */
+            pfd.fd = relay->outfd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            ret = poll(&pfd, 1, -1);
+            if (ret < 0 && errno != EINTR) {
+                res = errno_to_status();
+            }
+            break;
+        case EINVAL:
+            /* output FD does not support splice */
+            retcnt = do_read(relay->pipefd[0], relaybuff,
+                             relay->pipecnt, &res);
+            if (res == NO_ERR) {
+                relay->pipecnt -= (size_t)retcnt;
+                res = send_buff(relay->outfd, relaybuff, (size_t)retcnt);
+            }
+            if (res == NO_ERR && relay->pipecnt == 0) {
+                SUBSYS_TRACE2( "INFO: drain_pipe(): %s output "
+                               "not spliced\n", relay->name );
+                stop_splice(relay);
+            }
+            break;
+        default:
+            SUBSYS_TRACE1( "ERROR: drain_pipe(): %s splice() "
+                           "failed with error: %s\n", 
+                           relay->name, strerror( errno ) );
+            res = errno_to_status();
+        }
+    }
+
+    return res;
+
+} /* drain_pipe */
+#endif
+
+
+/********************************************************************
+* FUNCTION relay_data
+*
+* Move the bytes available on the input FD of a relay
+* to its output FD
+* 
+* INPUTS:
+*   relay == relay with input ready
+*
+* RETURNS:
+*   status; ERR_NCX_EOF if the input FD was closed
+*********************************************************************/
+static status_t
+    relay_data (relay_t *relay)
+{
+    status_t  res;
+    ssize_t   retcnt;
+
+#ifdef USE_SPLICE
+    if (relay->pipefd[0] != -1) {
+        retcnt = splice(relay->infd, NULL, relay->pipefd[1], NULL,
+                        RELAY_BUFFLEN, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (retcnt > 0) {
+            relay->pipecnt = (size_t)retcnt;
+            res = drain_pipe(relay);
+            if (res != NO_ERR) {
+                SUBSYS_TRACE1( "ERROR: relay_data(): %s splice "
+                               "failed with %s\n", 
+                               relay->name, get_error_string(res) );
+            }
+            return res;
+        } else if (retcnt == 0) {
+            SUBSYS_TRACE1( "INFO: relay_data(): closed connection\n");
+            return ERR_NCX_EOF;
+        } else if (errno == EINTR || errno == EAGAIN) {
+            return NO_ERR;
+        } else if (errno != EINVAL) {
+            SUBSYS_TRACE1( "ERROR: relay_data(): %s splice() "
+                           "failed with error: %s\n", 
+                           relay->name, strerror( errno ) );
+            return ERR_NCX_READ_FAILED;
+        }
+
+        /* input FD does not support splice */
+        SUBSYS_TRACE2( "INFO: relay_data(): %s input not spliced\n", 
+                       relay->name );
+        stop_splice(relay);
+    }
+#endif
+
+    retcnt = do_read(relay->infd, relaybuff, RELAY_BUFFLEN, &res);
+    if (res == NO_ERR && retcnt > 0) {
+        res = send_buff(relay->outfd, relaybuff, (size_t)retcnt);
+        if (res != NO_ERR) {
+            SUBSYS_TRACE1( "ERROR: relay_data(): %s send_buff() "
+                           "failed with %s\n", 
+                           relay->name, strerror( errno ) );
+        }
+    }
+    return res;
+
+} /* relay_data */
+
+
 /********************************************************************
 * FUNCTION io_loop
 *
@@ -432,95 +691,70 @@ static ssize_t
 static status_t
     io_loop (void)
 {
-    status_t  res;
-    boolean   done;
-    fd_set    fds;
-    int       ret;
-    ssize_t   retcnt;
+    status_t       res;
+    boolean        done;
+    struct pollfd  pfds[2];
+    relay_t        relays[2];
+    int            ret, i;
 
     res = NO_ERR;
     done = FALSE;
-    FD_ZERO(&fds);
+
+    /* [0] client to ncxserver, [1] ncxserver to client */
+    init_relay(&relays[0], "client", STDIN_FILENO, ncxsock);
+    init_relay(&relays[1], "ncxserver", ncxsock, STDOUT_FILENO);
 
     while (!done) {
-        FD_SET(STDIN_FILENO, &fds);
-        FD_SET(ncxsock, &fds);
+        for (i = 0; i < 2; i++) {
+            pfds[i].fd = relays[i].infd;
+            pfds[i].events = POLLIN;
+            pfds[i].revents = 0;
+        }
 
-        ret = select(FD_SETSIZE, &fds, NULL, NULL, NULL);
+        ret = poll(pfds, 2, -1);
         if (ret < 0) {
             if ( errno != EINTR ) {
-                SUBSYS_TRACE1( "ERROR: io_loop(): select() "
+                SUBSYS_TRACE1( "ERROR: io_loop(): poll() "
                                "failed with error: %s\n", strerror( errno ) );
                 res = ERR_NCX_OPERATION_FAILED;
                 done = TRUE;
             }
             else
             {
-                SUBSYS_TRACE2( "INFO: io_loop(): select() "
+                SUBSYS_TRACE2( "INFO: io_loop(): poll() "
                                "failed with error: %s\n", strerror( errno  ) );
             }
             continue;
         } else if (ret == 0) {
-            SUBSYS_TRACE1( "ERROR: io_loop(): select() "
+            SUBSYS_TRACE1( "ERROR: io_loop(): poll() "
                            "returned 0, exiting...\n" );
             res = NO_ERR;
             done = TRUE;
             continue;
         } /* else some IO to process */
 
-        /* check any input from client */
-        if (FD_ISSET(STDIN_FILENO, &fds)) {
-            /* get buff from openssh */
-            retcnt = do_read(STDIN_FILENO, 
-                             msgbuff, 
-                             (size_t)BUFFLEN,
-                             &res);
-
-            if (res == ERR_NCX_EOF) {
-                res = NO_ERR;
-                done = TRUE;
-                continue;
-            } else if (res == ERR_NCX_SKIPPED) {
-                res = NO_ERR;
-            } else if (res == NO_ERR && retcnt > 0) {
-                /* send this buffer to the ncxserver */
-                res = send_buff(ncxsock, msgbuff, (size_t)retcnt);
-                if (res != NO_ERR) {
-                    SUBSYS_TRACE1( "ERROR: io_loop(): send_buff() to ncxserver "
-                                   "failed with %s\n", strerror( errno ) );
+        /* check any input from the client, then the ncxserver;
+         * a closed FD is reported as EOF by the read
+         */
+        for (i = 0; i < 2 && !done; i++) {
+            if (pfds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                res = relay_data(&relays[i]);
+                if (res == ERR_NCX_EOF) {
+                    res = NO_ERR;
                     done = TRUE;
-                    continue;
-                }
-            }
-        }  /* if STDIN set */
-
-        /* check any input from the ncxserver */
-        if (FD_ISSET(ncxsock, &fds)) {
-            res = NO_ERR;
-            retcnt = do_read(ncxsock, 
-                             msgbuff, 
-                             (size_t)BUFFLEN,
-                             &res);
-
-            if (res == ERR_NCX_EOF) {
-                res = NO_ERR;
-                done = TRUE;
-                continue;
-            } else if (res == ERR_NCX_SKIPPED) {
-                res = NO_ERR;
-            } else if (res == NO_ERR && retcnt > 0) {
-                /* send this buffer to STDOUT */
-                res = send_buff(STDOUT_FILENO, msgbuff, (size_t)retcnt);
-                if (res != NO_ERR) {
-                    SUBSYS_TRACE1( "ERROR: io_loop(): send_buff() to client "
-                                   "failed with %s\n", strerror( errno ) );
+                } else if (res == ERR_NCX_SKIPPED) {
+                    res = NO_ERR;
+                } else if (res != NO_ERR) {
                     done = TRUE;
-                    continue;
                 }
             }
         }
     }
 
+    for (i = 0; i < 2; i++) {
+        stop_splice(&relays[i]);
+    }
+
     return res;
 
 } /* io_loop */
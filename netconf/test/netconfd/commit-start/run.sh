@@ -0,0 +1,12 @@
+#!/bin/bash -e
+rm -rf tmp || true
+mkdir tmp
+killall -KILL netconfd || true
+rm /tmp/ncxserver.sock || true
+/usr/sbin/netconfd --modpath=.:/usr/share/yuma/modules --module=test-commit-start --pipeline-edits=true --commit-deadline=3000 --no-startup --superuser=$USER 2>&1 1>tmp/server.log &
+SERVER_PID=$!
+sleep 3
+python session.litenc.py --server=$NCSERVER --port=$NCPORT --user=$NCUSER --password=$NCPASSWORD
+kill -KILL $SERVER_PID
+cat tmp/server.log
+sleep 1
@@ -0,0 +1,186 @@
+#!/usr/bin/env python
+
+import time
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+NS="http://yuma123.org/ns/test/netconfd/commit-start/test-commit-start"
+BACKEND_DELAY=1
+COMMIT_DEADLINE=3
+
+def edit_config_rpc(a, b):
+	return """
+<edit-config>
+    <target>
+      <candidate/>
+    </target>
+    <config>
+      <a xmlns="%(ns)s"><value>%(a)d</value></a>
+      <b xmlns="%(ns)s"><value>%(b)d</value></b>
+    </config>
+</edit-config>
+""" % {'ns':NS, 'a':a, 'b':b}
+
+def edit_config(conn, a, b):
+	result = conn.rpc(edit_config_rpc(a, b))
+	assert(len(result.xpath('ok'))==1)
+
+def commit(conn):
+	start = time.time()
+	result = conn.rpc("<commit/>")
+	duration = time.time() - start
+	print lxml.etree.tostring(result)
+	print "commit took %(duration).2f sec" % {'duration':duration}
+	return (result, duration)
+
+def get_max_running(conn):
+	result = conn.rpc("""
+<get>
+  <filter type="subtree">
+    <commit-stats xmlns="%(ns)s"/>
+  </filter>
+</get>
+""" % {'ns':NS})
+	max_running = int(result.xpath('data/commit-stats/max-running')[0].text)
+	print "max-running=%(max_running)d" % {'max_running':max_running}
+	return max_running
+
+def get_values(conn):
+	result = conn.rpc("""
+<get-config>
+  <source>
+    <running/>
+  </source>
+  <filter type="subtree">
+    <a xmlns="%(ns)s"/>
+    <b xmlns="%(ns)s"/>
+  </filter>
+</get-config>
+""" % {'ns':NS})
+	return (int(result.xpath('data/a/value')[0].text),
+		int(result.xpath('data/b/value')[0].text))
+
+def step_1(conn):
+	print("#1 - Commit /a and /b; both backends run at the same time.")
+	edit_config(conn, 1, 1)
+	(result, duration) = commit(conn)
+	assert(len(result.xpath('ok'))==1)
+	assert(duration < 1.8*BACKEND_DELAY)
+	assert(get_max_running(conn)==2)
+
+def step_2(conn):
+	print("#2 - Failed backend commit of /b rolls back /a.")
+	edit_config(conn, 2, 13)
+	(result, duration) = commit(conn)
+	assert(len(result.xpath('rpc-error'))==1)
+	assert(get_values(conn)==(1, 1))
+
+def step_3(conn):
+	print("#3 - Discard the rejected changes.")
+	result = conn.rpc("<discard-changes/>")
+	assert(len(result.xpath('ok'))==1)
+
+def step_4(conn):
+	print("#4 - Pipelined edit-config and commit requests are answered in order.")
+	requests = [edit_config_rpc(3, 3), "<commit/>", edit_config_rpc(4, 4), "<commit/>"]
+	for (i, request) in enumerate(requests):
+		ret = conn.send("""<rpc xmlns="urn:ietf:params:xml:ns:netconf:base:1.0" message-id="%(id)d">%(request)s</rpc>""" % {'id':40+i, 'request':request})
+		assert(ret==0)
+	for i in range(len(requests)):
+		result = conn.receive()
+		print lxml.etree.tostring(result)
+		assert(result.get('message-id')==str(40+i))
+		assert(len(result.xpath('ok'))==1)
+	assert(get_values(conn)==(4, 4))
+
+def step_5(conn):
+	print("#5 - Backend commit of /b that never answers is cancelled after the commit-deadline and /a is rolled back.")
+	edit_config(conn, 5, 99)
+	(result, duration) = commit(conn)
+	assert(len(result.xpath('rpc-error'))==1)
+	assert(result.xpath('rpc-error/error-tag')[0].text=="operation-failed")
+	assert(duration >= COMMIT_DEADLINE)
+	assert(duration < COMMIT_DEADLINE+2*BACKEND_DELAY+1)
+	assert(get_values(conn)==(4, 4))
+	result = conn.rpc("<discard-changes/>")
+	assert(len(result.xpath('ok'))==1)
+
+def main():
+	print("""
+#Description: Test parallel commit of independent SIL backends
+#Procedure:
+#1 - Commit /a and /b; both backends run at the same time.
+#2 - Failed backend commit of /b rolls back /a.
+#3 - Discard the rejected changes.
+#4 - Pipelined edit-config and commit requests are answered in order.
+#5 - Backend commit of /b that never answers is cancelled after the commit-deadline and /a is rolled back.
+""")
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	step_1(conn)
+	step_2(conn)
+	step_3(conn)
+	step_4(conn)
+	step_5(conn)
+	return 0
+
+sys.exit(main())
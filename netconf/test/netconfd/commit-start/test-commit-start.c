@@ -0,0 +1,277 @@
+/*
+    module test-commit-start
+    The /a and /b containers are committed by backend processes
+    that answer after a delay. The commits are started with
+    agt_cb_register_parallel_callback so both backends work
+    at the same time. A backend that never answers is cancelled
+    by the ROLLBACK callback after the commit-deadline.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <assert.h>
+
+#include "procdefs.h"
+#include "agt.h"
+#include "agt_cb.h"
+#include "agt_util.h"
+#include "cfg.h"
+#include "getcb.h"
+#include "ncxmod.h"
+#include "ncxtypes.h"
+#include "rpc.h"
+#include "ses.h"
+#include "status.h"
+#include "val.h"
+#include "xml_util.h"
+
+#define BACKEND_MAX 2
+#define BACKEND_DELAY 1   /* seconds */
+#define BACKEND_FAIL_VALUE 13
+#define BACKEND_HANG_VALUE 99
+
+typedef struct backend_t_ {
+    const char *name;
+    pid_t pid;
+    int fd;
+} backend_t;
+
+/* module static variables */
+static ncx_module_t *test_commit_start_mod;
+static backend_t backends[BACKEND_MAX] = {
+    { "a", -1, -1 },
+    { "b", -1, -1 }
+};
+static unsigned int running;
+static unsigned int max_running;
+
+static backend_t *
+    find_backend(const val_value_t *val)
+{
+    unsigned int i;
+
+    /* the edited node is the container or its value leaf */
+    if (!xml_strcmp(val->name, (const xmlChar *)"value")) {
+        val = val->parent;
+    }
+    for (i = 0; i < BACKEND_MAX; i++) {
+        if (!xml_strcmp(val->name, (const xmlChar *)backends[i].name)) {
+            return &backends[i];
+        }
+    }
+    assert(0);
+    return NULL;
+}
+
+static int32
+    get_value(const val_value_t *val)
+{
+    val_value_t *value_val;
+
+    if (val == NULL) {
+        return 0;
+    }
+    if (!xml_strcmp(val->name, (const xmlChar *)"value")) {
+        return VAL_INT(val);
+    }
+    value_val = val_find_child(val, "test-commit-start", "value");
+    return (value_val != NULL) ? VAL_INT(value_val) : 0;
+}
+
+/* Registered callback functions: start_commit, edit_commit, get_max_running */
+
+static status_t
+    start_commit(ses_cb_t *scb,
+                 rpc_msg_t *msg,
+                 op_editop_t editop,
+                 val_value_t *newval,
+                 val_value_t *curval,
+                 int *fd)
+{
+    backend_t *backend;
+    int fds[2];
+    const char *reply;
+
+    backend = find_backend(newval ? newval : curval);
+    assert(backend->pid == -1);
+
+    if (pipe(fds) != 0) {
+        return ERR_NCX_OPERATION_FAILED;
+    }
+    reply = (get_value(newval) == BACKEND_FAIL_VALUE) ? "fail" : "ok";
+    backend->pid = fork();
+    if (backend->pid == 0) {
+        close(fds[0]);
+        if (get_value(newval) == BACKEND_HANG_VALUE) {
+            pause();
+        }
+        sleep(BACKEND_DELAY);
+        if (write(fds[1], reply, strlen(reply)) < 0) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(fds[1]);
+    backend->fd = fds[0];
+    *fd = backend->fd;
+
+    running++;
+    if (running > max_running) {
+        max_running = running;
+    }
+    printf("start_commit: %s\n", backend->name);
+    return NO_ERR;
+}
+
+static status_t
+    edit_commit(ses_cb_t *scb,
+                rpc_msg_t *msg,
+                agt_cbtyp_t cbtyp,
+                op_editop_t editop,
+                val_value_t *newval,
+                val_value_t *curval)
+{
+    backend_t *backend;
+    char buf[16];
+    ssize_t len;
+    int fd;
+    status_t res;
+
+    backend = find_backend(newval ? newval : curval);
+
+    /* cancel a commit that missed the commit-deadline */
+    if (cbtyp == AGT_CB_ROLLBACK && backend->pid != -1) {
+        kill(backend->pid, SIGKILL);
+        close(backend->fd);
+        backend->fd = -1;
+        waitpid(backend->pid, NULL, 0);
+        backend->pid = -1;
+        running--;
+        printf("edit_commit: %s cancelled\n", backend->name);
+        return NO_ERR;
+    }
+
+    if (cbtyp != AGT_CB_COMMIT) {
+        return NO_ERR;
+    }
+
+    /* not started in parallel; commit now */
+    if (backend->pid == -1) {
+        res = start_commit(scb, msg, editop, newval, curval, &fd);
+        if (res != NO_ERR) {
+            return res;
+        }
+    }
+
+    len = read(backend->fd, buf, sizeof(buf) - 1);
+    close(backend->fd);
+    backend->fd = -1;
+    waitpid(backend->pid, NULL, 0);
+    backend->pid = -1;
+    running--;
+    if (len <= 0) {
+        return ERR_NCX_OPERATION_FAILED;
+    }
+    buf[len] = 0;
+    printf("edit_commit: %s %s\n", backend->name, buf);
+
+    if (strcmp(buf, "ok")) {
+        agt_record_error(scb, &msg->mhdr, NCX_LAYER_CONTENT,
+                         ERR_NCX_OPERATION_FAILED, NULL,
+                         NCX_NT_NONE, NULL, NCX_NT_VAL,
+                         newval ? newval : curval);
+        return ERR_NCX_OPERATION_FAILED;
+    }
+    return NO_ERR;
+}
+
+static status_t
+    get_max_running(ses_cb_t *scb,
+                    getcb_mode_t cbmode,
+                    const val_value_t *vir_val,
+                    val_value_t *dst_val)
+{
+    char buf[32];
+
+    snprintf(buf, sizeof(buf), "%u", max_running);
+    return val_set_simval_obj(dst_val, dst_val->obj, buf);
+}
+
+/* The 3 mandatory callback functions: y_test_commit_start_init, y_test_commit_start_init2, y_test_commit_start_cleanup */
+
+status_t
+    y_test_commit_start_init (
+        const xmlChar *modname,
+        const xmlChar *revision)
+{
+    agt_profile_t *agt_profile;
+    status_t res;
+
+    agt_profile = agt_get_profile();
+
+    res = ncxmod_load_module(
+        "test-commit-start",
+        NULL,
+        &agt_profile->agt_savedevQ,
+        &test_commit_start_mod);
+    if (res != NO_ERR) {
+        return res;
+    }
+
+    res = agt_cb_register_parallel_callback(
+        "test-commit-start",
+        (const xmlChar *)"/a",
+        NULL /*"YYYY-MM-DD"*/,
+        edit_commit,
+        start_commit);
+    if (res != NO_ERR) {
+        return res;
+    }
+
+    res = agt_cb_register_parallel_callback(
+        "test-commit-start",
+        (const xmlChar *)"/b",
+        NULL /*"YYYY-MM-DD"*/,
+        edit_commit,
+        start_commit);
+    return res;
+}
+
+status_t y_test_commit_start_init2(void)
+{
+    status_t res;
+    obj_template_t *stats_obj;
+    val_value_t *stats_val;
+    val_value_t *leaf_val;
+
+    stats_obj = ncx_find_object(test_commit_start_mod, "commit-stats");
+    assert(stats_obj != NULL);
+
+    res = agt_add_top_container(stats_obj, &stats_val);
+    assert(res == NO_ERR);
+
+    leaf_val = agt_make_virtual_leaf(stats_obj, "max-running",
+                                     get_max_running, &res);
+    assert(leaf_val != NULL);
+    val_add_child(leaf_val, stats_val);
+    val_set_virtual_cache_time(leaf_val->obj, 0);
+
+    return NO_ERR;
+}
+
+void y_test_commit_start_cleanup (void)
+{
+    agt_cb_unregister_callback(
+        "test-commit-start",
+        (const xmlChar *)"/a",
+        edit_commit);
+    agt_cb_unregister_callback(
+        "test-commit-start",
+        (const xmlChar *)"/b",
+        edit_commit);
+}
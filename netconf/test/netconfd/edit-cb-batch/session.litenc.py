@@ -0,0 +1,191 @@
+#!/usr/bin/env python
+
+import time
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+ACL_COUNT=1000
+
+def acl(index, action, operation=""):
+	if operation != "":
+		operation = """ xmlns:nc="urn:ietf:params:xml:ns:netconf:base:1.0" nc:operation="%s\"""" % operation
+	return """
+        <acl%(operation)s>
+          <name>acl%(index)d</name>
+          <action>%(action)s</action>
+        </acl>
+""" % {'index':index, 'action':action, 'operation':operation}
+
+def edit_config(conn, acls):
+	edit_config_rpc = """
+<edit-config>
+    <target>
+      <candidate/>
+    </target>
+    <config>
+      <acls xmlns="http://yuma123.org/ns/test/netconfd/edit-cb-batch/test-edit-cb-batch">
+%(acls)s
+      </acls>
+    </config>
+</edit-config>
+""" % {'acls':acls}
+	result = conn.rpc(edit_config_rpc)
+	assert(len(result.xpath('ok'))==1)
+
+def commit(conn):
+	result = conn.rpc("<commit/>")
+	print lxml.etree.tostring(result)
+	return result
+
+def get_stats(conn):
+	result = conn.rpc("""
+<get>
+  <filter type="subtree">
+    <batch-stats xmlns="http://yuma123.org/ns/test/netconfd/edit-cb-batch/test-edit-cb-batch"/>
+  </filter>
+</get>
+""")
+	stats = {}
+	for leaf in result.xpath('data/batch-stats/*'):
+		stats[leaf.tag] = int(leaf.text)
+	print stats
+	return stats
+
+def get_acl_count(conn):
+	result = conn.rpc("""
+<get-config>
+  <source>
+    <running/>
+  </source>
+  <filter type="subtree">
+    <acls xmlns="http://yuma123.org/ns/test/netconfd/edit-cb-batch/test-edit-cb-batch"/>
+  </filter>
+</get-config>
+""")
+	return len(result.xpath('data/acls/acl'))
+
+def step_1(conn):
+	print("#1 - Create the acls container with 1 entry.")
+	edit_config(conn, acl(ACL_COUNT, "permit"))
+	result = commit(conn)
+	assert(len(result.xpath('ok'))==1)
+
+def step_2(conn):
+	print("#2 - Create %(count)d entries; 1 APPLY and 1 COMMIT call." % {'count':ACL_COUNT})
+	acls=""
+	for i in range(0, ACL_COUNT):
+		acls=acls+acl(i, "permit")
+	edit_config(conn, acls)
+	result = commit(conn)
+	assert(len(result.xpath('ok'))==1)
+	stats = get_stats(conn)
+	assert(stats['apply-calls']==1 and stats['apply-edits']==ACL_COUNT)
+	assert(stats['commit-calls']==1 and stats['commit-edits']==ACL_COUNT)
+	assert(stats['committed']==ACL_COUNT)
+
+def step_3(conn):
+	print("#3 - Rejected COMMIT batch leaves running unchanged.")
+	acls=""
+	for i in range(ACL_COUNT+1, ACL_COUNT+11):
+		acls=acls+acl(i, "reject" if i==ACL_COUNT+5 else "deny")
+	edit_config(conn, acls)
+	result = commit(conn)
+	assert(len(result.xpath('rpc-error'))==1)
+	stats = get_stats(conn)
+	assert(stats['commit-calls']==2 and stats['commit-edits']==10)
+	assert(stats['committed']==ACL_COUNT)
+	assert(get_acl_count(conn)==ACL_COUNT+1)
+	result = conn.rpc("<discard-changes/>")
+	assert(len(result.xpath('ok'))==1)
+
+def step_4(conn):
+	print("#4 - Delete %(count)d entries; 1 APPLY and 1 COMMIT call." % {'count':ACL_COUNT})
+	acls=""
+	for i in range(0, ACL_COUNT):
+		acls=acls+acl(i, "permit", "delete")
+	edit_config(conn, acls)
+	result = commit(conn)
+	assert(len(result.xpath('ok'))==1)
+	stats = get_stats(conn)
+	assert(stats['apply-calls']==3 and stats['apply-edits']==ACL_COUNT)
+	assert(stats['commit-calls']==3 and stats['commit-edits']==ACL_COUNT)
+	assert(stats['committed']==0)
+	assert(get_acl_count(conn)==1)
+
+def main():
+	print("""
+#Description: Test batched edit callbacks for the entries of a list
+#Procedure:
+#1 - Create the acls container with 1 entry.
+#2 - Create 1000 entries; 1 APPLY and 1 COMMIT call.
+#3 - Rejected COMMIT batch leaves running unchanged.
+#4 - Delete 1000 entries; 1 APPLY and 1 COMMIT call.
+""")
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	step_1(conn)
+	step_2(conn)
+	step_3(conn)
+	step_4(conn)
+	return 0
+
+sys.exit(main())
@@ -0,0 +1,198 @@
+/*
+    module test-edit-cb-batch
+    The /acls/acl list has a batch edit callback. Each phase
+    gets all the changed entries of a transaction in one call.
+    The calls are counted in the /batch-stats leafs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "procdefs.h"
+#include "agt.h"
+#include "agt_cb.h"
+#include "agt_util.h"
+#include "cfg.h"
+#include "dlq.h"
+#include "getcb.h"
+#include "ncxmod.h"
+#include "ncxtypes.h"
+#include "rpc.h"
+#include "ses.h"
+#include "status.h"
+#include "val.h"
+#include "xml_util.h"
+
+/* module static variables */
+static ncx_module_t *test_edit_cb_batch_mod;
+static unsigned int calls[AGT_NUM_CB];
+static unsigned int edits[AGT_NUM_CB];
+static int committed;
+
+static const char *stat_names[] = {
+    "validate-calls",
+    "validate-edits",
+    "apply-calls",
+    "apply-edits",
+    "commit-calls",
+    "commit-edits",
+    "rollback-calls",
+    "committed",
+    NULL
+};
+
+static boolean
+    is_rejected(const val_value_t *entry_val)
+{
+    val_value_t *action_val;
+
+    action_val = val_find_child(entry_val, "test-edit-cb-batch", "action");
+    return action_val != NULL &&
+        !xml_strcmp(VAL_ENUM_NAME(action_val), (const xmlChar *)"reject");
+}
+
+/* Registered callback functions: acl_batch_edit, get_stat */
+
+static status_t
+    acl_batch_edit(ses_cb_t *scb,
+                   rpc_msg_t *msg,
+                   agt_cbtyp_t cbtyp,
+                   dlq_hdr_t *editQ)
+{
+    agt_cb_edit_t *edit;
+
+    calls[cbtyp]++;
+    edits[cbtyp] = dlq_count(editQ);
+    printf("acl_batch_edit: %s %u edits\n",
+           agt_cbtype_name(cbtyp), edits[cbtyp]);
+
+    if (cbtyp != AGT_CB_COMMIT) {
+        return NO_ERR;
+    }
+
+    /* all or none of the edits are committed */
+    for (edit = (agt_cb_edit_t *)dlq_firstEntry(editQ);
+         edit != NULL;
+         edit = (agt_cb_edit_t *)dlq_nextEntry(edit)) {
+        if (edit->editop == OP_EDITOP_CREATE && is_rejected(edit->newval)) {
+            agt_record_error(scb, &msg->mhdr, NCX_LAYER_CONTENT,
+                             ERR_NCX_OPERATION_FAILED, NULL,
+                             NCX_NT_NONE, NULL, NCX_NT_VAL, edit->newval);
+            return ERR_NCX_OPERATION_FAILED;
+        }
+    }
+
+    for (edit = (agt_cb_edit_t *)dlq_firstEntry(editQ);
+         edit != NULL;
+         edit = (agt_cb_edit_t *)dlq_nextEntry(edit)) {
+        switch (edit->editop) {
+        case OP_EDITOP_CREATE:
+            committed++;
+            break;
+        case OP_EDITOP_DELETE:
+            committed--;
+            break;
+        default:
+            ;
+        }
+    }
+    return NO_ERR;
+}
+
+static status_t
+    get_stat(ses_cb_t *scb,
+             getcb_mode_t cbmode,
+             const val_value_t *vir_val,
+             val_value_t *dst_val)
+{
+    char buf[32];
+    unsigned int i;
+
+    for (i = 0; stat_names[i] != NULL; i++) {
+        if (!xml_strcmp(vir_val->name, (const xmlChar *)stat_names[i])) {
+            break;
+        }
+    }
+    assert(stat_names[i] != NULL);
+
+    switch (i) {
+    case 6:
+        snprintf(buf, sizeof(buf), "%u", calls[AGT_CB_ROLLBACK]);
+        break;
+    case 7:
+        snprintf(buf, sizeof(buf), "%d", committed);
+        break;
+    default:
+        /* validate, apply and commit calls/edits pairs */
+        snprintf(buf, sizeof(buf), "%u",
+                 (i % 2) ? edits[AGT_CB_VALIDATE + i / 2] :
+                 calls[AGT_CB_VALIDATE + i / 2]);
+    }
+    return val_set_simval_obj(dst_val, dst_val->obj, buf);
+}
+
+/* The 3 mandatory callback functions: y_test_edit_cb_batch_init, y_test_edit_cb_batch_init2, y_test_edit_cb_batch_cleanup */
+
+status_t
+    y_test_edit_cb_batch_init (
+        const xmlChar *modname,
+        const xmlChar *revision)
+{
+    agt_profile_t *agt_profile;
+    status_t res;
+
+    agt_profile = agt_get_profile();
+
+    res = ncxmod_load_module(
+        "test-edit-cb-batch",
+        NULL,
+        &agt_profile->agt_savedevQ,
+        &test_edit_cb_batch_mod);
+    if (res != NO_ERR) {
+        return res;
+    }
+
+    res = agt_cb_register_batch_callback(
+        "test-edit-cb-batch",
+        (const xmlChar *)"/acls/acl",
+        NULL /*"YYYY-MM-DD"*/,
+        acl_batch_edit);
+    return res;
+}
+
+status_t y_test_edit_cb_batch_init2(void)
+{
+    status_t res;
+    obj_template_t *stats_obj;
+    val_value_t *stats_val;
+    val_value_t *leaf_val;
+    unsigned int i;
+
+    stats_obj = ncx_find_object(test_edit_cb_batch_mod, "batch-stats");
+    assert(stats_obj != NULL);
+
+    res = agt_add_top_container(stats_obj, &stats_val);
+    assert(res == NO_ERR);
+
+    for (i = 0; stat_names[i] != NULL; i++) {
+        leaf_val = agt_make_virtual_leaf(stats_obj,
+                                         (const xmlChar *)stat_names[i],
+                                         get_stat,
+                                         &res);
+        assert(leaf_val != NULL);
+        val_add_child(leaf_val, stats_val);
+        val_set_virtual_cache_time(leaf_val->obj, 0);
+    }
+
+    return NO_ERR;
+}
+
+void y_test_edit_cb_batch_cleanup (void)
+{
+    agt_cb_unregister_batch_callback(
+        "test-edit-cb-batch",
+        (const xmlChar *)"/acls/acl",
+        acl_batch_edit);
+}
@@ -0,0 +1,187 @@
+#!/usr/bin/env python
+
+import time
+import random
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+INTERFACES_COUNT=100
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+def interface(name, description="", operation=""):
+	if operation != "":
+		operation = """ xmlns:nc="urn:ietf:params:xml:ns:netconf:base:1.0" nc:operation="%s\"""" % operation
+	return """
+        <interface%(operation)s>
+          <name>%(name)s</name>
+          <type
+            xmlns:ianaift="urn:ietf:params:xml:ns:yang:iana-if-type">ianaift:ethernetCsmacd</type>
+          <description>%(description)s</description>
+        </interface>
+""" % {'name':name, 'description':description, 'operation':operation}
+
+def edit_config(conn, interfaces, params_before="", operation=""):
+	if operation != "":
+		operation = """ xmlns:nc="urn:ietf:params:xml:ns:netconf:base:1.0" nc:operation="%s\"""" % operation
+	edit_config_rpc = """
+<edit-config>
+    <target>
+      <candidate/>
+    </target>
+%(params_before)s
+    <config>
+      <interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces"%(operation)s>
+%(interfaces)s
+      </interfaces>
+    </config>
+</edit-config>
+""" % {'interfaces':interfaces, 'params_before':params_before, 'operation':operation}
+	result = conn.rpc(edit_config_rpc)
+	print lxml.etree.tostring(result)
+	return result
+
+def get_interfaces(conn):
+	result = conn.rpc("""
+<get-config>
+  <source>
+    <candidate/>
+  </source>
+  <filter type="subtree">
+    <interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces"/>
+  </filter>
+</get-config>
+""")
+	interfaces = []
+	for interface in result.xpath('data/interfaces/interface'):
+		description = interface.xpath('description')
+		interfaces.append((interface.xpath('name')[0].text, description[0].text if len(description) else ""))
+	return interfaces
+
+def shuffled(names):
+	names = list(names)
+	random.shuffle(names)
+	return names
+
+def step_1(conn):
+	print("#1 - Create %(count)d interfaces in random order." % {'count':INTERFACES_COUNT})
+	names = ["eth%03d" % i for i in range(0, 2*INTERFACES_COUNT, 2)]
+	interfaces=""
+	for name in shuffled(names):
+		interfaces=interfaces+interface(name, "d")
+	result = edit_config(conn, interfaces)
+	assert(len(result.xpath('ok'))==1)
+	current = get_interfaces(conn)
+	assert(current==[(name, "d") for name in names])
+
+def step_2(conn):
+	print("#2 - Merge new and existing interfaces in random order.")
+	names = ["eth%03d" % i for i in range(INTERFACES_COUNT, 3*INTERFACES_COUNT)]
+	interfaces=""
+	for name in shuffled(names):
+		interfaces=interfaces+interface(name, "m")
+	result = edit_config(conn, interfaces)
+	assert(len(result.xpath('ok'))==1)
+	current = get_interfaces(conn)
+	expected = [("eth%03d" % i, "d") for i in range(0, INTERFACES_COUNT, 2)] + [(name, "m") for name in names]
+	assert(current==expected)
+
+def step_3(conn):
+	print("#3 - Failed create rolls back the merged interfaces.")
+	before = get_interfaces(conn)
+	interfaces=""
+	for name in shuffled(["eth%03d" % i for i in range(3*INTERFACES_COUNT, 4*INTERFACES_COUNT)]):
+		interfaces=interfaces+interface(name, "x")
+	interfaces=interfaces+interface("eth000", "x", "create")
+	result = edit_config(conn, interfaces, params_before="<error-option>rollback-on-error</error-option>")
+	assert(len(result.xpath('rpc-error'))==1)
+	assert(get_interfaces(conn)==before)
+
+def step_4(conn):
+	print("#4 - Replace the interfaces with a subset in random order.")
+	names = ["eth%03d" % i for i in range(0, 3*INTERFACES_COUNT, 3)]
+	interfaces=""
+	for name in shuffled(names):
+		interfaces=interfaces+interface(name, "r")
+	result = edit_config(conn, interfaces, operation="replace")
+	assert(len(result.xpath('ok'))==1)
+	current = get_interfaces(conn)
+	assert(current==[(name, "r") for name in names])
+
+def main():
+	print("""
+#Description: Test edit-config merge and replace of many list entries
+#Procedure:
+#1 - Create %(count)d interfaces in random order.
+#2 - Merge new and existing interfaces in random order.
+#3 - Failed create rolls back the merged interfaces.
+#4 - Replace the interfaces with a subset in random order.
+""" % {'count':INTERFACES_COUNT})
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	random.seed(1)
+
+	step_1(conn)
+	step_2(conn)
+	step_3(conn)
+	step_4(conn)
+	return 0
+
+sys.exit(main())
@@ -0,0 +1,134 @@
+#!/usr/bin/env python
+
+import time
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+def get(conn, filter):
+	get_rpc = """
+<get>
+  <filter type="subtree">
+    <stats xmlns="http://yuma123.org/ns/test/netconfd/getcb-bulk/test-getcb-bulk">
+%(filter)s
+    </stats>
+  </filter>
+</get>
+""" % {'filter':filter}
+	result = conn.rpc(get_rpc)
+	return result
+
+def get_emitted(conn):
+	result = get(conn, "<emitted/>")
+	emitted = result.xpath('data/stats/emitted')
+	assert(len(emitted)==1)
+	return int(emitted[0].text)
+
+def step_1(conn):
+	print("#1 - Get all 10000 entries of the virtual list.")
+	result = conn.rpc("<get/>")
+	counters = result.xpath('data/stats/counter')
+	assert(len(counters)==10000)
+	assert(get_emitted(conn)==10000)
+
+def step_2(conn):
+	print("#2 - Get one entry by key; only that entry is emitted.")
+	result = get(conn, "<counter><name>c42</name></counter>")
+	values = result.xpath('data/stats/counter/value')
+	assert(len(values)==1 and values[0].text=="42")
+	assert(get_emitted(conn)==1)
+
+def step_3(conn):
+	print("#3 - Get one entry by non-key content match node.")
+	result = get(conn, "<counter><value>7</value></counter>")
+	names = result.xpath('data/stats/counter/name')
+	assert(len(names)==1 and names[0].text=="c7")
+	assert(get_emitted(conn)==10000)
+
+def step_4(conn):
+	print("#4 - Get one entry with an XPath filter.")
+	get_rpc = """
+<get>
+  <filter type="xpath" xmlns:b="http://yuma123.org/ns/test/netconfd/getcb-bulk/test-getcb-bulk" select="/b:stats/b:counter[b:name='c9']"/>
+</get>
+"""
+	result = conn.rpc(get_rpc)
+	values = result.xpath('data/stats/counter/value')
+	assert(len(values)==1 and values[0].text=="9")
+
+def main():
+	print("""
+#Description: Test virtual lists with a bulk get callback
+#Procedure:
+#1 - Get all 10000 entries of the virtual list.
+#2 - Get one entry by key; only that entry is emitted.
+#3 - Get one entry by non-key content match node.
+#4 - Get one entry with an XPath filter.
+""")
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	step_1(conn)
+	step_2(conn)
+	step_3(conn)
+	step_4(conn)
+	return 0
+
+sys.exit(main())
@@ -0,0 +1,149 @@
+/*
+    module test-getcb-bulk
+    The /stats/counter list is a virtual list with COUNTER_MAX
+    entries. All of them are emitted from one bulk get callback
+    and each entry is freed right after it is emitted.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "procdefs.h"
+#include "agt.h"
+#include "agt_util.h"
+#include "cfg.h"
+#include "getcb.h"
+#include "ncxmod.h"
+#include "ncxtypes.h"
+#include "ses.h"
+#include "status.h"
+#include "val.h"
+#include "val_util.h"
+#include "xml_util.h"
+
+#define COUNTER_MAX 10000
+
+/* module static variables */
+static ncx_module_t *test_getcb_bulk_mod;
+static obj_template_t *counter_obj;
+static unsigned int emitted;
+
+/* Registered callback functions: get_counters, get_emitted */
+
+static status_t
+    get_counters(ses_cb_t *scb,
+                 const val_value_t *vir_val,
+                 const val_value_t *key_val,
+                 getcb_emit_fn_t emitfn,
+                 void *cookie)
+{
+    val_value_t *entry_val;
+    val_value_t *name_val;
+    val_value_t *value_val;
+    val_value_t *key_name_val = NULL;
+    char buf[32];
+    unsigned int i;
+    status_t res = NO_ERR;
+
+    if (key_val != NULL) {
+        key_name_val = val_find_child(key_val, NULL, "name");
+        assert(key_name_val != NULL);
+    }
+
+    emitted = 0;
+    for (i = 0; i < COUNTER_MAX && res == NO_ERR; i++) {
+        snprintf(buf, sizeof(buf), "c%u", i);
+        if (key_name_val != NULL &&
+            strcmp(buf, (const char *)VAL_STR(key_name_val))) {
+            continue;
+        }
+
+        entry_val = val_new_value();
+        assert(entry_val);
+        val_init_from_template(entry_val, counter_obj);
+
+        name_val = agt_make_leaf(counter_obj, "name", buf, &res);
+        assert(name_val != NULL);
+        val_add_child(name_val, entry_val);
+        snprintf(buf, sizeof(buf), "%u", i);
+        value_val = agt_make_leaf(counter_obj, "value", buf, &res);
+        assert(value_val != NULL);
+        val_add_child(value_val, entry_val);
+        res = val_gen_index_chain(counter_obj, entry_val);
+        assert(res == NO_ERR);
+
+        res = (*emitfn)(cookie, entry_val);
+        val_free_value(entry_val);
+        emitted++;
+    }
+
+    return res;
+}
+
+static status_t
+    get_emitted(ses_cb_t *scb,
+                getcb_mode_t cbmode,
+                const val_value_t *vir_val,
+                val_value_t *dst_val)
+{
+    char buf[32];
+
+    snprintf(buf, sizeof(buf), "%u", emitted);
+    return val_set_simval_obj(dst_val, dst_val->obj, buf);
+}
+
+/* The 3 mandatory callback functions: y_test_getcb_bulk_init, y_test_getcb_bulk_init2, y_test_getcb_bulk_cleanup */
+
+status_t
+    y_test_getcb_bulk_init (
+        const xmlChar *modname,
+        const xmlChar *revision)
+{
+    agt_profile_t *agt_profile;
+    status_t res;
+
+    agt_profile = agt_get_profile();
+
+    res = ncxmod_load_module(
+        "test-getcb-bulk",
+        NULL,
+        &agt_profile->agt_savedevQ,
+        &test_getcb_bulk_mod);
+    return res;
+}
+
+status_t y_test_getcb_bulk_init2(void)
+{
+    status_t res;
+    obj_template_t *stats_obj;
+    val_value_t *stats_val;
+    val_value_t *emitted_val;
+    val_value_t *counter_val;
+
+    stats_obj = ncx_find_object(test_getcb_bulk_mod, "stats");
+    assert(stats_obj != NULL);
+    counter_obj = obj_find_child(stats_obj, "test-getcb-bulk", "counter");
+    assert(counter_obj != NULL);
+
+    res = agt_add_top_container(stats_obj, &stats_val);
+    assert(res == NO_ERR);
+
+    emitted_val = agt_make_virtual_leaf(stats_obj, "emitted",
+                                        get_emitted, &res);
+    assert(emitted_val != NULL);
+    val_add_child(emitted_val, stats_val);
+    val_set_virtual_cache_time(emitted_val->obj, 0);
+
+    counter_val = agt_make_virtual_list(stats_obj, "counter",
+                                        get_counters, &res);
+    assert(counter_val != NULL);
+    val_add_child(counter_val, stats_val);
+
+    return NO_ERR;
+}
+
+void y_test_getcb_bulk_cleanup (void)
+{
+}
@@ -0,0 +1,109 @@
+#!/usr/bin/env python
+
+import time
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+def get(conn):
+	get_rpc = """
+<get>
+  <filter type="subtree">
+    <backends xmlns="http://yuma123.org/ns/test/netconfd/getcb-start/test-getcb-start"/>
+  </filter>
+</get>
+"""
+	start = time.time()
+	result = conn.rpc(get_rpc)
+	elapsed = time.time() - start
+	print lxml.etree.tostring(result)
+	print("elapsed: %(elapsed)f" % {'elapsed':elapsed})
+	return (result, elapsed)
+
+def step_1(conn):
+	print("#1 - Get 3 leaves with 1 second backends in parallel.")
+	(result, elapsed) = get(conn)
+	for name in ["a", "b", "c"]:
+		leaf = result.xpath('data/backends/%(name)s' % {'name':name})
+		assert(len(leaf)==1 and leaf[0].text==("value-%(name)s" % {'name':name}))
+	assert(elapsed < 2.5)
+
+def step_2(conn):
+	print("#2 - The leaf with the stuck backend is left out after the deadline.")
+	(result, elapsed) = get(conn)
+	stuck = result.xpath('data/backends/stuck')
+	assert(len(stuck)==0)
+	assert(elapsed >= 1.5 and elapsed < 2.5)
+
+def main():
+	print("""
+#Description: Test parallel state data get callbacks with a deadline
+#Procedure:
+#1 - Get 3 leaves with 1 second backends in parallel.
+#2 - The leaf with the stuck backend is left out after the deadline.
+""")
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	step_1(conn)
+	step_2(conn)
+	return 0
+
+sys.exit(main())
@@ -0,0 +1,195 @@
+/*
+    module test-getcb-start
+    Each leaf in /backends is read from a backend process
+    that answers after a delay. The gets are started with
+    agt_set_virtual_start_cb so all backends work in parallel.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <assert.h>
+
+#include "procdefs.h"
+#include "agt.h"
+#include "agt_util.h"
+#include "cfg.h"
+#include "getcb.h"
+#include "ncxmod.h"
+#include "ncxtypes.h"
+#include "ses.h"
+#include "status.h"
+#include "val.h"
+#include "xml_util.h"
+
+#define BACKEND_MAX 4
+
+typedef struct backend_t_ {
+    const char *name;
+    unsigned int delay;   /* seconds */
+    pid_t pid;
+    int fd;
+} backend_t;
+
+/* module static variables */
+static ncx_module_t *test_getcb_start_mod;
+static backend_t backends[BACKEND_MAX] = {
+    { "a", 1, -1, -1 },
+    { "b", 1, -1, -1 },
+    { "c", 1, -1, -1 },
+    { "stuck", 30, -1, -1 }
+};
+
+static backend_t *
+    find_backend(const val_value_t *vir_val)
+{
+    unsigned int i;
+
+    for (i = 0; i < BACKEND_MAX; i++) {
+        if (!xml_strcmp(vir_val->name, (const xmlChar *)backends[i].name)) {
+            return &backends[i];
+        }
+    }
+    assert(0);
+    return NULL;
+}
+
+static void
+    stop_backend(backend_t *backend)
+{
+    close(backend->fd);
+    backend->fd = -1;
+    kill(backend->pid, SIGKILL);
+    waitpid(backend->pid, NULL, 0);
+    backend->pid = -1;
+}
+
+/* Registered callback functions: start_backend, get_backend */
+
+static status_t
+    start_backend(ses_cb_t *scb,
+                  const val_value_t *vir_val,
+                  int *fd)
+{
+    backend_t *backend;
+    int fds[2];
+    char buf[64];
+
+    backend = find_backend(vir_val);
+    assert(backend->pid == -1);
+
+    if (pipe(fds) != 0) {
+        return ERR_NCX_OPERATION_FAILED;
+    }
+    backend->pid = fork();
+    if (backend->pid == 0) {
+        close(fds[0]);
+        sleep(backend->delay);
+        snprintf(buf, sizeof(buf), "value-%s", backend->name);
+        if (write(fds[1], buf, strlen(buf)) < 0) {
+            _exit(1);
+        }
+        _exit(0);
+    }
+    close(fds[1]);
+    backend->fd = fds[0];
+    *fd = backend->fd;
+    printf("start_backend: %s\n", backend->name);
+    return NO_ERR;
+}
+
+static status_t
+    get_backend(ses_cb_t *scb,
+                getcb_mode_t cbmode,
+                const val_value_t *vir_val,
+                val_value_t *dst_val)
+{
+    backend_t *backend;
+    char buf[64];
+    ssize_t len;
+    int fd;
+    status_t res;
+
+    backend = find_backend(vir_val);
+
+    if (cbmode == GETCB_CANCEL_VALUE) {
+        printf("get_backend: cancel %s\n", backend->name);
+        stop_backend(backend);
+        return NO_ERR;
+    }
+
+    /* not started in parallel; get the value now */
+    if (backend->pid == -1) {
+        res = start_backend(scb, vir_val, &fd);
+        if (res != NO_ERR) {
+            return res;
+        }
+    }
+
+    len = read(backend->fd, buf, sizeof(buf) - 1);
+    stop_backend(backend);
+    if (len <= 0) {
+        return ERR_NCX_OPERATION_FAILED;
+    }
+    buf[len] = 0;
+    printf("get_backend: %s=%s\n", backend->name, buf);
+    return val_set_simval_obj(dst_val, dst_val->obj, buf);
+}
+
+/* The 3 mandatory callback functions: y_test_getcb_start_init, y_test_getcb_start_init2, y_test_getcb_start_cleanup */
+
+status_t
+    y_test_getcb_start_init (
+        const xmlChar *modname,
+        const xmlChar *revision)
+{
+    agt_profile_t *agt_profile;
+    status_t res;
+
+    agt_profile = agt_get_profile();
+
+    res = ncxmod_load_module(
+        "test-getcb-start",
+        NULL,
+        &agt_profile->agt_savedevQ,
+        &test_getcb_start_mod);
+    return res;
+}
+
+status_t y_test_getcb_start_init2(void)
+{
+    status_t res;
+    obj_template_t *backends_obj;
+    val_value_t *backends_val;
+    val_value_t *leaf_val;
+    unsigned int i;
+
+    backends_obj = ncx_find_object(test_getcb_start_mod, "backends");
+    assert(backends_obj != NULL);
+
+    res = agt_add_top_container(backends_obj, &backends_val);
+    assert(res == NO_ERR);
+
+    for (i = 0; i < BACKEND_MAX; i++) {
+        leaf_val = agt_make_virtual_leaf(backends_obj,
+                                         (const xmlChar *)backends[i].name,
+                                         get_backend,
+                                         &res);
+        assert(leaf_val != NULL);
+        val_add_child(leaf_val, backends_val);
+
+        res = agt_set_virtual_start_cb(leaf_val->obj, start_backend);
+        assert(res == NO_ERR);
+    }
+
+    return NO_ERR;
+}
+
+void y_test_getcb_start_cleanup (void)
+{
+}
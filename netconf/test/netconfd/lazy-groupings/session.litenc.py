@@ -0,0 +1,130 @@
+#!/usr/bin/env python
+
+import time
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+NS="http://yuma123.org/ns/test/netconfd/lazy-groupings/test-lazy-groupings"
+
+def edit_config(conn, config):
+	rpc = """
+<edit-config>
+  <target>
+    <running/>
+  </target>
+  <config>
+%(config)s
+  </config>
+</edit-config>
+""" % {'config':config}
+	return conn.rpc(rpc)
+
+def step_1(conn):
+	print("#1 - Create nodes expanded from nested, augmented and keyed groupings.")
+	result = edit_config(conn, """
+    <top xmlns="%(ns)s"><b><b1>v</b1></b></top>
+    <keyed xmlns="%(ns)s"><kl><k>one</k><a1>z</a1></kl></keyed>
+    <augmented xmlns="%(ns)s"><b><extra>e</extra></b></augmented>
+""" % {'ns':NS})
+	ok = result.xpath('ok')
+	assert(len(ok)==1)
+
+def step_2(conn):
+	print("#2 - Check the refined and inherited defaults.")
+	result = conn.rpc("""
+<get-config>
+  <source>
+    <running/>
+  </source>
+  <with-defaults xmlns="urn:ietf:params:xml:ns:yang:ietf-netconf-with-defaults">report-all</with-defaults>
+</get-config>
+""")
+	print lxml.etree.tostring(result)
+	assert(result.xpath('data/top/b/a1')[0].text=="refined")
+	assert(result.xpath('data/top/b/a2')[0].text=="5")
+	assert(result.xpath('data/keyed/kl/a2')[0].text=="5")
+	assert(result.xpath('data/augmented/b/extra')[0].text=="e")
+
+def step_3(conn):
+	print("#3 - Nodes of the unused grouping are not part of the schema.")
+	result = edit_config(conn, """
+    <top xmlns="%(ns)s"><u><b><b1>v</b1></b></u></top>
+""" % {'ns':NS})
+	errors = result.xpath('rpc-error')
+	assert(len(errors)==1)
+
+def main():
+	print("""
+#Description: Test the netconfd --lazy-groupings parameter
+#Procedure:
+#1 - Create nodes expanded from nested, augmented and keyed groupings.
+#2 - Check the refined and inherited defaults.
+#3 - Nodes of the unused grouping are not part of the schema.
+""")
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	step_1(conn)
+	step_2(conn)
+	step_3(conn)
+	return 0
+
+sys.exit(main())
@@ -0,0 +1,11 @@
+#!/bin/bash -e
+rm -rf tmp || true
+mkdir tmp
+killall -KILL netconfd || true
+rm /tmp/ncxserver.sock || true
+/usr/sbin/netconfd --module=../../../modules/ietf/iana-if-type@2014-05-08.yang --module=../../../modules/ietf/ietf-interfaces@2014-05-08.yang --module=../../../modules/ietf/ietf-ip@2014-06-16.yang --no-startup --superuser=$USER 2>&1 1>tmp/server.log &
+SERVER_PID=$!
+sleep 4
+python session.litenc.py --server=$NCSERVER --port=$NCPORT --user=$NCUSER --password=$NCPASSWORD
+kill -KILL $SERVER_PID
+sleep 1
@@ -0,0 +1,214 @@
+#!/usr/bin/env python
+
+import time
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+INTERFACES_COUNT=100
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+def get_page(conn, params):
+	rpc = """
+<get-config>
+  <source>
+    <candidate/>
+  </source>
+  <list-pagination xmlns="http://yuma123.org/ns/yuma123-list-pagination">
+%(params)s
+  </list-pagination>
+</get-config>
+""" % {'params':params}
+	result = conn.rpc(rpc)
+	print lxml.etree.tostring(result)
+	return result
+
+INTERFACE_TARGET="""<list-target xmlns:if="urn:ietf:params:xml:ns:yang:ietf-interfaces">/if:interfaces/if:interface</list-target>"""
+
+def step_1(conn):
+	print("#1 - Create %(count)d interfaces in reverse key order." % {'count':INTERFACES_COUNT})
+	interfaces=""
+	for i in reversed(range(INTERFACES_COUNT)):
+		interfaces=interfaces+"""
+        <interface>
+          <name>eth%(i)03d</name>
+          <type
+            xmlns:ianaift="urn:ietf:params:xml:ns:yang:iana-if-type">ianaift:ethernetCsmacd</type>
+        </interface>
+""" % {'i':i}
+	edit_config_rpc = """
+<edit-config>
+    <target>
+      <candidate/>
+    </target>
+    <config>
+      <interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">
+%(interfaces)s
+        <interface>
+          <name>lo</name>
+          <type
+            xmlns:ianaift="urn:ietf:params:xml:ns:yang:iana-if-type">ianaift:softwareLoopback</type>
+          <ipv4 xmlns="urn:ietf:params:xml:ns:yang:ietf-ip">
+            <address><ip>127.0.0.3</ip><prefix-length>8</prefix-length></address>
+            <address><ip>127.0.0.1</ip><prefix-length>8</prefix-length></address>
+            <address><ip>127.0.0.2</ip><prefix-length>8</prefix-length></address>
+          </ipv4>
+        </interface>
+      </interfaces>
+    </config>
+  </edit-config>
+""" % {'interfaces':interfaces}
+	result = conn.rpc(edit_config_rpc)
+	ok = result.xpath('ok')
+	assert(len(ok)==1)
+
+def step_2(conn):
+	print("#2 - Get the first page of 10 interfaces sorted by key.")
+	result = get_page(conn, INTERFACE_TARGET + "<limit>10</limit>")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==10)
+	for i in range(10):
+		assert(names[i].text=="eth%03d" % i)
+	assert(result.get('remaining')==str(INTERFACES_COUNT+1-10))
+	assert(result.get('next-cursor')!=None)
+
+def step_3(conn):
+	print("#3 - Walk all pages with the next-cursor of each reply.")
+	names=[]
+	cursor=None
+	while True:
+		params = INTERFACE_TARGET + "<limit>30</limit>"
+		if cursor != None:
+			params = params + "<start-after>%s</start-after>" % cursor
+		result = get_page(conn, params)
+		for name in result.xpath('data/interfaces/interface/name'):
+			names.append(name.text)
+		cursor = result.get('next-cursor')
+		if cursor == None:
+			assert(result.get('remaining')=="0")
+			break
+	assert(len(names)==INTERFACES_COUNT+1)
+	assert(names==sorted(names))
+
+def step_4(conn):
+	print("#4 - Skip entries with offset.")
+	result = get_page(conn, INTERFACE_TARGET + "<offset>95</offset><limit>3</limit>")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==3)
+	assert(names[0].text=="eth095" and names[2].text=="eth097")
+	assert(result.get('remaining')=="3")
+
+def step_5(conn):
+	print("#5 - Page a nested list; the ancestor list keys are returned.")
+	result = get_page(conn, """<list-target xmlns:if="urn:ietf:params:xml:ns:yang:ietf-interfaces" xmlns:ip="urn:ietf:params:xml:ns:yang:ietf-ip">/if:interfaces/if:interface[if:name='lo']/ip:ipv4/ip:address</list-target><limit>2</limit>""")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==1 and names[0].text=="lo")
+	types = result.xpath('data/interfaces/interface/type')
+	assert(len(types)==0)
+	ips = result.xpath('data/interfaces/interface/ipv4/address/ip')
+	assert(len(ips)==2 and ips[0].text=="127.0.0.1" and ips[1].text=="127.0.0.2")
+	assert(result.get('remaining')=="1")
+
+def step_6(conn):
+	print("#6 - Invalid list-target, start-after and filter parameters are rejected.")
+	result = get_page(conn, """<list-target xmlns:if="urn:ietf:params:xml:ns:yang:ietf-interfaces">/if:interfaces</list-target>""")
+	errors = result.xpath('rpc-error')
+	assert(len(errors)==1)
+	result = get_page(conn, INTERFACE_TARGET + "<start-after>!</start-after>")
+	errors = result.xpath('rpc-error')
+	assert(len(errors)==1)
+	result = conn.rpc("""
+<get-config>
+  <source>
+    <candidate/>
+  </source>
+  <filter type="subtree">
+    <interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces"/>
+  </filter>
+  <list-pagination xmlns="http://yuma123.org/ns/yuma123-list-pagination">
+%(target)s
+  </list-pagination>
+</get-config>
+""" % {'target':INTERFACE_TARGET})
+	errors = result.xpath('rpc-error')
+	assert(len(errors)==1)
+
+def main():
+	print("""
+#Description: Test the yuma123-list-pagination get-config parameters
+#Procedure:
+#1 - Create %(count)d interfaces in reverse key order.
+#2 - Get the first page of 10 interfaces sorted by key.
+#3 - Walk all pages with the next-cursor of each reply.
+#4 - Skip entries with offset.
+#5 - Page a nested list; the ancestor list keys are returned.
+#6 - Invalid list-target, start-after and filter parameters are rejected.
+""" % {'count':INTERFACES_COUNT})
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	step_1(conn)
+	step_2(conn)
+	step_3(conn)
+	step_4(conn)
+	step_5(conn)
+	step_6(conn)
+	return 0
+
+sys.exit(main())
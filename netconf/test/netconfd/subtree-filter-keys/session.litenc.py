@@ -0,0 +1,188 @@
+#!/usr/bin/env python
+
+import time
+import sys, os
+sys.path.append("../../litenc")
+import litenc
+import litenc_lxml
+import lxml
+import argparse
+
+INTERFACES_COUNT=100
+
+def connect(server, port, user, password):
+	conn_raw = litenc.litenc()
+	ret = conn_raw.connect(server=server, port=port, user=user, password=password)
+	if ret != 0:
+		print "[FAILED] Connecting to server=%(server)s:" % {'server':server}
+		return(-1)
+	print "[OK] Connecting to server=%(server)s:" % {'server':server}
+	ret = conn_raw.send("""
+<hello xmlns="urn:ietf:params:xml:ns:netconf:base:1.0">
+ <capabilities>
+  <capability>urn:ietf:params:netconf:base:1.0</capability>
+ </capabilities>
+</hello>
+""")
+	if ret != 0:
+		print("[FAILED] Sending <hello>")
+		return(-1)
+	(ret, reply_xml)=conn_raw.receive()
+	if ret != 0:
+		print("[FAILED] Receiving <hello>")
+		return(-1)
+
+	print "[OK] Receiving <hello> =%(reply_xml)s:" % {'reply_xml':reply_xml}
+	return conn_raw
+
+def get_config(conn, filter):
+	get_config_rpc = """
+<get-config>
+  <source>
+    <candidate/>
+  </source>
+  <filter type="subtree">
+    <interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">
+%(filter)s
+    </interfaces>
+  </filter>
+</get-config>
+""" % {'filter':filter}
+	result = conn.rpc(get_config_rpc)
+	print lxml.etree.tostring(result)
+	return result
+
+def step_1(conn):
+	print("#1 - Create %(count)d interfaces." % {'count':INTERFACES_COUNT})
+	interfaces=""
+	for i in range(INTERFACES_COUNT):
+		interfaces=interfaces+"""
+        <interface>
+          <name>eth%(i)d</name>
+          <description>d%(i)d</description>
+          <type
+            xmlns:ianaift="urn:ietf:params:xml:ns:yang:iana-if-type">ianaift:ethernetCsmacd</type>
+        </interface>
+""" % {'i':i}
+	edit_config_rpc = """
+<edit-config>
+    <target>
+      <candidate/>
+    </target>
+    <config>
+      <interfaces xmlns="urn:ietf:params:xml:ns:yang:ietf-interfaces">
+%(interfaces)s
+      </interfaces>
+    </config>
+  </edit-config>
+""" % {'interfaces':interfaces}
+	result = conn.rpc(edit_config_rpc)
+	ok = result.xpath('ok')
+	assert(len(ok)==1)
+
+def step_2(conn):
+	print("#2 - Select one interface by key.")
+	result = get_config(conn, "<interface><name>eth50</name></interface>")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==1 and names[0].text=="eth50")
+	descr = result.xpath('data/interfaces/interface/description')
+	assert(len(descr)==1 and descr[0].text=="d50")
+
+def step_3(conn):
+	print("#3 - Select 2 existing and 1 missing interface by key with a select node.")
+	result = get_config(conn, """
+<interface><name>eth1</name><description/></interface>
+<interface><name>eth99</name><description/></interface>
+<interface><name>missing</name><description/></interface>
+""")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==2)
+	assert(names[0].text=="eth1" and names[1].text=="eth99")
+	types = result.xpath('data/interfaces/interface/type')
+	assert(len(types)==0)
+
+def step_4(conn):
+	print("#4 - Key and non-key content match nodes must both match.")
+	result = get_config(conn, "<interface><name>eth3</name><description>d4</description></interface>")
+	names = result.xpath('data/interfaces/interface')
+	assert(len(names)==0)
+	result = get_config(conn, "<interface><name>eth4</name><description>d4</description></interface>")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==1 and names[0].text=="eth4")
+
+def step_5(conn):
+	print("#5 - Select by non-key content match node.")
+	result = get_config(conn, "<interface><description>d7</description><name/></interface>")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==1 and names[0].text=="eth7")
+
+def step_6(conn):
+	print("#6 - Select many interfaces by key mixed with a non-key content match node.")
+	result = get_config(conn, """
+<interface><name>eth90</name></interface>
+<interface><description>d20</description></interface>
+<interface><name>eth10</name><type/></interface>
+<interface><name>missing</name></interface>
+<interface><name>eth55</name><description/></interface>
+<interface><name>eth0</name></interface>
+""")
+	names = result.xpath('data/interfaces/interface/name')
+	assert(len(names)==5)
+	assert([name.text for name in names]==["eth90","eth20","eth10","eth55","eth0"])
+	descr = result.xpath('data/interfaces/interface/description')
+	assert(len(descr)==4)
+	types = result.xpath('data/interfaces/interface/type')
+	assert(len(types)==4)
+
+def main():
+	print("""
+#Description: Test subtree filters with list key content match nodes rfc6241#section-6
+#Procedure:
+#1 - Create 100 interfaces.
+#2 - Select one interface by key.
+#3 - Select 2 existing and 1 missing interface by key with a select node.
+#4 - Key and non-key content match nodes must both match.
+#5 - Select by non-key content match node.
+#6 - Select many interfaces by key mixed with a non-key content match node.
+""")
+
+	parser = argparse.ArgumentParser()
+	parser.add_argument("--server", help="server name e.g. 127.0.0.1 or server.com (127.0.0.1 if not specified)")
+	parser.add_argument("--user", help="username e.g. admin ($USER if not specified)")
+	parser.add_argument("--port", help="port e.g. 830 (830 if not specified)")
+	parser.add_argument("--password", help="password e.g. mypass123 (passwordless if not specified)")
+
+	args = parser.parse_args()
+
+	if(args.server==None or args.server==""):
+		server="127.0.0.1"
+	else:
+		server=args.server
+
+	if(args.port==None or args.port==""):
+		port=830
+	else:
+		port=int(args.port)
+
+	if(args.user==None or args.user==""):
+		user=os.getenv('USER')
+	else:
+		user=args.user
+
+	if(args.password==None or args.password==""):
+		password=None
+	else:
+		password=args.password
+
+	conn_raw = connect(server=server, port=port, user=user, password=password)
+	conn=litenc_lxml.litenc_lxml(conn_raw, strip_namespaces=True)
+
+	step_1(conn)
+	step_2(conn)
+	step_3(conn)
+	step_4(conn)
+	step_5(conn)
+	step_6(conn)
+	return 0
+
+sys.exit(main())